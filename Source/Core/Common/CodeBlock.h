@@ -77,6 +77,9 @@ public:
   }
 
   bool IsInSpace(const u8* ptr) const { return ptr >= region && ptr < (region + region_size); }
+  // The part of the region that isn't used by children.
+  u8* GetRegion() const { return region; }
+  size_t GetRegionSize() const { return region_size; }
   // Cannot currently be undone. Will write protect the entire code region.
   // Start over if you need to change the code (call FreeCodeSpace(), AllocCodeSpace()).
   void WriteProtect() { Common::WriteProtectMemory(region, region_size, true); }
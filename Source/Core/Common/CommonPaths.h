@@ -109,6 +109,8 @@
 // Files in the directory returned by GetUserPath(D_MEMORYWATCHER_IDX)
 #define MEMORYWATCHER_LOCATIONS "Locations.txt"
 #define MEMORYWATCHER_SOCKET "MemoryWatcher"
+#define MEMORYWATCHER_REGIONS "Regions.txt"
+#define MEMORYWATCHER_SNAPSHOTS "Snapshots"
 
 // Sys files
 #define TOTALDB "totaldb.dsy"
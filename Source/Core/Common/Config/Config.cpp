@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <atomic>
 #include <list>
 #include <map>
 #include <tuple>
@@ -14,6 +15,7 @@ namespace Config
 {
 static Layers s_layers;
 static std::list<ConfigChangedCallback> s_callbacks;
+static std::atomic<u32> s_config_version{1};
 
 void InvokeConfigChangedCallbacks();
 
@@ -22,6 +24,18 @@ Section* GetOrCreateSection(System system, const std::string& section_name)
   return s_layers[LayerType::Meta]->GetOrCreateSection(system, section_name);
 }
 
+u32 GetConfigVersion()
+{
+  return s_config_version.load(std::memory_order_acquire);
+}
+
+void IncrementConfigVersion()
+{
+  // Skip zero when wrapping around, as that marks empty caches.
+  if (s_config_version.fetch_add(1, std::memory_order_acq_rel) + 1 == 0)
+    s_config_version.fetch_add(1, std::memory_order_acq_rel);
+}
+
 Layers* GetLayers()
 {
   return &s_layers;
@@ -30,6 +44,7 @@ Layers* GetLayers()
 void AddLayer(std::unique_ptr<Layer> layer)
 {
   s_layers[layer->GetLayer()] = std::move(layer);
+  IncrementConfigVersion();
   InvokeConfigChangedCallbacks();
 }
 
@@ -59,6 +74,7 @@ Layer* GetLayer(LayerType layer)
 void RemoveLayer(LayerType layer)
 {
   s_layers.erase(layer);
+  IncrementConfigVersion();
   InvokeConfigChangedCallbacks();
 }
 bool LayerExists(LayerType layer)
@@ -96,17 +112,20 @@ void Init()
   ClearCurrentRunLayer();
   // This layer always has to exist
   s_layers[LayerType::Meta] = std::make_unique<RecursiveLayer>();
+  IncrementConfigVersion();
 }
 
 void Shutdown()
 {
   s_layers.clear();
   s_callbacks.clear();
+  IncrementConfigVersion();
 }
 
 void ClearCurrentRunLayer()
 {
   s_layers[LayerType::CurrentRun] = std::make_unique<Layer>(LayerType::CurrentRun);
+  IncrementConfigVersion();
 }
 
 static const std::map<System, std::string> system_to_name = {
@@ -4,11 +4,16 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstring>
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <type_traits>
 
+#include "Common/CommonTypes.h"
 #include "Common/Config/Enums.h"
 #include "Common/Config/Layer.h"
 #include "Common/Config/Section.h"
@@ -26,11 +31,97 @@ struct ConfigLocation
   bool operator<(const ConfigLocation& other) const;
 };
 
+// Bumped every time a value changes in any layer or a layer is added or removed, which
+// invalidates every cached value. Zero is never used, so it can mark empty caches.
+u32 GetConfigVersion();
+void IncrementConfigVersion();
+
+// Caches the value last read for a ConfigInfo along with the config version it was read at.
+// Values that fit in 32 bits are packed together with the version, so that a cache hit takes no
+// lock, only an acquire load of the config version and one of the cache. Larger values (strings,
+// doubles) are guarded by a mutex instead.
+template <typename T, bool = std::is_trivially_copyable<T>::value && sizeof(T) <= sizeof(u32)>
+class ConfigCache
+{
+public:
+  bool Get(u32 version, T* value) const
+  {
+    const u64 packed = m_packed.load(std::memory_order_acquire);
+    if (static_cast<u32>(packed >> 32) != version)
+      return false;
+
+    const u32 bits = static_cast<u32>(packed);
+    std::memcpy(value, &bits, sizeof(T));
+    return true;
+  }
+
+  void Set(u32 version, const T& value) const
+  {
+    u32 bits = 0;
+    std::memcpy(&bits, &value, sizeof(T));
+    m_packed.store((static_cast<u64>(version) << 32) | bits, std::memory_order_release);
+  }
+
+  void Clear() { m_packed.store(0, std::memory_order_release); }
+
+private:
+  mutable std::atomic<u64> m_packed{0};
+};
+
+template <typename T>
+class ConfigCache<T, false>
+{
+public:
+  bool Get(u32 version, T* value) const
+  {
+    std::lock_guard<std::mutex> lk(m_lock);
+    if (m_version != version)
+      return false;
+
+    *value = m_value;
+    return true;
+  }
+
+  void Set(u32 version, const T& value) const
+  {
+    std::lock_guard<std::mutex> lk(m_lock);
+    m_version = version;
+    m_value = value;
+  }
+
+  void Clear()
+  {
+    std::lock_guard<std::mutex> lk(m_lock);
+    m_version = 0;
+  }
+
+private:
+  mutable std::mutex m_lock;
+  mutable u32 m_version = 0;
+  mutable T m_value{};
+};
+
 template <typename T>
 struct ConfigInfo
 {
+  ConfigInfo(const ConfigLocation& location_, const T& default_value_)
+      : location(location_), default_value(default_value_)
+  {
+  }
+
+  // Copies start out with an empty cache.
+  ConfigInfo(const ConfigInfo& other) : ConfigInfo(other.location, other.default_value) {}
+  ConfigInfo& operator=(const ConfigInfo& other)
+  {
+    location = other.location;
+    default_value = other.default_value;
+    cache.Clear();
+    return *this;
+  }
+
   ConfigLocation location;
   T default_value;
+  ConfigCache<T> cache;
 };
 
 using Layers = std::map<LayerType, std::unique_ptr<Layer>>;
@@ -73,12 +164,26 @@ T Get(LayerType layer, const ConfigInfo<T>& info)
       ->template Get<T>(info.location.key, info.default_value);
 }
 
+// Always looks the value up through the layers, bypassing the cache.
 template <typename T>
-T Get(const ConfigInfo<T>& info)
+T GetUncached(const ConfigInfo<T>& info)
 {
   return Get(LayerType::Meta, info);
 }
 
+template <typename T>
+T Get(const ConfigInfo<T>& info)
+{
+  const u32 version = GetConfigVersion();
+  T value;
+  if (info.cache.Get(version, &value))
+    return value;
+
+  value = GetUncached(info);
+  info.cache.Set(version, value);
+  return value;
+}
+
 template <typename T>
 T GetBase(const ConfigInfo<T>& info)
 {
@@ -77,6 +77,8 @@ public:
   u64 GetSize();
   bool Resize(u64 size);
   bool Flush();
+  // Flushes and waits until the OS has written the file to the storage device.
+  bool Sync();
 
   // clear error state
   void Clear()
@@ -64,6 +64,8 @@ enum
   F_GCSRAM_IDX,
   F_MEMORYWATCHERLOCATIONS_IDX,
   F_MEMORYWATCHERSOCKET_IDX,
+  F_MEMORYWATCHERREGIONS_IDX,
+  F_MEMORYWATCHERSNAPSHOTS_IDX,
   F_WIISDCARD_IDX,
   NUM_PATH_INDICES
 };
@@ -0,0 +1,238 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#ifdef USE_FRAME_TRACE
+
+#include "Common/FrameTrace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+
+namespace FrameTrace
+{
+namespace
+{
+struct Event
+{
+  const char* name;
+  u64 start;
+  u64 end;
+};
+
+constexpr u64 EVENTS_PER_THREAD = 1 << 16;
+// The oldest events of a full ring may be overwritten while the capture is being written, so
+// they're skipped.
+constexpr u64 EVENTS_IN_FLIGHT = 1 << 10;
+
+struct ThreadBuffer
+{
+  // Only written by the thread the buffer belongs to.
+  std::unique_ptr<Event[]> events{new Event[EVENTS_PER_THREAD]};
+  std::atomic<u64> count{0};
+
+  // Guarded by s_lock.
+  u32 id = 0;
+  std::string name;
+};
+}
+
+static std::mutex s_lock;
+static std::vector<std::shared_ptr<ThreadBuffer>> s_buffers;
+static u32 s_next_thread_id = 1;
+
+static std::atomic<bool> s_capturing{false};
+// Guarded by s_lock.
+static std::string s_filename;
+static u32 s_frames_left;
+static u64 s_capture_start;
+static std::vector<u64> s_frame_starts;
+
+static u64 GetTime()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+static ThreadBuffer* GetThreadBuffer()
+{
+  thread_local std::shared_ptr<ThreadBuffer> buffer;
+  if (!buffer)
+  {
+    buffer = std::make_shared<ThreadBuffer>();
+    std::lock_guard<std::mutex> lk(s_lock);
+    buffer->id = s_next_thread_id++;
+    s_buffers.push_back(buffer);
+  }
+  return buffer.get();
+}
+
+static std::string EscapeJSON(const std::string& str)
+{
+  std::string result;
+  for (char c : str)
+  {
+    if (c == '"' || c == '\\')
+      result += '\\';
+    if (static_cast<unsigned char>(c) >= 0x20)
+      result += c;
+  }
+  return result;
+}
+
+static std::string FormatEvent(const std::string& name, u32 thread_id, u64 start, u64 end)
+{
+  // Chrome traces use microseconds.
+  return StringFromFormat(
+      "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f},\n",
+      EscapeJSON(name).c_str(), thread_id, (start - s_capture_start) / 1000.0,
+      (end - start) / 1000.0);
+}
+
+static std::string FormatThreadName(const std::string& name, u32 thread_id)
+{
+  return StringFromFormat(
+      "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}},\n",
+      thread_id, EscapeJSON(name).c_str());
+}
+
+// Must be called with s_lock held, after the capture has stopped.
+static void WriteCapture()
+{
+  const u64 capture_end = s_frame_starts.back();
+  std::string trace = "{\"traceEvents\":[\n";
+  bool incomplete = false;
+
+  // Frames get a track of their own.
+  trace += FormatThreadName("Frames", 0);
+  for (size_t i = 0; i + 1 < s_frame_starts.size(); ++i)
+  {
+    trace += FormatEvent(StringFromFormat("Frame %zu", i + 1), 0, s_frame_starts[i],
+                         s_frame_starts[i + 1]);
+  }
+
+  for (const auto& buffer : s_buffers)
+  {
+    const u64 count = buffer->count.load(std::memory_order_acquire);
+    const u64 first = count > EVENTS_PER_THREAD ? count - EVENTS_PER_THREAD + EVENTS_IN_FLIGHT : 0;
+    if (first != 0 && buffer->events[first % EVENTS_PER_THREAD].start >= s_capture_start)
+      incomplete = true;
+
+    bool has_events = false;
+    for (u64 i = first; i < count; ++i)
+    {
+      const Event& event = buffer->events[i % EVENTS_PER_THREAD];
+      if (event.start < s_capture_start || event.end > capture_end)
+        continue;
+      trace += FormatEvent(event.name, buffer->id, event.start, event.end);
+      has_events = true;
+    }
+    if (has_events)
+    {
+      trace += FormatThreadName(
+          buffer->name.empty() ? StringFromFormat("Thread %u", buffer->id) : buffer->name,
+          buffer->id);
+    }
+  }
+
+  // JSON doesn't allow a trailing comma.
+  trace.resize(trace.size() - 2);
+  trace += "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+  File::IOFile file(s_filename, "wb");
+  if (!file.WriteBytes(trace.data(), trace.size()))
+  {
+    ERROR_LOG(COMMON, "Failed to write the frame trace to %s", s_filename.c_str());
+    return;
+  }
+  if (incomplete)
+  {
+    WARN_LOG(COMMON, "The frame trace in %s is incomplete, some threads recorded too many zones",
+             s_filename.c_str());
+  }
+  NOTICE_LOG(COMMON, "Wrote a frame trace of %zu frames to %s", s_frame_starts.size() - 1,
+             s_filename.c_str());
+
+  // Drop the buffers of threads that have exited.
+  s_buffers.erase(std::remove_if(s_buffers.begin(), s_buffers.end(),
+                                 [](const auto& buffer) { return buffer.use_count() == 1; }),
+                  s_buffers.end());
+}
+
+void SetThreadName(const char* name)
+{
+  ThreadBuffer* buffer = GetThreadBuffer();
+  std::lock_guard<std::mutex> lk(s_lock);
+  buffer->name = name;
+}
+
+bool StartCapture(const std::string& filename, u32 frame_count)
+{
+  std::lock_guard<std::mutex> lk(s_lock);
+  if (s_capturing.load(std::memory_order_relaxed) || frame_count == 0)
+    return false;
+
+  s_filename = filename;
+  s_frames_left = frame_count;
+  s_frame_starts.clear();
+  s_capture_start = GetTime();
+  s_capturing.store(true, std::memory_order_release);
+  return true;
+}
+
+bool IsCapturing()
+{
+  return s_capturing.load(std::memory_order_relaxed);
+}
+
+void MarkFrame()
+{
+  if (!s_capturing.load(std::memory_order_relaxed))
+    return;
+
+  std::lock_guard<std::mutex> lk(s_lock);
+  const u64 now = GetTime();
+  // The capture starts at the first frame boundary after StartCapture.
+  if (s_frame_starts.empty())
+  {
+    s_capture_start = now;
+    s_frame_starts.push_back(now);
+    return;
+  }
+
+  s_frame_starts.push_back(now);
+  if (--s_frames_left == 0)
+  {
+    s_capturing.store(false, std::memory_order_relaxed);
+    WriteCapture();
+  }
+}
+
+u64 BeginZone()
+{
+  if (!s_capturing.load(std::memory_order_relaxed))
+    return 0;
+  return GetTime();
+}
+
+void EndZone(const char* name, u64 start)
+{
+  ThreadBuffer* buffer = GetThreadBuffer();
+  const u64 count = buffer->count.load(std::memory_order_relaxed);
+  buffer->events[count % EVENTS_PER_THREAD] = {name, start, GetTime()};
+  buffer->count.store(count + 1, std::memory_order_release);
+}
+}
+
+#endif
@@ -0,0 +1,70 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+// Scoped-zone instrumentation, for finding out where the time of a frame goes on every thread.
+//
+// Zones are only recorded while a capture is running. Every thread records into a ring of its own
+// without taking any locks. Once the requested number of frames has been captured, the rings are
+// merged and written in the Chrome trace format, which chrome://tracing and Perfetto can open.
+//
+// All of this compiles to nothing unless Dolphin is built with FRAME_TRACE enabled.
+
+#ifdef USE_FRAME_TRACE
+
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace FrameTrace
+{
+// Names the calling thread in traces. Called by Common::SetCurrentThreadName.
+void SetThreadName(const char* name);
+
+// Starts capturing the next frame_count frames, and writes them to filename once done.
+// Returns false if a capture is already running.
+bool StartCapture(const std::string& filename, u32 frame_count);
+bool IsCapturing();
+// Marks the start of a new frame.
+void MarkFrame();
+
+// Returns the start time of a zone, or 0 if no capture is running.
+u64 BeginZone();
+void EndZone(const char* name, u64 start);
+
+class ScopedZone final
+{
+public:
+  // name must outlive the capture, which is the case for string literals.
+  explicit ScopedZone(const char* name) : m_name(name), m_start(BeginZone()) {}
+  ~ScopedZone()
+  {
+    if (m_start)
+      EndZone(m_name, m_start);
+  }
+
+  ScopedZone(const ScopedZone&) = delete;
+  ScopedZone& operator=(const ScopedZone&) = delete;
+
+private:
+  const char* m_name;
+  u64 m_start;
+};
+}
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+#define TRACE_ZONE(name) FrameTrace::ScopedZone TRACE_CONCAT(trace_zone_, __LINE__)(name)
+#define TRACE_FRAME() FrameTrace::MarkFrame()
+#define TRACE_THREAD_NAME(name) FrameTrace::SetThreadName(name)
+
+#else
+
+#define TRACE_ZONE(name) ((void)0)
+#define TRACE_FRAME() ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+
+#endif
@@ -7,7 +7,11 @@
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/File.h"
@@ -20,6 +24,13 @@
 #include <unistd.h>
 #endif
 
+#ifdef __linux__
+#include <elf.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#endif
+
 #if defined USE_OPROFILE && USE_OPROFILE
 #include <opagent.h>
 #endif
@@ -29,16 +40,240 @@
 #pragma comment(lib, "jitprofiling.lib")
 #endif
 
+#if (defined USE_OPROFILE && USE_OPROFILE) || defined(USE_VTUNE)
+#define HAS_PROFILING_AGENT 1
+#endif
+
 #if defined USE_OPROFILE && USE_OPROFILE
 static op_agent_t s_agent = nullptr;
 #endif
 
+// Registration can happen on the CPU, GPU and DSP threads.
+static std::mutex s_lock;
 static File::IOFile s_perf_map_file;
 
+#ifdef HAS_PROFILING_AGENT
+// The code currently known to the agents, by start address. Agents need to be told when code is
+// unloaded. Instead of requiring every user to do so, code is unloaded as soon as new code is
+// registered over it.
+struct LiveCode
+{
+  uintptr_t end;
+  u32 method_id;
+};
+static std::map<uintptr_t, LiveCode> s_live_code;
+#endif
+
+#ifdef __linux__
+// See tools/perf/Documentation/jitdump-specification.txt in the Linux sources.
+namespace JitDump
+{
+constexpr u32 MAGIC = 0x4A695444;
+constexpr u32 VERSION = 1;
+
+enum RecordType : u32
+{
+  JIT_CODE_LOAD = 0,
+  JIT_CODE_DEBUG_INFO = 2,
+  JIT_CODE_CLOSE = 3,
+};
+
+struct FileHeader
+{
+  u32 magic;
+  u32 version;
+  u32 total_size;
+  u32 elf_mach;
+  u32 pad1;
+  u32 pid;
+  u64 timestamp;
+  u64 flags;
+};
+
+struct RecordHeader
+{
+  u32 id;
+  u32 total_size;
+  u64 timestamp;
+};
+
+struct CodeLoad
+{
+  RecordHeader header;
+  u32 pid;
+  u32 tid;
+  u64 vma;
+  u64 code_addr;
+  u64 code_size;
+  u64 code_index;
+  // Followed by the null-terminated name and the code.
+};
+
+struct DebugInfo
+{
+  RecordHeader header;
+  u64 code_addr;
+  u64 nr_entry;
+  // Followed by the entries.
+};
+
+struct DebugEntry
+{
+  u64 code_addr;
+  u32 line;
+  u32 discrim;
+  // Followed by the null-terminated file name.
+};
+}
+
+static File::IOFile s_jitdump_file;
+// perf only finds the dump through an executable mapping of it.
+static void* s_jitdump_marker = nullptr;
+static size_t s_jitdump_marker_size = 0;
+static u64 s_code_index = 0;
+static std::vector<u8> s_record;
+
+// perf has to be told to use the same clock (perf record -k mono).
+static u64 GetTimestamp()
+{
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<u64>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+static u32 GetElfMachine()
+{
+#if defined(_M_X86_64)
+  return EM_X86_64;
+#elif defined(_M_ARM_64)
+  return EM_AARCH64;
+#else
+  return EM_NONE;
+#endif
+}
+
+template <typename T>
+static void AppendToRecord(const T& value)
+{
+  const u8* bytes = reinterpret_cast<const u8*>(&value);
+  s_record.insert(s_record.end(), bytes, bytes + sizeof(T));
+}
+
+static void AppendToRecord(const void* data, size_t size)
+{
+  const u8* bytes = static_cast<const u8*>(data);
+  s_record.insert(s_record.end(), bytes, bytes + size);
+}
+
+static void WriteRecord(u32 id, u64 timestamp)
+{
+  JitDump::RecordHeader* header = reinterpret_cast<JitDump::RecordHeader*>(s_record.data());
+  header->id = id;
+  header->total_size = static_cast<u32>(s_record.size());
+  header->timestamp = timestamp;
+  s_jitdump_file.WriteBytes(s_record.data(), s_record.size());
+}
+
+static void OpenJitDump(const std::string& dir)
+{
+  const std::string filename = StringFromFormat("%s/jit-%d.dump", dir.c_str(), getpid());
+  if (!s_jitdump_file.Open(filename, "w+b"))
+    return;
+
+  JitDump::FileHeader header = {};
+  header.magic = JitDump::MAGIC;
+  header.version = JitDump::VERSION;
+  header.total_size = sizeof(header);
+  header.elf_mach = GetElfMachine();
+  header.pid = static_cast<u32>(getpid());
+  header.timestamp = GetTimestamp();
+  s_jitdump_file.WriteBytes(&header, sizeof(header));
+  s_jitdump_file.Flush();
+  s_code_index = 0;
+
+  s_jitdump_marker_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  s_jitdump_marker = mmap(nullptr, s_jitdump_marker_size, PROT_READ | PROT_EXEC, MAP_PRIVATE,
+                          fileno(s_jitdump_file.GetHandle()), 0);
+  if (s_jitdump_marker == MAP_FAILED)
+  {
+    s_jitdump_marker = nullptr;
+    s_jitdump_file.Close();
+  }
+}
+
+static void CloseJitDump()
+{
+  if (!s_jitdump_file.IsOpen())
+    return;
+
+  s_record.assign(sizeof(JitDump::RecordHeader), 0);
+  WriteRecord(JitDump::JIT_CODE_CLOSE, GetTimestamp());
+  munmap(s_jitdump_marker, s_jitdump_marker_size);
+  s_jitdump_marker = nullptr;
+  s_jitdump_file.Close();
+}
+
+static void WriteJitDump(const void* base_address, u32 code_size, const std::string& symbol_name,
+                         const std::vector<JitRegister::LineEntry>* lines)
+{
+  const u64 timestamp = GetTimestamp();
+  const u64 code_address = reinterpret_cast<uintptr_t>(base_address);
+
+  // The debug information has to precede the code it describes.
+  if (lines && !lines->empty())
+  {
+    s_record.assign(sizeof(JitDump::DebugInfo), 0);
+    JitDump::DebugInfo* info = reinterpret_cast<JitDump::DebugInfo*>(s_record.data());
+    info->code_addr = code_address;
+    info->nr_entry = lines->size();
+    for (const JitRegister::LineEntry& line : *lines)
+    {
+      AppendToRecord(JitDump::DebugEntry{reinterpret_cast<uintptr_t>(line.host_address),
+                                         line.line, 0});
+      AppendToRecord(line.file.c_str(), line.file.size() + 1);
+    }
+    WriteRecord(JitDump::JIT_CODE_DEBUG_INFO, timestamp);
+  }
+
+  s_record.assign(sizeof(JitDump::CodeLoad), 0);
+  JitDump::CodeLoad* load = reinterpret_cast<JitDump::CodeLoad*>(s_record.data());
+  load->pid = static_cast<u32>(getpid());
+  load->tid = static_cast<u32>(syscall(SYS_gettid));
+  load->vma = code_address;
+  load->code_addr = code_address;
+  load->code_size = code_size;
+  load->code_index = s_code_index++;
+  AppendToRecord(symbol_name.c_str(), symbol_name.size() + 1);
+  AppendToRecord(base_address, code_size);
+  WriteRecord(JitDump::JIT_CODE_LOAD, timestamp);
+}
+#endif
+
+#ifdef HAS_PROFILING_AGENT
+static void UnloadOverlappingCode(uintptr_t start, uintptr_t end)
+{
+  auto it = s_live_code.upper_bound(start);
+  if (it != s_live_code.begin() && std::prev(it)->second.end > start)
+    --it;
+  while (it != s_live_code.end() && it->first < end)
+  {
+#if defined USE_OPROFILE && USE_OPROFILE
+    op_unload_native_code(s_agent, it->first);
+#endif
+#ifdef USE_VTUNE
+    iJIT_NotifyEvent(iJVM_EVENT_TYPE_METHOD_UNLOAD_START, &it->second.method_id);
+#endif
+    it = s_live_code.erase(it);
+  }
+}
+#endif
+
 namespace JitRegister
 {
 void Init(const std::string& perf_dir)
 {
+  std::lock_guard<std::mutex> lk(s_lock);
+
 #if defined USE_OPROFILE && USE_OPROFILE
   s_agent = op_open_agent();
 #endif
@@ -51,11 +286,17 @@ void Init(const std::string& perf_dir)
     // Disable buffering in order to avoid missing some mappings
     // if the event of a crash:
     std::setvbuf(s_perf_map_file.GetHandle(), nullptr, _IONBF, 0);
+
+#ifdef __linux__
+    OpenJitDump(dir);
+#endif
   }
 }
 
 void Shutdown()
 {
+  std::lock_guard<std::mutex> lk(s_lock);
+
 #if defined USE_OPROFILE && USE_OPROFILE
   op_close_agent(s_agent);
   s_agent = nullptr;
@@ -65,19 +306,43 @@ void Shutdown()
   iJIT_NotifyEvent(iJVM_EVENT_TYPE_SHUTDOWN, nullptr);
 #endif
 
+#ifdef HAS_PROFILING_AGENT
+  s_live_code.clear();
+#endif
+
   if (s_perf_map_file.IsOpen())
     s_perf_map_file.Close();
+
+#ifdef __linux__
+  CloseJitDump();
+#endif
 }
 
-void RegisterV(const void* base_address, u32 code_size, const char* format, va_list args)
+bool IsEnabled()
 {
-#if !(defined USE_OPROFILE && USE_OPROFILE) && !defined(USE_VTUNE)
-  if (!s_perf_map_file.IsOpen())
-    return;
+#ifdef HAS_PROFILING_AGENT
+  return true;
+#else
+  return s_perf_map_file.IsOpen();
 #endif
+}
+
+static void Register(const void* base_address, u32 code_size, const std::vector<LineEntry>* lines,
+                     const char* format, va_list args)
+{
+  if (!IsEnabled())
+    return;
 
   std::string symbol_name = StringFromFormatV(format, args);
 
+  std::lock_guard<std::mutex> lk(s_lock);
+
+#ifdef HAS_PROFILING_AGENT
+  const uintptr_t start = reinterpret_cast<uintptr_t>(base_address);
+  UnloadOverlappingCode(start, start + code_size);
+  u32 method_id = 0;
+#endif
+
 #if defined USE_OPROFILE && USE_OPROFILE
   op_write_native_code(s_agent, symbol_name.data(), (u64)base_address, base_address, code_size);
 #endif
@@ -89,6 +354,11 @@ void RegisterV(const void* base_address, u32 code_size, const char* format, va_l
   jmethod.method_size = code_size;
   jmethod.method_name = const_cast<char*>(symbol_name.data());
   iJIT_NotifyEvent(iJVM_EVENT_TYPE_METHOD_LOAD_FINISHED, (void*)&jmethod);
+  method_id = jmethod.method_id;
+#endif
+
+#ifdef HAS_PROFILING_AGENT
+  s_live_code[start] = {start + code_size, method_id};
 #endif
 
   // Linux perf /tmp/perf-$pid.map:
@@ -98,5 +368,21 @@ void RegisterV(const void* base_address, u32 code_size, const char* format, va_l
         StringFromFormat("%" PRIx64 " %x %s\n", (u64)base_address, code_size, symbol_name.data());
     s_perf_map_file.WriteBytes(entry.data(), entry.size());
   }
+
+#ifdef __linux__
+  if (s_jitdump_file.IsOpen())
+    WriteJitDump(base_address, code_size, symbol_name, lines);
+#endif
+}
+
+void RegisterV(const void* base_address, u32 code_size, const char* format, va_list args)
+{
+  Register(base_address, code_size, nullptr, format, args);
+}
+
+void RegisterWithLinesV(const void* base_address, u32 code_size,
+                        const std::vector<LineEntry>& lines, const char* format, va_list args)
+{
+  Register(base_address, code_size, &lines, format, args);
 }
 }
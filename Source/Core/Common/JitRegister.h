@@ -5,13 +5,37 @@
 #pragma once
 #include <stdarg.h>
 #include <string>
+#include <vector>
 #include "Common/CommonTypes.h"
 
+// Tells host profilers about generated code.
+//
+// If a perf directory is configured (or PERF_BUILDID_DIR is set), this writes both a
+// perf-<pid>.map file and a jit-<pid>.dump file in the jitdump format. The latter contains a copy
+// of the code and is timestamped, so that code which is freed and regenerated at the same address
+// is still attributed correctly. To use it, record with a monotonic clock and inject the dump:
+//   perf record -k mono ...
+//   perf inject --jit -i perf.data -o perf.jit.data
+//   perf report -i perf.jit.data
 namespace JitRegister
 {
+// Attributes the host code from host_address up to the next entry (or the end of the code) to a
+// line of a source file. Only jitdump records this information.
+struct LineEntry
+{
+  const void* host_address;
+  std::string file;
+  u32 line;
+};
+
 void Init(const std::string& perf_dir);
 void Shutdown();
+// Returns whether any profiler is listening. Callers can use this to skip gathering line entries.
+bool IsEnabled();
 void RegisterV(const void* base_address, u32 code_size, const char* format, va_list args);
+// lines must be sorted by host address.
+void RegisterWithLinesV(const void* base_address, u32 code_size,
+                        const std::vector<LineEntry>& lines, const char* format, va_list args);
 
 inline void Register(const void* base_address, u32 code_size, const char* format, ...)
 {
@@ -29,4 +53,14 @@ inline void Register(const void* start, const void* end, const char* format, ...
   RegisterV(start, code_size, format, args);
   va_end(args);
 }
+
+inline void RegisterWithLines(const void* start, const void* end,
+                              const std::vector<LineEntry>& lines, const char* format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  u32 code_size = (u32)((const char*)end - (const char*)start);
+  RegisterWithLinesV(start, code_size, lines, format, args);
+  va_end(args);
+}
 }
@@ -0,0 +1,525 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/Logging/LogBuffer.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "Common/Assert.h"
+#include "Common/StringUtil.h"
+
+namespace
+{
+constexpr size_t MAX_MSGLEN = 1024;
+constexpr size_t MAX_RECORD_SIZE = 2048;
+constexpr size_t SLOT_SIZE = sizeof(u64);
+
+enum class RecordKind : u8
+{
+  Padding,
+  Deferred,
+  Formatted,
+};
+
+struct alignas(8) RecordHeader
+{
+  u32 size;
+  RecordKind kind;
+  u8 level;
+  u8 type;
+  s32 line;
+  const char* file;
+  const char* format;
+  u64 timestamp;
+};
+static_assert(sizeof(RecordHeader) % SLOT_SIZE == 0, "Records must stay aligned");
+
+enum class ArgType
+{
+  Int,
+  Long,
+  LongLong,
+  Size,
+  IntMax,
+  PtrDiff,
+  Double,
+  LongDouble,
+  String,
+  Pointer,
+  Unsupported,
+};
+
+struct Conversion
+{
+  const char* start;
+  size_t length;
+  int stars;
+  ArgType type;
+};
+
+size_t AlignUp(size_t size)
+{
+  return (size + SLOT_SIZE - 1) & ~(SLOT_SIZE - 1);
+}
+
+// Finds the next printf conversion in the format string and advances the cursor past it.
+bool FindConversion(const char** cursor, Conversion* conversion)
+{
+  const char* format = *cursor;
+  while (*format)
+  {
+    if (*format++ != '%')
+      continue;
+    if (*format == '%')
+    {
+      ++format;
+      continue;
+    }
+
+    conversion->start = format - 1;
+    conversion->stars = 0;
+
+    while (*format && std::strchr("-+ #0'", *format))
+      ++format;
+    if (*format == '*')
+    {
+      ++conversion->stars;
+      ++format;
+    }
+    while (*format >= '0' && *format <= '9')
+      ++format;
+    if (*format == '.')
+    {
+      ++format;
+      if (*format == '*')
+      {
+        ++conversion->stars;
+        ++format;
+      }
+      while (*format >= '0' && *format <= '9')
+        ++format;
+    }
+
+    char length = 0;
+    int longs = 0;
+    while (*format && std::strchr("hlLzjt", *format))
+    {
+      if (*format == 'l')
+        ++longs;
+      length = *format++;
+    }
+
+    const char specifier = *format;
+    if (specifier)
+      ++format;
+
+    switch (specifier)
+    {
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+      if (longs >= 2)
+        conversion->type = ArgType::LongLong;
+      else if (longs == 1)
+        conversion->type = ArgType::Long;
+      else if (length == 'z')
+        conversion->type = ArgType::Size;
+      else if (length == 'j')
+        conversion->type = ArgType::IntMax;
+      else if (length == 't')
+        conversion->type = ArgType::PtrDiff;
+      else if (length == 'L')
+        conversion->type = ArgType::Unsupported;
+      else
+        conversion->type = ArgType::Int;
+      break;
+    case 'c':
+      conversion->type = length ? ArgType::Unsupported : ArgType::Int;
+      break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+      conversion->type = length == 'L' ? ArgType::LongDouble : ArgType::Double;
+      break;
+    case 's':
+      conversion->type = length ? ArgType::Unsupported : ArgType::String;
+      break;
+    case 'p':
+      conversion->type = ArgType::Pointer;
+      break;
+    default:
+      // %n, wide characters and anything malformed.
+      conversion->type = ArgType::Unsupported;
+      break;
+    }
+
+    conversion->length = format - conversion->start;
+    *cursor = format;
+    return true;
+  }
+
+  *cursor = format;
+  return false;
+}
+
+class ArgumentWriter
+{
+public:
+  ArgumentWriter(u8* out, size_t capacity) : m_out(out), m_capacity(capacity) {}
+
+  bool WriteSlot(u64 value)
+  {
+    if (m_size + SLOT_SIZE > m_capacity)
+      return false;
+    std::memcpy(m_out + m_size, &value, SLOT_SIZE);
+    m_size += SLOT_SIZE;
+    return true;
+  }
+
+  bool WriteDouble(double value)
+  {
+    u64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return WriteSlot(bits);
+  }
+
+  // Truncates the string if it doesn't fit.
+  bool WriteString(const char* str)
+  {
+    if (!str)
+      str = "(null)";
+    if (m_size + SLOT_SIZE > m_capacity)
+      return false;
+
+    const size_t available = m_capacity - m_size - sizeof(u32);
+    const u32 length = static_cast<u32>(strnlen(str, std::min(available, MAX_MSGLEN)));
+    std::memcpy(m_out + m_size, &length, sizeof(u32));
+    std::memcpy(m_out + m_size + sizeof(u32), str, length);
+    m_size += AlignUp(sizeof(u32) + length);
+    return true;
+  }
+
+  size_t GetSize() const { return m_size; }
+
+private:
+  u8* m_out;
+  size_t m_capacity;
+  size_t m_size = 0;
+};
+
+// Copies the arguments used by the format string. Returns false if the format string uses
+// something that can't be deferred, in which case the message has to be formatted right away.
+bool CaptureArguments(const char* format, va_list args, u8* out, size_t capacity, size_t* size)
+{
+  ArgumentWriter writer(out, capacity);
+  Conversion conversion;
+  while (FindConversion(&format, &conversion))
+  {
+    for (int i = 0; i < conversion.stars; ++i)
+    {
+      if (!writer.WriteSlot(static_cast<u64>(va_arg(args, int))))
+        return false;
+    }
+
+    bool written;
+    switch (conversion.type)
+    {
+    case ArgType::Int:
+      written = writer.WriteSlot(static_cast<u64>(va_arg(args, int)));
+      break;
+    case ArgType::Long:
+      written = writer.WriteSlot(static_cast<u64>(va_arg(args, long)));
+      break;
+    case ArgType::LongLong:
+      written = writer.WriteSlot(static_cast<u64>(va_arg(args, long long)));
+      break;
+    case ArgType::Size:
+      written = writer.WriteSlot(static_cast<u64>(va_arg(args, size_t)));
+      break;
+    case ArgType::IntMax:
+      written = writer.WriteSlot(static_cast<u64>(va_arg(args, intmax_t)));
+      break;
+    case ArgType::PtrDiff:
+      written = writer.WriteSlot(static_cast<u64>(va_arg(args, ptrdiff_t)));
+      break;
+    case ArgType::Double:
+      written = writer.WriteDouble(va_arg(args, double));
+      break;
+    case ArgType::LongDouble:
+      written = writer.WriteDouble(static_cast<double>(va_arg(args, long double)));
+      break;
+    case ArgType::String:
+      written = writer.WriteString(va_arg(args, const char*));
+      break;
+    case ArgType::Pointer:
+      written = writer.WriteSlot(reinterpret_cast<uintptr_t>(va_arg(args, void*)));
+      break;
+    default:
+      written = false;
+      break;
+    }
+    if (!written)
+      return false;
+  }
+
+  *size = writer.GetSize();
+  return true;
+}
+
+void AppendLiteral(std::string* out, const char* begin, const char* end)
+{
+  while (begin < end)
+  {
+    if (*begin == '%' && begin + 1 < end && begin[1] == '%')
+      ++begin;
+    out->push_back(*begin++);
+  }
+}
+
+template <typename T>
+void AppendConversion(std::string* out, const std::string& spec, const int* stars, int num_stars,
+                      T value)
+{
+  if (num_stars == 0)
+    *out += StringFromFormat(spec.c_str(), value);
+  else if (num_stars == 1)
+    *out += StringFromFormat(spec.c_str(), stars[0], value);
+  else
+    *out += StringFromFormat(spec.c_str(), stars[0], stars[1], value);
+}
+
+void FormatArguments(const char* format, const u8* args, std::string* out)
+{
+  const auto read_slot = [&args] {
+    u64 value;
+    std::memcpy(&value, args, SLOT_SIZE);
+    args += SLOT_SIZE;
+    return value;
+  };
+
+  const char* cursor = format;
+  const char* literal = format;
+  Conversion conversion;
+  while (FindConversion(&cursor, &conversion))
+  {
+    AppendLiteral(out, literal, conversion.start);
+    literal = cursor;
+
+    int stars[2] = {};
+    for (int i = 0; i < conversion.stars; ++i)
+      stars[i] = static_cast<int>(read_slot());
+
+    std::string spec(conversion.start, conversion.length);
+    switch (conversion.type)
+    {
+    case ArgType::Int:
+      AppendConversion(out, spec, stars, conversion.stars, static_cast<int>(read_slot()));
+      break;
+    case ArgType::Long:
+      AppendConversion(out, spec, stars, conversion.stars, static_cast<long>(read_slot()));
+      break;
+    case ArgType::LongLong:
+      AppendConversion(out, spec, stars, conversion.stars, static_cast<long long>(read_slot()));
+      break;
+    case ArgType::Size:
+      AppendConversion(out, spec, stars, conversion.stars, static_cast<size_t>(read_slot()));
+      break;
+    case ArgType::IntMax:
+      AppendConversion(out, spec, stars, conversion.stars, static_cast<intmax_t>(read_slot()));
+      break;
+    case ArgType::PtrDiff:
+      AppendConversion(out, spec, stars, conversion.stars, static_cast<ptrdiff_t>(read_slot()));
+      break;
+    case ArgType::LongDouble:
+      // Long doubles were stored as doubles.
+      spec.erase(spec.find('L'), 1);
+      // fallthrough
+    case ArgType::Double:
+    {
+      const u64 bits = read_slot();
+      double value;
+      std::memcpy(&value, &bits, sizeof(value));
+      AppendConversion(out, spec, stars, conversion.stars, value);
+      break;
+    }
+    case ArgType::String:
+    {
+      u32 length;
+      std::memcpy(&length, args, sizeof(u32));
+      const std::string str(reinterpret_cast<const char*>(args) + sizeof(u32), length);
+      args += AlignUp(sizeof(u32) + length);
+      AppendConversion(out, spec, stars, conversion.stars, str.c_str());
+      break;
+    }
+    case ArgType::Pointer:
+      AppendConversion(out, spec, stars, conversion.stars,
+                       reinterpret_cast<const void*>(static_cast<uintptr_t>(read_slot())));
+      break;
+    default:
+      _assert_msg_(COMMON, false, "Unsupported conversion in a deferred log record");
+      return;
+    }
+  }
+  AppendLiteral(out, literal, literal + std::strlen(literal));
+}
+}  // namespace
+
+LogBuffer::LogBuffer(size_t capacity) : m_data(capacity), m_mask(capacity - 1)
+{
+  _assert_msg_(COMMON, capacity && (capacity & m_mask) == 0 && capacity >= MAX_RECORD_SIZE,
+             "Invalid log buffer capacity");
+}
+
+bool LogBuffer::Push(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type, const char* file,
+                     int line, u64 timestamp, const char* format, va_list args)
+{
+  return Push(level, type, file, line, timestamp, format, args, true);
+}
+
+bool LogBuffer::PushFormatted(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type,
+                              const char* file, int line, u64 timestamp, const char* format,
+                              va_list args)
+{
+  return Push(level, type, file, line, timestamp, format, args, false);
+}
+
+bool LogBuffer::Push(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type, const char* file,
+                     int line, u64 timestamp, const char* format, va_list args, bool deferred)
+{
+  alignas(8) u8 record[MAX_RECORD_SIZE];
+  RecordHeader header{};
+  header.level = static_cast<u8>(level);
+  header.type = static_cast<u8>(type);
+  header.line = line;
+  header.file = file;
+  header.timestamp = timestamp;
+
+  u8* const payload = record + sizeof(RecordHeader);
+  const size_t payload_capacity = sizeof(record) - sizeof(RecordHeader);
+  size_t payload_size = 0;
+
+  if (deferred)
+  {
+    va_list args_copy;
+    va_copy(args_copy, args);
+    deferred = CaptureArguments(format, args_copy, payload, payload_capacity, &payload_size);
+    va_end(args_copy);
+  }
+
+  if (deferred)
+  {
+    header.kind = RecordKind::Deferred;
+    header.format = format;
+  }
+  else
+  {
+    char* text = reinterpret_cast<char*>(payload);
+    CharArrayFromFormatV(text, static_cast<int>(std::min(payload_capacity, MAX_MSGLEN)), format,
+                         args);
+    header.kind = RecordKind::Formatted;
+    header.format = nullptr;
+    payload_size = std::strlen(text) + 1;
+  }
+
+  header.size = static_cast<u32>(sizeof(RecordHeader) + AlignUp(payload_size));
+  std::memcpy(record, &header, sizeof(RecordHeader));
+  return Write(record, header.size);
+}
+
+bool LogBuffer::Write(const u8* record, u32 size)
+{
+  const u64 write_position = m_write_position.load(std::memory_order_relaxed);
+  const u64 read_position = m_read_position.load(std::memory_order_acquire);
+
+  // Records are never split, so skip the end of the ring if the record doesn't fit there.
+  const size_t offset = write_position & m_mask;
+  const size_t space_to_end = m_data.size() - offset;
+  const size_t padding = space_to_end < size ? space_to_end : 0;
+  if (write_position + padding + size - read_position > m_data.size())
+  {
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  if (padding)
+  {
+    const u32 padding_size = static_cast<u32>(padding);
+    const RecordKind kind = RecordKind::Padding;
+    std::memcpy(&m_data[offset], &padding_size, sizeof(u32));
+    std::memcpy(&m_data[offset + offsetof(RecordHeader, kind)], &kind, sizeof(kind));
+  }
+  std::memcpy(&m_data[(write_position + padding) & m_mask], record, size);
+  m_write_position.store(write_position + padding + size, std::memory_order_release);
+  return true;
+}
+
+bool LogBuffer::Pop(Entry* entry)
+{
+  u64 read_position = m_read_position.load(std::memory_order_relaxed);
+  const u64 write_position = m_write_position.load(std::memory_order_acquire);
+
+  while (read_position != write_position)
+  {
+    const u8* record = &m_data[read_position & m_mask];
+    u32 size;
+    RecordKind kind;
+    std::memcpy(&size, record, sizeof(u32));
+    std::memcpy(&kind, record + offsetof(RecordHeader, kind), sizeof(kind));
+    if (kind == RecordKind::Padding)
+    {
+      read_position += size;
+      continue;
+    }
+
+    RecordHeader header;
+    std::memcpy(&header, record, sizeof(RecordHeader));
+    entry->level = static_cast<LogTypes::LOG_LEVELS>(header.level);
+    entry->type = static_cast<LogTypes::LOG_TYPE>(header.type);
+    entry->file = header.file;
+    entry->line = header.line;
+    entry->timestamp = header.timestamp;
+    entry->message.clear();
+
+    const u8* payload = record + sizeof(RecordHeader);
+    if (kind == RecordKind::Deferred)
+      FormatArguments(header.format, payload, &entry->message);
+    else
+      entry->message = reinterpret_cast<const char*>(payload);
+
+    m_read_position.store(read_position + size, std::memory_order_release);
+    return true;
+  }
+
+  m_read_position.store(read_position, std::memory_order_release);
+  return false;
+}
+
+bool LogBuffer::IsEmpty() const
+{
+  return m_read_position.load(std::memory_order_acquire) ==
+         m_write_position.load(std::memory_order_acquire);
+}
+
+bool LogBuffer::IsMoreThanHalfFull() const
+{
+  return m_write_position.load(std::memory_order_relaxed) -
+             m_read_position.load(std::memory_order_relaxed) >
+         m_data.size() / 2;
+}
+
+u64 LogBuffer::TakeDroppedCount()
+{
+  return m_dropped.exchange(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,71 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <cstdarg>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
+
+// A single-producer, single-consumer ring of binary log records.
+//
+// Push only copies the format string pointer and the arguments into the ring: it doesn't
+// allocate, format or do any I/O. The arguments are turned back into text by the consumer. This
+// requires the format string and the file name to outlive the record, which is the case for the
+// string literals used by the logging macros. Use PushFormatted for anything else.
+class LogBuffer
+{
+public:
+  struct Entry
+  {
+    LogTypes::LOG_LEVELS level;
+    LogTypes::LOG_TYPE type;
+    const char* file;
+    int line;
+    u64 timestamp;
+    std::string message;
+  };
+
+  // The capacity must be a power of two.
+  explicit LogBuffer(size_t capacity);
+
+  // Returns false and counts the message as dropped if the ring is full.
+  bool Push(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type, const char* file, int line,
+            u64 timestamp, const char* format, va_list args);
+  bool PushFormatted(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type, const char* file,
+                     int line, u64 timestamp, const char* format, va_list args);
+
+  // Formats the oldest record into entry and removes it. Returns false if the ring is empty.
+  bool Pop(Entry* entry);
+
+  bool IsEmpty() const;
+  bool IsMoreThanHalfFull() const;
+  // Returns the number of messages dropped since the last call.
+  u64 TakeDroppedCount();
+
+  // Set when the producer thread has exited.
+  void SetOrphaned() { m_orphaned.store(true, std::memory_order_release); }
+  bool IsOrphaned() const { return m_orphaned.load(std::memory_order_acquire); }
+
+private:
+  bool Push(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type, const char* file, int line,
+            u64 timestamp, const char* format, va_list args, bool deferred);
+  bool Write(const u8* record, u32 size);
+
+  std::vector<u8> m_data;
+  size_t m_mask;
+
+  // Written by the producer.
+  alignas(64) std::atomic<u64> m_write_position{0};
+  std::atomic<u64> m_dropped{0};
+  // Written by the consumer.
+  alignas(64) std::atomic<u64> m_read_position{0};
+
+  std::atomic<bool> m_orphaned{false};
+};
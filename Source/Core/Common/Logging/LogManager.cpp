@@ -2,8 +2,11 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <chrono>
 #include <cstdarg>
 #include <cstring>
+#include <ctime>
 #include <mutex>
 #include <ostream>
 #include <string>
@@ -13,11 +16,13 @@
 #include "Common/FileUtil.h"
 #include "Common/Logging/ConsoleListener.h"
 #include "Common/Logging/Log.h"
+#include "Common/Logging/LogBuffer.h"
 #include "Common/Logging/LogManager.h"
 #include "Common/StringUtil.h"
-#include "Common/Timer.h"
+#include "Common/Thread.h"
 
-constexpr size_t MAX_MSGLEN = 1024;
+// Per thread. A thread that logs faster than this can be written out loses messages.
+constexpr size_t THREAD_BUFFER_SIZE = 256 * 1024;
 
 const Config::ConfigInfo<bool> LOGGER_WRITE_TO_FILE{
     {Config::System::Logger, "Options", "WriteToFile"}, false};
@@ -64,6 +69,39 @@ void GenericLog(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type, const char*
   va_end(args);
 }
 
+namespace
+{
+struct ThreadLogBuffer
+{
+  ~ThreadLogBuffer()
+  {
+    if (buffer)
+      buffer->SetOrphaned();
+  }
+
+  std::shared_ptr<LogBuffer> buffer;
+  u64 generation = 0;
+};
+
+thread_local ThreadLogBuffer t_log_buffer;
+std::atomic<u64> s_generation{0};
+}  // namespace
+
+static u64 GetTimestamp()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+static std::string FormatTimestamp(u64 timestamp)
+{
+  const time_t seconds = static_cast<time_t>(timestamp / 1000000);
+  char tmp[13];
+  strftime(tmp, 6, "%M:%S", localtime(&seconds));
+  return StringFromFormat("%s:%03d", tmp, static_cast<int>(timestamp / 1000 % 1000));
+}
+
 static size_t DeterminePathCutOffPoint()
 {
   constexpr const char* pattern = DIR_SEP "Source" DIR_SEP "Core" DIR_SEP;
@@ -73,7 +111,7 @@ static size_t DeterminePathCutOffPoint()
   return 0;
 }
 
-LogManager::LogManager()
+LogManager::LogManager() : m_generation(++s_generation)
 {
   // create log containers
   m_log[LogTypes::ACTIONREPLAY] = {"ActionReplay", "ActionReplay"};
@@ -147,10 +185,17 @@ LogManager::LogManager()
         Config::ConfigInfo<bool>{{Config::System::Logger, "Logs", container.m_short_name}, false});
 
   m_path_cutoff_point = DeterminePathCutOffPoint();
+
+  m_writer_thread = std::thread(&LogManager::WriterThread, this);
 }
 
 LogManager::~LogManager()
 {
+  m_writer_running = false;
+  m_writer_event.Set();
+  m_writer_thread.join();
+  WriteQueuedMessages();
+
   // The log window listener pointer is owned by the GUI code.
   delete m_listeners[LogListener::CONSOLE_LISTENER];
   delete m_listeners[LogListener::FILE_LISTENER];
@@ -175,25 +220,124 @@ void LogManager::SaveSettings()
 void LogManager::Log(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type, const char* file,
                      int line, const char* format, va_list args)
 {
-  return LogWithFullPath(level, type, file + m_path_cutoff_point, line, format, args);
+  Enqueue(level, type, file + m_path_cutoff_point, line, format, args, true);
 }
 
 void LogManager::LogWithFullPath(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type,
                                  const char* file, int line, const char* format, va_list args)
 {
-  if (!IsEnabled(type, level) || !static_cast<bool>(m_listener_ids))
+  Enqueue(level, type, file, line, format, args, false);
+}
+
+void LogManager::Enqueue(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type, const char* file,
+                         int line, const char* format, va_list args, bool deferred)
+{
+  if (!IsEnabled(type, level) || !m_any_listener_enabled.load(std::memory_order_relaxed))
     return;
 
-  char temp[MAX_MSGLEN];
-  CharArrayFromFormatV(temp, MAX_MSGLEN, format, args);
+  LogBuffer* buffer = GetThreadBuffer();
+  if (deferred)
+    buffer->Push(level, type, file, line, GetTimestamp(), format, args);
+  else
+    buffer->PushFormatted(level, type, file, line, GetTimestamp(), format, args);
 
-  std::string msg =
-      StringFromFormat("%s %s:%u %c[%s]: %s\n", Common::Timer::GetTimeFormatted().c_str(), file,
-                       line, LogTypes::LOG_LEVEL_TO_CHAR[(int)level], GetShortName(type), temp);
+  // The writer thread clears the flag before it drains the buffers, so a message is either
+  // drained by the current pass or wakes the writer up for another one.
+  if (!m_writer_pending.exchange(true))
+    m_writer_event.Set();
+}
 
-  for (auto listener_id : m_listener_ids)
-    if (m_listeners[listener_id])
-      m_listeners[listener_id]->Log(level, msg.c_str());
+LogBuffer* LogManager::GetThreadBuffer()
+{
+  if (t_log_buffer.generation != m_generation)
+  {
+    // The thread logged to a previous LogManager before.
+    if (t_log_buffer.buffer)
+      t_log_buffer.buffer->SetOrphaned();
+
+    t_log_buffer.buffer = std::make_shared<LogBuffer>(THREAD_BUFFER_SIZE);
+    t_log_buffer.generation = m_generation;
+
+    std::lock_guard<std::mutex> lk(m_buffers_lock);
+    m_buffers.push_back(t_log_buffer.buffer);
+  }
+  return t_log_buffer.buffer.get();
+}
+
+void LogManager::WriterThread()
+{
+  Common::SetCurrentThreadName("Log writer");
+
+  while (m_writer_running)
+  {
+    m_writer_event.Wait();
+    m_writer_pending.store(false);
+    WriteQueuedMessages();
+  }
+}
+
+void LogManager::Flush()
+{
+  WriteQueuedMessages();
+}
+
+void LogManager::WriteQueuedMessages()
+{
+  std::lock_guard<std::mutex> write_lk(m_write_lock);
+
+  std::vector<std::shared_ptr<LogBuffer>> buffers;
+  {
+    std::lock_guard<std::mutex> lk(m_buffers_lock);
+    // Forget about threads that have exited once everything they logged has been written out.
+    m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(),
+                                   [](const std::shared_ptr<LogBuffer>& buffer) {
+                                     return buffer->IsOrphaned() && buffer->IsEmpty();
+                                   }),
+                    m_buffers.end());
+    buffers = m_buffers;
+  }
+
+  std::vector<LogBuffer::Entry> entries;
+  u64 dropped = 0;
+  for (const auto& buffer : buffers)
+  {
+    LogBuffer::Entry entry;
+    while (buffer->Pop(&entry))
+      entries.push_back(std::move(entry));
+    dropped += buffer->TakeDroppedCount();
+  }
+
+  // Interleave the messages of all threads in the order they were logged.
+  std::stable_sort(entries.begin(), entries.end(),
+                   [](const LogBuffer::Entry& a, const LogBuffer::Entry& b) {
+                     return a.timestamp < b.timestamp;
+                   });
+
+  std::lock_guard<std::mutex> lk(m_listeners_lock);
+  const auto dispatch = [this](LogTypes::LOG_LEVELS level, const std::string& msg) {
+    for (auto listener_id : m_listener_ids)
+      if (m_listeners[listener_id])
+        m_listeners[listener_id]->Log(level, msg.c_str());
+  };
+
+  for (const LogBuffer::Entry& entry : entries)
+  {
+    dispatch(entry.level,
+             StringFromFormat("%s %s:%u %c[%s]: %s\n", FormatTimestamp(entry.timestamp).c_str(),
+                              entry.file, entry.line, LogTypes::LOG_LEVEL_TO_CHAR[(int)entry.level],
+                              GetShortName(entry.type), entry.message.c_str()));
+  }
+
+  if (dropped)
+  {
+    m_dropped_messages += dropped;
+    dispatch(LogTypes::LWARNING,
+             StringFromFormat("%s %c[%s]: %llu log messages were dropped\n",
+                              FormatTimestamp(GetTimestamp()).c_str(),
+                              LogTypes::LOG_LEVEL_TO_CHAR[LogTypes::LWARNING],
+                              GetShortName(LogTypes::COMMON),
+                              static_cast<unsigned long long>(dropped)));
+  }
 }
 
 LogTypes::LOG_LEVELS LogManager::GetLogLevel() const
@@ -228,16 +372,20 @@ const char* LogManager::GetFullName(LogTypes::LOG_TYPE type) const
 
 void LogManager::RegisterListener(LogListener::LISTENER id, LogListener* listener)
 {
+  std::lock_guard<std::mutex> lk(m_listeners_lock);
   m_listeners[id] = listener;
 }
 
 void LogManager::EnableListener(LogListener::LISTENER id, bool enable)
 {
+  std::lock_guard<std::mutex> lk(m_listeners_lock);
   m_listener_ids[id] = enable;
+  m_any_listener_enabled.store(static_cast<bool>(m_listener_ids));
 }
 
 bool LogManager::IsListenerEnabled(LogListener::LISTENER id) const
 {
+  std::lock_guard<std::mutex> lk(m_listeners_lock);
   return m_listener_ids[id];
 }
 
@@ -5,9 +5,15 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstdarg>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "Common/BitSet.h"
+#include "Common/Event.h"
 #include "Common/Logging/Log.h"
 #include "Common/NonCopyable.h"
 
@@ -28,6 +34,11 @@ public:
   };
 };
 
+class LogBuffer;
+
+// Messages are queued into a ring buffer owned by the thread that logs them and passed to the
+// listeners by a background thread, so logging never blocks on formatting or I/O. Listeners are
+// only ever called from that thread (or from Flush).
 class LogManager : NonCopyable
 {
 public:
@@ -35,10 +46,17 @@ public:
   static void Init();
   static void Shutdown();
 
+  // The format string and the file name must be string literals, since they are only read when
+  // the message is written out.
   void Log(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type, const char* file, int line,
            const char* fmt, va_list args);
+  // Formats the message right away, so fmt doesn't need to outlive the call.
   void LogWithFullPath(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type, const char* file,
                        int line, const char* fmt, va_list args);
+  // Writes out every queued message. MsgAlert calls this, so the log is complete before a crash.
+  void Flush();
+  // Messages that were lost because a thread logged faster than they could be written out.
+  u64 GetDroppedMessageCount() const { return m_dropped_messages; }
 
   LogTypes::LOG_LEVELS GetLogLevel() const;
   void SetLogLevel(LogTypes::LOG_LEVELS level);
@@ -66,9 +84,32 @@ private:
   LogManager();
   ~LogManager();
 
+  void Enqueue(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type, const char* file, int line,
+               const char* fmt, va_list args, bool deferred);
+  LogBuffer* GetThreadBuffer();
+  void WriterThread();
+  void WriteQueuedMessages();
+
   LogTypes::LOG_LEVELS m_level;
   std::array<LogContainer, LogTypes::NUMBER_OF_LOGS> m_log{};
+  size_t m_path_cutoff_point = 0;
+
+  // Guards the listeners, which the writer thread calls while the GUI may change them.
+  mutable std::mutex m_listeners_lock;
   std::array<LogListener*, LogListener::NUMBER_OF_LISTENERS> m_listeners{};
   BitSet32 m_listener_ids;
-  size_t m_path_cutoff_point = 0;
+  // Lets Enqueue skip messages nobody listens to without taking the lock.
+  std::atomic<bool> m_any_listener_enabled{false};
+
+  u64 m_generation;
+  std::mutex m_buffers_lock;
+  std::vector<std::shared_ptr<LogBuffer>> m_buffers;
+
+  std::mutex m_write_lock;
+  std::thread m_writer_thread;
+  Common::Event m_writer_event;
+  // Set while the writer thread has been signaled but hasn't started draining yet.
+  std::atomic<bool> m_writer_pending{false};
+  std::atomic<bool> m_writer_running{true};
+  std::atomic<u64> m_dropped_messages{0};
 };
@@ -2,11 +2,16 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdlib>
+#include <mutex>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "Common/Assert.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -160,3 +165,121 @@ u8* MemArena::FindMemoryBase()
   return static_cast<u8*>(base);
 #endif
 }
+
+#ifdef _WIN32
+// Windows charges committed memory against the commit limit whether it's touched or not, so lazy
+// regions are only reserved, and their pages are committed by this handler on first access.
+static std::mutex s_lazy_regions_lock;
+static std::vector<std::pair<uintptr_t, size_t>> s_lazy_regions;
+static PVOID s_lazy_regions_handler = nullptr;
+
+static LONG NTAPI LazyRegionExceptionHandler(PEXCEPTION_POINTERS pointers)
+{
+  const EXCEPTION_RECORD* record = pointers->ExceptionRecord;
+  if (record->ExceptionCode != EXCEPTION_ACCESS_VIOLATION)
+    return EXCEPTION_CONTINUE_SEARCH;
+
+  const uintptr_t address = static_cast<uintptr_t>(record->ExceptionInformation[1]);
+  std::lock_guard<std::mutex> lock(s_lazy_regions_lock);
+  for (const auto& region : s_lazy_regions)
+  {
+    if (address - region.first >= region.second)
+      continue;
+
+    // Freshly committed pages are zeroed.
+    if (VirtualAlloc(reinterpret_cast<void*>(address), 1, MEM_COMMIT, PAGE_READWRITE))
+      return EXCEPTION_CONTINUE_EXECUTION;
+    break;
+  }
+  return EXCEPTION_CONTINUE_SEARCH;
+}
+#endif
+
+LazyMemoryRegion::~LazyMemoryRegion()
+{
+  Release();
+}
+
+void* LazyMemoryRegion::Create(size_t size)
+{
+  _assert_(!m_memory);
+
+#ifdef _WIN32
+  void* memory = VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+  if (!memory)
+  {
+    NOTICE_LOG(MEMMAP, "Failed to allocate lazy memory region: %s", GetLastErrorMsg().c_str());
+    return nullptr;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(s_lazy_regions_lock);
+    if (!s_lazy_regions_handler)
+      s_lazy_regions_handler = AddVectoredExceptionHandler(TRUE, LazyRegionExceptionHandler);
+    if (!s_lazy_regions_handler)
+    {
+      NOTICE_LOG(MEMMAP, "Failed to install the lazy memory region exception handler");
+      VirtualFree(memory, 0, MEM_RELEASE);
+      return nullptr;
+    }
+    s_lazy_regions.emplace_back(reinterpret_cast<uintptr_t>(memory), size);
+  }
+#else
+  int flags = MAP_ANON | MAP_PRIVATE;
+#ifdef MAP_NORESERVE
+  flags |= MAP_NORESERVE;
+#endif
+  void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+  if (memory == MAP_FAILED)
+  {
+    NOTICE_LOG(MEMMAP, "Failed to allocate lazy memory region: %s", strerror(errno));
+    return nullptr;
+  }
+#endif
+
+  m_memory = memory;
+  m_size = size;
+  return m_memory;
+}
+
+void LazyMemoryRegion::Clear()
+{
+  if (!m_memory)
+    return;
+
+#ifdef _WIN32
+  // The exception handler commits fresh zero pages again as they're accessed.
+  VirtualFree(m_memory, m_size, MEM_DECOMMIT);
+#else
+  // Mapping fresh pages over the old ones is cheaper than writing zeroes to all touched pages.
+  int flags = MAP_ANON | MAP_PRIVATE | MAP_FIXED;
+#ifdef MAP_NORESERVE
+  flags |= MAP_NORESERVE;
+#endif
+  mmap(m_memory, m_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+#endif
+}
+
+void LazyMemoryRegion::Release()
+{
+  if (!m_memory)
+    return;
+
+#ifdef _WIN32
+  {
+    std::lock_guard<std::mutex> lock(s_lazy_regions_lock);
+    s_lazy_regions.erase(std::find(s_lazy_regions.begin(), s_lazy_regions.end(),
+                                   std::make_pair(reinterpret_cast<uintptr_t>(m_memory), m_size)));
+    if (s_lazy_regions.empty())
+    {
+      RemoveVectoredExceptionHandler(s_lazy_regions_handler);
+      s_lazy_regions_handler = nullptr;
+    }
+  }
+  VirtualFree(m_memory, 0, MEM_RELEASE);
+#else
+  munmap(m_memory, m_size);
+#endif
+  m_memory = nullptr;
+  m_size = 0;
+}
@@ -35,3 +35,27 @@ private:
   int fd;
 #endif
 };
+
+// A large zero-initialized region of memory that is only backed by physical memory once its
+// pages are written to. This is meant for big, sparsely used lookup tables. On Windows, the
+// region is only reserved, and pages are committed by an exception handler when first accessed.
+class LazyMemoryRegion
+{
+public:
+  LazyMemoryRegion() = default;
+  ~LazyMemoryRegion();
+  LazyMemoryRegion(const LazyMemoryRegion&) = delete;
+  LazyMemoryRegion& operator=(const LazyMemoryRegion&) = delete;
+
+  // Returns nullptr if the address space couldn't be reserved.
+  void* Create(size_t size);
+  // Resets the whole region to zero and returns its pages to the system.
+  void Clear();
+  void Release();
+
+  void* GetPointer() const { return m_memory; }
+
+private:
+  void* m_memory = nullptr;
+  size_t m_size = 0;
+};
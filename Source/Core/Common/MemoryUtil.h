@@ -18,5 +18,7 @@ void ReadProtectMemory(void* ptr, size_t size);
 void WriteProtectMemory(void* ptr, size_t size, bool executable = false);
 void UnWriteProtectMemory(void* ptr, size_t size, bool allowExecute = false);
 size_t MemPhysical();
+// The granularity of the protection functions above.
+size_t MemPageSize();
 
 }  // namespace Common
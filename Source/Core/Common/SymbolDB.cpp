@@ -26,6 +26,7 @@ void SymbolDB::Clear(const char* prefix)
   // TODO: honor prefix
   functions.clear();
   checksumToFunction.clear();
+  m_symbols_changed.store(true, std::memory_order_release);
 }
 
 void SymbolDB::Index()
@@ -83,4 +84,5 @@ std::vector<Symbol*> SymbolDB::GetSymbolsFromHash(u32 hash)
 void SymbolDB::AddCompleteSymbol(const Symbol& symbol)
 {
   functions.emplace(symbol.address, symbol);
+  m_symbols_changed.store(true, std::memory_order_release);
 }
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <set>
 #include <string>
@@ -63,6 +64,9 @@ public:
 protected:
   XFuncMap functions;
   XFuncPtrMap checksumToFunction;
+  // Set whenever symbols may have been added, removed or resized, so that derived classes can
+  // rebuild their address lookup structures lazily.
+  std::atomic<bool> m_symbols_changed{true};
 
 public:
   SymbolDB() {}
@@ -75,9 +79,17 @@ public:
   std::vector<Symbol*> GetSymbolsFromName(const std::string& name);
   Symbol* GetSymbolFromHash(u32 hash);
   std::vector<Symbol*> GetSymbolsFromHash(u32 hash);
+  // The functions, keyed and sorted by hash.
+  const XFuncPtrMap& SymbolsByHash() const { return checksumToFunction; }
 
   const XFuncMap& Symbols() const { return functions; }
-  XFuncMap& AccessSymbols() { return functions; }
+  XFuncMap& AccessSymbols()
+  {
+    InvalidateIndex();
+    return functions;
+  }
+  // Must be called after resizing a symbol that was looked up through one of the getters.
+  void InvalidateIndex() { m_symbols_changed.store(true, std::memory_order_release); }
   void Clear(const char* prefix = "");
   void List();
   void Index();
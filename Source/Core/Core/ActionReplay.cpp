@@ -39,6 +39,7 @@
 
 #include "Core/ARDecrypt.h"
 #include "Core/ConfigManager.h"
+#include "Core/PatchEngine.h"
 #include "Core/PowerPC/PowerPC.h"
 
 namespace ActionReplay
@@ -88,6 +89,26 @@ static std::atomic<bool> s_use_internal_log{false};
 static const ARCode* s_current_code = nullptr;
 static bool s_disable_logging = false;
 
+// The active codes, with runs of unconditional RAM writes compiled into write batches. They are
+// only rebuilt when the list of active codes changes.
+struct CompiledCode
+{
+  struct Op
+  {
+    // The line that is interpreted, or the first line of the batch.
+    u32 line;
+    // Index of the write batch, or -1 if the line is interpreted.
+    s32 batch;
+  };
+
+  std::vector<Op> ops;
+  std::vector<PatchEngine::WriteBatch> batches;
+};
+static std::vector<CompiledCode> s_compiled_codes;
+static bool s_codes_changed = true;
+// Larger fills are interpreted instead of being expanded into a write batch.
+constexpr u32 MAX_BATCHED_FILL_SIZE = 0x20000;
+
 struct ARAddr
 {
   union
@@ -116,6 +137,7 @@ void ApplyCodes(const std::vector<ARCode>& codes)
 
   std::lock_guard<std::mutex> guard(s_lock);
   s_disable_logging = false;
+  s_codes_changed = true;
   s_active_codes.clear();
   std::copy_if(codes.begin(), codes.end(), std::back_inserter(s_active_codes),
                [](const ARCode& code) { return code.active; });
@@ -131,6 +153,7 @@ void AddCode(ARCode code)
   {
     std::lock_guard<std::mutex> guard(s_lock);
     s_disable_logging = false;
+    s_codes_changed = true;
     s_active_codes.emplace_back(std::move(code));
   }
 }
@@ -771,11 +794,9 @@ static bool ConditionalCode(const ARAddr& addr, const u32 data, int* const pSkip
   return true;
 }
 
-// NOTE: Lock needed to give mutual exclusion to s_current_code and LogInfo
-static bool RunCodeLocked(const ARCode& arcode)
+// State of the interpreter while it runs the lines of one code.
+struct RunState
 {
-  // The mechanism is different than what the real AR uses, so there may be compatibility problems.
-
   bool do_fill_and_slide = false;
   bool do_memory_copy = false;
 
@@ -783,149 +804,285 @@ static bool RunCodeLocked(const ARCode& arcode)
   int skip_count = 0;
 
   u32 val_last = 0;
+};
 
-  s_current_code = &arcode;
+enum class LineResult
+{
+  Continue,
+  Done,
+  Failed,
+};
 
-  LogInfo("Code Name: %s", arcode.name.c_str());
-  LogInfo("Number of codes: %zu", arcode.ops.size());
+// NOTE: Lock needed to give mutual exclusion to s_current_code and LogInfo
+static LineResult RunLineLocked(RunState* state, const AREntry& entry)
+{
+  const ARAddr addr(entry.cmd_addr);
+  const u32 data = entry.value;
 
-  for (const AREntry& entry : arcode.ops)
+  // after a conditional code, skip lines if needed
+  if (state->skip_count)
+  {
+    if (state->skip_count > 0)  // skip x lines
+    {
+      LogInfo("Line skipped");
+      --state->skip_count;
+    }
+    else if (-CONDTIONAL_ALL_LINES == state->skip_count)
+    {
+      // skip all lines
+      LogInfo("All Lines skipped");
+      return LineResult::Done;  // don't need to iterate through the rest of the ops
+    }
+    else if (-CONDTIONAL_ALL_LINES_UNTIL == state->skip_count)
+    {
+      // skip until a "00000000 40000000" line is reached
+      LogInfo("Line skipped");
+      if (addr == 0 && 0x40000000 == data)  // check for an endif line
+        state->skip_count = 0;
+    }
+
+    return LineResult::Continue;
+  }
+
+  LogInfo("--- Running Code: %08x %08x ---", addr.address, data);
+  // LogInfo("Command: %08x", cmd);
+
+  // Do Fill & Slide
+  if (state->do_fill_and_slide)
+  {
+    state->do_fill_and_slide = false;
+    LogInfo("Doing Fill And Slide");
+    if (false == ZeroCode_FillAndSlide(state->val_last, addr, data))
+      return LineResult::Failed;
+    return LineResult::Continue;
+  }
+
+  // Memory Copy
+  if (state->do_memory_copy)
+  {
+    state->do_memory_copy = false;
+    LogInfo("Doing Memory Copy");
+    if (false == ZeroCode_MemoryCopy(state->val_last, addr, data))
+      return LineResult::Failed;
+    return LineResult::Continue;
+  }
+
+  // ActionReplay program self modification codes
+  if (addr >= 0x00002000 && addr < 0x00003000)
+  {
+    LogInfo(
+        "This action replay simulator does not support codes that modify Action Replay itself.");
+    PanicAlertT(
+        "This action replay simulator does not support codes that modify Action Replay itself.");
+    return LineResult::Failed;
+  }
+
+  // skip these weird init lines
+  // TODO: Where are the "weird init lines"?
+  // if (iter == code.ops.begin() && cmd == 1)
+  // continue;
+
+  // Zero codes
+  if (0x0 == addr)  // Check if the code is a zero code
   {
-    const ARAddr addr(entry.cmd_addr);
-    const u32 data = entry.value;
+    const u8 zcode = data >> 29;
 
-    // after a conditional code, skip lines if needed
-    if (skip_count)
+    LogInfo("Doing Zero Code %08x", zcode);
+
+    switch (zcode)
     {
-      if (skip_count > 0)  // skip x lines
-      {
-        LogInfo("Line skipped");
-        --skip_count;
-      }
-      else if (-CONDTIONAL_ALL_LINES == skip_count)
+    case ZCODE_END:  // END OF CODES
+      LogInfo("ZCode: End Of Codes");
+      return LineResult::Done;
+
+    // TODO: the "00000000 40000000"(end if) codes fall into this case, I don't think that is
+    // correct
+    case ZCODE_NORM:  // Normal execution of codes
+      // Todo: Set register 1BB4 to 0
+      LogInfo("ZCode: Normal execution of codes, set register 1BB4 to 0 (zcode not supported)");
+      break;
+
+    case ZCODE_ROW:  // Executes all codes in the same row
+      // Todo: Set register 1BB4 to 1
+      LogInfo("ZCode: Executes all codes in the same row, Set register 1BB4 to 1 (zcode not "
+              "supported)");
+      PanicAlertT("Zero 3 code not supported");
+      return LineResult::Failed;
+
+    case ZCODE_04:  // Fill & Slide or Memory Copy
+      if (0x3 == ((data >> 25) & 0x03))
       {
-        // skip all lines
-        LogInfo("All Lines skipped");
-        return true;  // don't need to iterate through the rest of the ops
+        LogInfo("ZCode: Memory Copy");
+        state->do_memory_copy = true;
+        state->val_last = data;
       }
-      else if (-CONDTIONAL_ALL_LINES_UNTIL == skip_count)
+      else
       {
-        // skip until a "00000000 40000000" line is reached
-        LogInfo("Line skipped");
-        if (addr == 0 && 0x40000000 == data)  // check for an endif line
-          skip_count = 0;
+        LogInfo("ZCode: Fill And Slide");
+        state->do_fill_and_slide = true;
+        state->val_last = data;
       }
+      break;
 
-      continue;
+    default:
+      LogInfo("ZCode: Unknown");
+      PanicAlertT("Zero code unknown to Dolphin: %08x", zcode);
+      return LineResult::Failed;
     }
 
-    LogInfo("--- Running Code: %08x %08x ---", addr.address, data);
-    // LogInfo("Command: %08x", cmd);
+    // done handling zero codes
+    return LineResult::Continue;
+  }
 
-    // Do Fill & Slide
-    if (do_fill_and_slide)
-    {
-      do_fill_and_slide = false;
-      LogInfo("Doing Fill And Slide");
-      if (false == ZeroCode_FillAndSlide(val_last, addr, data))
-        return false;
-      continue;
-    }
+  // Normal codes
+  LogInfo("Doing Normal Code %08x", addr.type);
+  LogInfo("Subtype: %08x", addr.subtype);
 
-    // Memory Copy
-    if (do_memory_copy)
-    {
-      do_memory_copy = false;
-      LogInfo("Doing Memory Copy");
-      if (false == ZeroCode_MemoryCopy(val_last, addr, data))
-        return false;
-      continue;
-    }
+  switch (addr.type)
+  {
+  case 0x00:
+    if (false == NormalCode(addr, data))
+      return LineResult::Failed;
+    break;
+
+  default:
+    LogInfo("This Normal Code is a Conditional Code");
+    if (false == ConditionalCode(addr, data, &state->skip_count))
+      return LineResult::Failed;
+    break;
+  }
+  return LineResult::Continue;
+}
+
+static bool RunCodeLocked(const ARCode& arcode)
+{
+  // The mechanism is different than what the real AR uses, so there may be compatibility problems.
+  RunState state;
 
-    // ActionReplay program self modification codes
-    if (addr >= 0x00002000 && addr < 0x00003000)
+  s_current_code = &arcode;
+
+  LogInfo("Code Name: %s", arcode.name.c_str());
+  LogInfo("Number of codes: %zu", arcode.ops.size());
+
+  for (const AREntry& entry : arcode.ops)
+  {
+    switch (RunLineLocked(&state, entry))
     {
-      LogInfo(
-          "This action replay simulator does not support codes that modify Action Replay itself.");
-      PanicAlertT(
-          "This action replay simulator does not support codes that modify Action Replay itself.");
+    case LineResult::Continue:
+      break;
+    case LineResult::Done:
+      return true;
+    case LineResult::Failed:
       return false;
     }
+  }
 
-    // skip these weird init lines
-    // TODO: Where are the "weird init lines"?
-    // if (iter == code.ops.begin() && cmd == 1)
-    // continue;
+  return true;
+}
 
-    // Zero codes
-    if (0x0 == addr)  // Check if the code is a zero code
-    {
-      const u8 zcode = data >> 29;
+// Whether a line can be compiled into a write batch. These are the unconditional RAM writes and
+// fills, except for those that a one or two line conditional could skip and those that could be
+// the parameters of a zero code, so that batches never need to be partially skipped.
+static bool IsBatchableLine(const std::vector<AREntry>& ops, size_t index)
+{
+  const ARAddr addr(ops[index].cmd_addr);
+  const u32 data = ops[index].value;
+  if (addr == 0 || addr.type != 0 || addr.subtype != SUB_RAM_WRITE ||
+      (addr >= 0x00002000 && addr < 0x00003000))
+  {
+    return false;
+  }
 
-      LogInfo("Doing Zero Code %08x", zcode);
+  if (index >= 1 && (ops[index - 1].cmd_addr == 0 || ARAddr(ops[index - 1].cmd_addr).type != 0))
+    return false;
+  if (index >= 2 && ARAddr(ops[index - 2].cmd_addr).type != 0)
+    return false;
 
-      switch (zcode)
-      {
-      case ZCODE_END:  // END OF CODES
-        LogInfo("ZCode: End Of Codes");
-        return true;
+  // Huge fills are rare and would use as much memory as they write.
+  switch (addr.size)
+  {
+  case DATATYPE_8BIT:
+    return (data >> 8) < MAX_BATCHED_FILL_SIZE;
+  case DATATYPE_16BIT:
+    return (data >> 16) * 2 < MAX_BATCHED_FILL_SIZE;
+  default:
+    return true;
+  }
+}
 
-      // TODO: the "00000000 40000000"(end if) codes fall into this case, I don't think that is
-      // correct
-      case ZCODE_NORM:  // Normal execution of codes
-        // Todo: Set register 1BB4 to 0
-        LogInfo("ZCode: Normal execution of codes, set register 1BB4 to 0 (zcode not supported)");
-        break;
+// Same as Subtype_RamWriteAndFill, but adds the writes to a batch.
+static void CompileRamWriteAndFill(const ARAddr& addr, const u32 data,
+                                   PatchEngine::WriteBatch* batch)
+{
+  const u32 new_addr = addr.GCAddress();
 
-      case ZCODE_ROW:  // Executes all codes in the same row
-        // Todo: Set register 1BB4 to 1
-        LogInfo("ZCode: Executes all codes in the same row, Set register 1BB4 to 1 (zcode not "
-                "supported)");
-        PanicAlertT("Zero 3 code not supported");
-        return false;
+  switch (addr.size)
+  {
+  case DATATYPE_8BIT:
+    for (u32 i = 0; i <= data >> 8; ++i)
+      batch->AddWrite8(data & 0xFF, new_addr + i);
+    break;
 
-      case ZCODE_04:  // Fill & Slide or Memory Copy
-        if (0x3 == ((data >> 25) & 0x03))
-        {
-          LogInfo("ZCode: Memory Copy");
-          do_memory_copy = true;
-          val_last = data;
-        }
-        else
-        {
-          LogInfo("ZCode: Fill And Slide");
-          do_fill_and_slide = true;
-          val_last = data;
-        }
-        break;
+  case DATATYPE_16BIT:
+    for (u32 i = 0; i <= data >> 16; ++i)
+      batch->AddWrite16(data & 0xFFFF, new_addr + i * 2);
+    break;
 
-      default:
-        LogInfo("ZCode: Unknown");
-        PanicAlertT("Zero code unknown to Dolphin: %08x", zcode);
-        return false;
-      }
+  case DATATYPE_32BIT_FLOAT:
+  case DATATYPE_32BIT:
+    batch->AddWrite32(data, new_addr);
+    break;
+  }
+}
 
-      // done handling zero codes
+static CompiledCode CompileCode(const ARCode& arcode)
+{
+  CompiledCode compiled;
+  for (size_t i = 0; i < arcode.ops.size(); ++i)
+  {
+    if (!IsBatchableLine(arcode.ops, i))
+    {
+      compiled.ops.push_back({static_cast<u32>(i), -1});
       continue;
     }
 
-    // Normal codes
-    LogInfo("Doing Normal Code %08x", addr.type);
-    LogInfo("Subtype: %08x", addr.subtype);
-
-    switch (addr.type)
+    if (compiled.ops.empty() || compiled.ops.back().batch < 0)
     {
-    case 0x00:
-      if (false == NormalCode(addr, data))
-        return false;
-      break;
+      compiled.ops.push_back({static_cast<u32>(i), static_cast<s32>(compiled.batches.size())});
+      compiled.batches.emplace_back();
+    }
+    CompileRamWriteAndFill(arcode.ops[i].cmd_addr, arcode.ops[i].value, &compiled.batches.back());
+  }
+  return compiled;
+}
 
-    default:
-      LogInfo("This Normal Code is a Conditional Code");
-      if (false == ConditionalCode(addr, data, &skip_count))
+static bool RunCompiledCodeLocked(const ARCode& arcode, const CompiledCode& compiled)
+{
+  RunState state;
+
+  s_current_code = &arcode;
+
+  for (const CompiledCode::Op& op : compiled.ops)
+  {
+    if (op.batch < 0)
+    {
+      switch (RunLineLocked(&state, arcode.ops[op.line]))
+      {
+      case LineResult::Continue:
+        break;
+      case LineResult::Done:
+        return true;
+      case LineResult::Failed:
         return false;
-      break;
+      }
+      continue;
     }
+
+    // See IsBatchableLine: the only conditionals that can skip a batch skip it entirely.
+    if (state.skip_count == -CONDTIONAL_ALL_LINES)
+      return true;
+    if (state.skip_count == 0)
+      compiled.batches[op.batch].Apply();
   }
 
   return true;
@@ -940,14 +1097,41 @@ void RunAllActive()
   // are only atomic ops unless contested. It should be rare for this to
   // be contested.
   std::lock_guard<std::mutex> guard(s_lock);
-  s_active_codes.erase(std::remove_if(s_active_codes.begin(), s_active_codes.end(),
-                                      [](const ARCode& code) {
-                                        bool success = RunCodeLocked(code);
-                                        LogInfo("\n");
-                                        return !success;
-                                      }),
-                       s_active_codes.end());
-  s_disable_logging = true;
+
+  // The codes are interpreted the first time they run, so that every line gets logged.
+  if (!s_disable_logging)
+  {
+    const size_t count = s_active_codes.size();
+    s_active_codes.erase(std::remove_if(s_active_codes.begin(), s_active_codes.end(),
+                                        [](const ARCode& code) {
+                                          bool success = RunCodeLocked(code);
+                                          LogInfo("\n");
+                                          return !success;
+                                        }),
+                         s_active_codes.end());
+    s_codes_changed |= s_active_codes.size() != count;
+    s_disable_logging = true;
+    return;
+  }
+
+  if (s_codes_changed)
+  {
+    s_compiled_codes.clear();
+    std::transform(s_active_codes.begin(), s_active_codes.end(),
+                   std::back_inserter(s_compiled_codes), CompileCode);
+    s_codes_changed = false;
+  }
+
+  for (size_t i = 0; i < s_active_codes.size();)
+  {
+    if (RunCompiledCodeLocked(s_active_codes[i], s_compiled_codes[i]))
+    {
+      ++i;
+      continue;
+    }
+    s_active_codes.erase(s_active_codes.begin() + i);
+    s_compiled_codes.erase(s_compiled_codes.begin() + i);
+  }
 }
 
 }  // namespace ActionReplay
@@ -46,7 +46,7 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
       Config::GFX_BACKGROUND_SHADER_COMPILING.location,
       Config::GFX_DISABLE_SPECIALIZED_SHADERS.location,
       Config::GFX_PRECOMPILE_UBER_SHADERS.location, Config::GFX_SHADER_COMPILER_THREADS.location,
-      Config::GFX_SHADER_PRECOMPILER_THREADS.location,
+      Config::GFX_SHADER_PRECOMPILER_THREADS.location, Config::GFX_TEXTURE_DECODER_THREADS.location,
       Config::GFX_FORCE_VERTEX_UBER_SHADERS.location, Config::GFX_FORCE_PIXEL_UBER_SHADERS.location,
 
       Config::GFX_SW_ZCOMPLOC.location, Config::GFX_SW_ZFREEZE.location,
@@ -71,7 +71,7 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
       Config::GFX_HACK_EFB_ACCESS_ENABLE.location, Config::GFX_HACK_BBOX_ENABLE.location,
       Config::GFX_HACK_BBOX_PREFER_STENCIL_IMPLEMENTATION.location,
       Config::GFX_HACK_FORCE_PROGRESSIVE.location, Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM.location,
-      Config::GFX_HACK_SKIP_XFB_COPY_TO_RAM.location,
+      Config::GFX_HACK_SKIP_XFB_COPY_TO_RAM.location, Config::GFX_HACK_DEFER_EFB_COPIES.location,
       Config::GFX_HACK_COPY_EFB_ENABLED.location,
       Config::GFX_HACK_EFB_EMULATE_FORMAT_CHANGES.location,
       Config::GFX_HACK_VERTEX_ROUDING.location,
@@ -34,6 +34,7 @@
 #include "Core/HW/DVD/DVDInterface.h"
 #include "Core/HW/SI/SI.h"
 #include "Core/IOS/ES/Formats.h"
+#include "Core/IOS/FS/NANDIndex.h"
 #include "Core/IOS/USB/Bluetooth/BTBase.h"
 #include "Core/PatchEngine.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
@@ -242,6 +243,7 @@ void SConfig::SaveCoreSettings(IniFile& ini)
   core->Set("TimingVariance", iTimingVariance);
   core->Set("CPUCore", iCPUCore);
   core->Set("Fastmem", bFastmem);
+  core->Set("JITFullBlockMap", bJITFullBlockMap);
   core->Set("CPUThread", bCPUThread);
   core->Set("DSPHLE", bDSPHLE);
   core->Set("SyncOnSkipIdle", bSyncGPUOnSkipIdleHack);
@@ -404,6 +406,7 @@ void SConfig::SaveSettingsToSysconf()
   IOS::HLE::RestoreBTInfoSection(&sysconf);
 
   sysconf.Save();
+  IOS::HLE::NANDIndex::InvalidateAll();
 }
 
 void SConfig::LoadSettings()
@@ -563,6 +566,7 @@ void SConfig::LoadCoreSettings(IniFile& ini)
   core->Get("CPUCore", &iCPUCore, PowerPC::CORE_INTERPRETER);
 #endif
   core->Get("Fastmem", &bFastmem, true);
+  core->Get("JITFullBlockMap", &bJITFullBlockMap, true);
   core->Get("DSPHLE", &bDSPHLE, true);
   core->Get("TimingVariance", &iTimingVariance, 40);
   core->Get("CPUThread", &bCPUThread, true);
@@ -823,6 +827,7 @@ void SConfig::LoadDefaults()
   bRunCompareServer = false;
   bDSPHLE = true;
   bFastmem = true;
+  bJITFullBlockMap = true;
   bFPRF = false;
   bAccurateNaNs = false;
   bMMU = false;
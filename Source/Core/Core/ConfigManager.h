@@ -80,6 +80,7 @@ struct SConfig : NonCopyable
 
   bool bJITNoBlockCache = false;
   bool bJITNoBlockLinking = false;
+  bool bJITFullBlockMap;
   bool bJITOff = false;
   bool bJITLoadStoreOff = false;
   bool bJITLoadStorelXzOff = false;
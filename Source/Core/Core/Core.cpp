@@ -148,6 +148,10 @@ void FrameUpdateOnCPUThread()
 {
   if (NetPlay::IsNetPlayRunning())
     NetPlayClient::SendTimeBase();
+
+#ifdef USE_MEMORYWATCHER
+  MemoryWatcher::FrameUpdate();
+#endif
 }
 
 // Display messages and return values
@@ -14,6 +14,7 @@
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/FifoQueue.h"
+#include "Common/FrameTrace.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
@@ -312,6 +313,7 @@ void MoveEvents()
 
 void Advance()
 {
+  TRACE_ZONE("CoreTiming::Advance");
   MoveEvents();
 
   int cyclesExecuted = g.slice_length - DowncountToCycles(PowerPC::ppcState.downcount);
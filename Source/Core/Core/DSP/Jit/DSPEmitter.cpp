@@ -7,12 +7,15 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstring>
+#include <vector>
 
 #include "Common/Assert.h"
 #include "Common/BitSet.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/JitRegister.h"
 #include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
 
 #include "Core/DSP/DSPAnalyzer.h"
 #include "Core/DSP/DSPCore.h"
@@ -229,8 +232,17 @@ void DSPEmitter::Compile(u16 start_addr)
   bool fixup_pc = false;
   m_block_size[start_addr] = 0;
 
+  const bool register_code = JitRegister::IsEnabled();
+  std::vector<JitRegister::LineEntry> lines;
+
   while (m_compile_pc < start_addr + MAX_BLOCK_SIZE)
   {
+    if (register_code)
+    {
+      lines.push_back({GetCodePtr(), StringFromFormat("DSP_%04x", start_addr),
+                       static_cast<u32>(m_compile_pc - start_addr + 1)});
+    }
+
     if (Analyzer::GetCodeFlags(m_compile_pc) & Analyzer::CODE_CHECK_INT)
       checkExceptions(m_block_size[start_addr]);
 
@@ -376,6 +388,8 @@ void DSPEmitter::Compile(u16 start_addr)
     MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
   }
   JMP(m_return_dispatcher, true);
+
+  JitRegister::RegisterWithLines(entryPoint, GetCodePtr(), lines, "DSP_%04x", start_addr);
 }
 
 static void CompileCurrent()
@@ -406,6 +420,7 @@ const u8* DSPEmitter::CompileStub()
   ABI_CallFunction(CompileCurrent);
   XOR(32, R(EAX), R(EAX));  // Return 0 cycles executed
   JMP(m_return_dispatcher);
+  JitRegister::Register(entryPoint, GetCodePtr(), "DSP_CompileStub");
   return entryPoint;
 }
 
@@ -453,6 +468,8 @@ void DSPEmitter::CompileDispatcher()
   // MOV(32, M(&cyclesLeft), Imm32(0));
   ABI_PopRegistersAndAdjustStack(registers_used, 8);
   RET();
+
+  JitRegister::Register(m_enter_dispatcher, GetCodePtr(), "DSP_Dispatcher");
 }
 
 Gen::OpArg DSPEmitter::M_SDSP_pc()
@@ -0,0 +1,151 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/FifoPlayer/FifoBenchmark.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "Common/Timer.h"
+
+static std::string EscapeJSON(const std::string& str)
+{
+  std::string escaped;
+  for (char c : str)
+  {
+    if (c == '"' || c == '\\')
+      escaped += '\\';
+    if (static_cast<unsigned char>(c) < 0x20)
+      escaped += StringFromFormat("\\u%04x", c);
+    else
+      escaped += c;
+  }
+  return escaped;
+}
+
+template <typename T>
+static std::string SummarizeJSON(std::vector<T> values)
+{
+  if (values.empty())
+    return "{}";
+
+  std::sort(values.begin(), values.end());
+
+  // Nearest-rank percentiles, so that every reported value is one that was actually measured.
+  const auto percentile = [&values](double p) {
+    size_t rank = static_cast<size_t>(p / 100.0 * values.size() + 0.5);
+    return values[std::min(std::max<size_t>(rank, 1), values.size()) - 1];
+  };
+  const double mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+
+  return StringFromFormat("{\"min\": %" PRIu64 ", \"mean\": %.2f, \"p50\": %" PRIu64
+                          ", \"p90\": %" PRIu64 ", \"p95\": %" PRIu64 ", \"p99\": %" PRIu64
+                          ", \"max\": %" PRIu64 "}",
+                          static_cast<u64>(values.front()), mean, static_cast<u64>(percentile(50)),
+                          static_cast<u64>(percentile(90)), static_cast<u64>(percentile(95)),
+                          static_cast<u64>(percentile(99)), static_cast<u64>(values.back()));
+}
+
+void FifoBenchmark::Start()
+{
+  std::lock_guard<std::mutex> lk(m_lock);
+  m_cpu_frames.clear();
+  m_gpu_frames.clear();
+  m_last_gpu_frame_time = Common::Timer::GetTimeUs();
+  m_last_texture_uploads_total = 0;
+  m_running.Set();
+}
+
+void FifoBenchmark::Stop()
+{
+  m_running.Clear();
+}
+
+void FifoBenchmark::AddCPUFrame(u64 cpu_time_us)
+{
+  if (!m_running.IsSet())
+    return;
+
+  std::lock_guard<std::mutex> lk(m_lock);
+  m_cpu_frames.push_back(cpu_time_us);
+}
+
+void FifoBenchmark::AddGPUFrame(u32 draw_calls, u32 vertices, u32 texture_uploads_total)
+{
+  if (!m_running.IsSet())
+    return;
+
+  const u64 now = Common::Timer::GetTimeUs();
+
+  std::lock_guard<std::mutex> lk(m_lock);
+  m_gpu_frames.push_back({now - m_last_gpu_frame_time, draw_calls, vertices,
+                          texture_uploads_total - m_last_texture_uploads_total});
+  m_last_gpu_frame_time = now;
+  m_last_texture_uploads_total = texture_uploads_total;
+}
+
+std::string FifoBenchmark::GetReport(const std::string& fifolog,
+                                     const std::string& video_backend) const
+{
+  std::lock_guard<std::mutex> lk(m_lock);
+
+  // The CPU and video threads each report one entry per frame, but in dual core the last few
+  // frames submitted by the CPU thread may not have been presented yet when playback stops.
+  const size_t num_frames = std::min(m_cpu_frames.size(), m_gpu_frames.size());
+
+  std::vector<u64> cpu_times(m_cpu_frames.begin(), m_cpu_frames.begin() + num_frames);
+  std::vector<u64> gpu_frame_intervals;
+  std::vector<u32> draw_calls;
+  std::vector<u32> vertices;
+  std::vector<u32> texture_uploads;
+
+  std::string frames;
+  for (size_t i = 0; i < num_frames; ++i)
+  {
+    const GPUFrame& frame = m_gpu_frames[i];
+    gpu_frame_intervals.push_back(frame.gpu_frame_interval_us);
+    draw_calls.push_back(frame.draw_calls);
+    vertices.push_back(frame.vertices);
+    texture_uploads.push_back(frame.texture_uploads);
+
+    frames += StringFromFormat("    {\"cpu_time_us\": %" PRIu64
+                               ", \"gpu_frame_interval_us\": %" PRIu64
+                               ", \"draw_calls\": %u, \"vertices\": %u, \"texture_uploads\": %u}%s\n",
+                               m_cpu_frames[i], frame.gpu_frame_interval_us, frame.draw_calls,
+                               frame.vertices, frame.texture_uploads,
+                               i + 1 < num_frames ? "," : "");
+  }
+
+  std::string report = "{\n";
+  report += "  \"fifolog\": \"" + EscapeJSON(fifolog) + "\",\n";
+  report += "  \"video_backend\": \"" + EscapeJSON(video_backend) + "\",\n";
+  report += StringFromFormat("  \"frame_count\": %zu,\n", num_frames);
+  report += "  \"summary\": {\n";
+  report += "    \"cpu_time_us\": " + SummarizeJSON(cpu_times) + ",\n";
+  report += "    \"gpu_frame_interval_us\": " + SummarizeJSON(gpu_frame_intervals) + ",\n";
+  report += "    \"draw_calls\": " + SummarizeJSON(draw_calls) + ",\n";
+  report += "    \"vertices\": " + SummarizeJSON(vertices) + ",\n";
+  report += "    \"texture_uploads\": " + SummarizeJSON(texture_uploads) + "\n";
+  report += "  },\n";
+  report += "  \"frames\": [\n" + frames + "  ]\n";
+  report += "}\n";
+  return report;
+}
+
+bool FifoBenchmark::WriteReport(const std::string& path, const std::string& fifolog,
+                                const std::string& video_backend) const
+{
+  return File::WriteStringToFile(GetReport(fifolog, video_backend), path);
+}
+
+FifoBenchmark& FifoBenchmark::GetInstance()
+{
+  static FifoBenchmark instance;
+  return instance;
+}
@@ -0,0 +1,56 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Flag.h"
+
+// Collects per-frame timings and video statistics while the FifoPlayer replays a fifolog, so
+// that video performance can be compared between builds without a human watching the FPS.
+class FifoBenchmark
+{
+public:
+  struct GPUFrame
+  {
+    // Wall time since the previous frame was presented, including any time the video thread
+    // spent idle or waiting for the CPU thread.
+    u64 gpu_frame_interval_us;
+    u32 draw_calls;
+    u32 vertices;
+    u32 texture_uploads;
+  };
+
+  void Start();
+  void Stop();
+  bool IsRunning() const { return m_running.IsSet(); }
+
+  // Called from the CPU thread with the time it took to submit a frame's FIFO data.
+  void AddCPUFrame(u64 cpu_time_us);
+  // Called from the video thread at the end of each frame. texture_uploads_total is the
+  // running total of uploaded textures, since the renderer only keeps a running total.
+  void AddGPUFrame(u32 draw_calls, u32 vertices, u32 texture_uploads_total);
+
+  // Writes every frame plus min/mean/percentile summaries as JSON.
+  bool WriteReport(const std::string& path, const std::string& fifolog,
+                   const std::string& video_backend) const;
+  std::string GetReport(const std::string& fifolog, const std::string& video_backend) const;
+
+  static FifoBenchmark& GetInstance();
+
+private:
+  FifoBenchmark() = default;
+
+  Common::Flag m_running;
+
+  mutable std::mutex m_lock;
+  std::vector<u64> m_cpu_frames;
+  std::vector<GPUFrame> m_gpu_frames;
+  u64 m_last_gpu_frame_time = 0;
+  u32 m_last_texture_uploads_total = 0;
+};
@@ -5,18 +5,28 @@
 #include "Core/FifoPlayer/FifoDataFile.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstdio>
 #include <cstring>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include <zlib.h>
+
+#include "Common/Assert.h"
 #include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
 
 enum
 {
   FILE_ID = 0x0d01f1f0,
-  VERSION_NUMBER = 4,
-  MIN_LOADER_VERSION = 1,
+  VERSION_NUMBER = 5,
+  MIN_LOADER_VERSION = 5,
+  // Frames of version 5 files and up are individually zlib-compressed.
+  FIRST_COMPRESSED_VERSION = 5,
 };
 
 #pragma pack(push, 1)
@@ -43,6 +53,9 @@ struct FileHeader
 };
 static_assert(sizeof(FileHeader) == 128, "FileHeader should be 128 bytes");
 
+// For compressed frames, fifoDataOffset points to the compressed frame, which decompresses to the
+// FIFO data followed by the memory update list and the memory update data. memoryUpdatesOffset
+// and the memory update data offsets are then relative to the start of the decompressed frame.
 struct FileFrameInfo
 {
   u64 fifoDataOffset;
@@ -51,7 +64,9 @@ struct FileFrameInfo
   u32 fifoEnd;
   u64 memoryUpdatesOffset;
   u32 numMemoryUpdates;
-  u8 reserved[32];
+  u32 compressedSize;    // Version 5
+  u32 uncompressedSize;  // Version 5
+  u8 reserved[24];
 };
 static_assert(sizeof(FileFrameInfo) == 64, "FileFrameInfo should be 64 bytes");
 
@@ -70,7 +85,14 @@ static_assert(sizeof(FileMemoryUpdate) == 24, "FileMemoryUpdate should be 24 byt
 
 FifoDataFile::FifoDataFile() = default;
 
-FifoDataFile::~FifoDataFile() = default;
+FifoDataFile::~FifoDataFile()
+{
+  if (!m_SpoolFilename.empty())
+  {
+    m_File.Close();
+    File::Delete(m_SpoolFilename);
+  }
+}
 
 bool FifoDataFile::ShouldGenerateFakeVIUpdates() const
 {
@@ -92,98 +114,212 @@ bool FifoDataFile::GetIsWii() const
   return GetFlag(FLAG_IS_WII);
 }
 
-void FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
+bool FifoDataFile::IsCompressed() const
 {
-  m_Frames.push_back(frameInfo);
+  return m_Version >= FIRST_COMPRESSED_VERSION;
 }
 
-bool FifoDataFile::Save(const std::string& filename)
+u32 FifoDataFile::GetFrameCount() const
 {
-  File::IOFile file;
-  if (!file.Open(filename, "wb"))
-    return false;
-
-  // Add space for header
-  PadFile(sizeof(FileHeader), file);
+  return static_cast<u32>(m_FrameIndex.size());
+}
 
-  // Add space for frame list
-  u64 frameListOffset = file.Tell();
-  PadFile(m_Frames.size() * sizeof(FileFrameInfo), file);
+u64 FifoDataFile::GetTotalFifoDataSize() const
+{
+  u64 total = 0;
+  for (const FileFrameInfo& frame : m_FrameIndex)
+    total += frame.fifoDataSize;
+  return total;
+}
 
-  u64 bpMemOffset = file.Tell();
-  file.WriteArray(m_BPMem, BP_MEM_SIZE);
+u64 FifoDataFile::GetTotalMemoryUpdateSize() const
+{
+  u64 total = 0;
+  for (u32 i = 0; i < m_FrameIndex.size(); ++i)
+  {
+    const FileFrameInfo& frame = m_FrameIndex[i];
+    if (IsCompressed())
+    {
+      total += frame.uncompressedSize - frame.fifoDataSize -
+               frame.numMemoryUpdates * sizeof(FileMemoryUpdate);
+    }
+    else
+    {
+      for (const MemoryUpdate& update : GetFrame(i)->memoryUpdates)
+        total += update.data.size();
+    }
+  }
+  return total;
+}
 
-  u64 cpMemOffset = file.Tell();
-  file.WriteArray(m_CPMem, CP_MEM_SIZE);
+bool FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
+{
+  FileFrameInfo dstFrame;
+  std::vector<u8> compressed;
+  if (!CompressFrame(frameInfo, dstFrame, compressed))
+  {
+    ERROR_LOG(VIDEO, "Failed to compress FIFO frame %zu", m_FrameIndex.size());
+    return false;
+  }
 
-  u64 xfMemOffset = file.Tell();
-  file.WriteArray(m_XFMem, XF_MEM_SIZE);
+  std::lock_guard<std::mutex> lk(m_FileLock);
 
-  u64 xfRegsOffset = file.Tell();
-  file.WriteArray(m_XFRegs, XF_REGS_SIZE);
+  // Frames can only be added to a new file, whose frames are spooled to a temporary file until
+  // the recording is saved.
+  if (m_SpoolFilename.empty())
+  {
+    static std::atomic<u32> s_spool_count{0};
+    const std::string cache_dir = File::GetUserPath(D_CACHE_IDX);
+    File::CreateFullPath(cache_dir);
+    m_SpoolFilename =
+        StringFromFormat("%sFifoRecording%u.tmp", cache_dir.c_str(), s_spool_count++);
+    m_File.Open(m_SpoolFilename, "w+b");
+    m_Version = VERSION_NUMBER;
+  }
 
-  u64 texMemOffset = file.Tell();
-  file.WriteArray(m_TexMem, TEX_MEM_SIZE);
+  if (!m_File)
+  {
+    ERROR_LOG(VIDEO, "Failed to create FIFO recording file %s", m_SpoolFilename.c_str());
+    return false;
+  }
 
-  // Write header
-  FileHeader header;
-  header.fileId = FILE_ID;
-  header.file_version = VERSION_NUMBER;
-  header.min_loader_version = MIN_LOADER_VERSION;
+  _assert_msg_(VIDEO, IsCompressed(), "Frames cannot be added to a loaded fifolog");
 
-  header.bpMemOffset = bpMemOffset;
-  header.bpMemSize = BP_MEM_SIZE;
+  m_File.Seek(0, SEEK_END);
+  dstFrame.fifoDataOffset = m_File.Tell();
+  if (!m_File.WriteBytes(compressed.data(), compressed.size()))
+  {
+    ERROR_LOG(VIDEO, "Failed to write FIFO frame %zu", m_FrameIndex.size());
+    return false;
+  }
 
-  header.cpMemOffset = cpMemOffset;
-  header.cpMemSize = CP_MEM_SIZE;
+  m_FrameIndex.push_back(dstFrame);
+  return true;
+}
 
-  header.xfMemOffset = xfMemOffset;
-  header.xfMemSize = XF_MEM_SIZE;
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::GetFrame(u32 frame) const
+{
+  std::lock_guard<std::mutex> lk(m_FileLock);
 
-  header.xfRegsOffset = xfRegsOffset;
-  header.xfRegsSize = XF_REGS_SIZE;
+  // Playback and the analyzers walk frames in order, so remembering the last frame is enough to
+  // avoid reading a frame more than once in a row.
+  if (m_CachedFrame && m_CachedFrameNum == frame)
+    return m_CachedFrame;
 
-  header.texMemOffset = texMemOffset;
-  header.texMemSize = TEX_MEM_SIZE;
+  auto dstFrame = std::make_shared<FifoFrameInfo>();
+  const FileFrameInfo& srcFrame = m_FrameIndex[frame];
+  dstFrame->fifoStart = srcFrame.fifoStart;
+  dstFrame->fifoEnd = srcFrame.fifoEnd;
 
-  header.frameListOffset = frameListOffset;
-  header.frameCount = (u32)m_Frames.size();
+  bool success = IsCompressed() ? ReadCompressedFrame(srcFrame, *dstFrame) :
+                                  ReadUncompressedFrame(srcFrame, *dstFrame);
+  if (!success)
+  {
+    ERROR_LOG(VIDEO, "Failed to read FIFO frame %u", frame);
+    dstFrame->fifoData.clear();
+    dstFrame->memoryUpdates.clear();
+  }
 
-  header.flags = m_Flags;
+  m_CachedFrame = std::move(dstFrame);
+  m_CachedFrameNum = frame;
+  return m_CachedFrame;
+}
 
-  file.Seek(0, SEEK_SET);
-  file.WriteBytes(&header, sizeof(FileHeader));
+bool FifoDataFile::Save(const std::string& filename)
+{
+  // Write to a temporary file first, as the frames may be read from the file being replaced.
+  const std::string temp_filename = File::GetTempFilenameForAtomicWrite(filename);
 
-  // Write frames list
-  for (unsigned int i = 0; i < m_Frames.size(); ++i)
   {
-    const FifoFrameInfo& srcFrame = m_Frames[i];
-
-    // Write FIFO data
-    file.Seek(0, SEEK_END);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
-
-    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
-
-    FileFrameInfo dstFrame;
-    dstFrame.fifoDataSize = static_cast<u32>(srcFrame.fifoData.size());
-    dstFrame.fifoDataOffset = dataOffset;
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
-    dstFrame.memoryUpdatesOffset = memoryUpdatesOffset;
-    dstFrame.numMemoryUpdates = static_cast<u32>(srcFrame.memoryUpdates.size());
-
-    // Write frame info
-    u64 frameOffset = frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, SEEK_SET);
-    file.WriteBytes(&dstFrame, sizeof(FileFrameInfo));
+    File::IOFile file;
+    if (!file.Open(temp_filename, "wb"))
+      return false;
+
+    // Add space for header
+    PadFile(sizeof(FileHeader), file);
+
+    u64 bpMemOffset = file.Tell();
+    file.WriteArray(m_BPMem, BP_MEM_SIZE);
+
+    u64 cpMemOffset = file.Tell();
+    file.WriteArray(m_CPMem, CP_MEM_SIZE);
+
+    u64 xfMemOffset = file.Tell();
+    file.WriteArray(m_XFMem, XF_MEM_SIZE);
+
+    u64 xfRegsOffset = file.Tell();
+    file.WriteArray(m_XFRegs, XF_REGS_SIZE);
+
+    u64 texMemOffset = file.Tell();
+    file.WriteArray(m_TexMem, TEX_MEM_SIZE);
+
+    // Write frames. Compressed frames are copied over as they are; frames from older files are
+    // compressed on the way.
+    std::vector<FileFrameInfo> frameList(m_FrameIndex.size());
+    std::vector<u8> compressed;
+    for (u32 i = 0; i < m_FrameIndex.size(); ++i)
+    {
+      FileFrameInfo& dstFrame = frameList[i];
+
+      if (IsCompressed())
+      {
+        std::lock_guard<std::mutex> lk(m_FileLock);
+        dstFrame = m_FrameIndex[i];
+        compressed.resize(dstFrame.compressedSize);
+        if (!m_File.Seek(dstFrame.fifoDataOffset, SEEK_SET) ||
+            !m_File.ReadBytes(compressed.data(), compressed.size()))
+        {
+          return false;
+        }
+      }
+      else if (!CompressFrame(*GetFrame(i), dstFrame, compressed))
+      {
+        return false;
+      }
+
+      dstFrame.fifoDataOffset = file.Tell();
+      if (!file.WriteBytes(compressed.data(), compressed.size()))
+        return false;
+    }
+
+    // The frame list goes after the frames, so that recordings can be written in a single pass.
+    u64 frameListOffset = file.Tell();
+    file.WriteArray(frameList.data(), frameList.size());
+
+    // Write header
+    FileHeader header = {};
+    header.fileId = FILE_ID;
+    header.file_version = VERSION_NUMBER;
+    header.min_loader_version = MIN_LOADER_VERSION;
+
+    header.bpMemOffset = bpMemOffset;
+    header.bpMemSize = BP_MEM_SIZE;
+
+    header.cpMemOffset = cpMemOffset;
+    header.cpMemSize = CP_MEM_SIZE;
+
+    header.xfMemOffset = xfMemOffset;
+    header.xfMemSize = XF_MEM_SIZE;
+
+    header.xfRegsOffset = xfRegsOffset;
+    header.xfRegsSize = XF_REGS_SIZE;
+
+    header.texMemOffset = texMemOffset;
+    header.texMemSize = TEX_MEM_SIZE;
+
+    header.frameListOffset = frameListOffset;
+    header.frameCount = static_cast<u32>(frameList.size());
+
+    header.flags = m_Flags;
+
+    file.Seek(0, SEEK_SET);
+    file.WriteBytes(&header, sizeof(FileHeader));
+
+    if (!file.Close())
+      return false;
   }
 
-  if (!file.Close())
-    return false;
-
-  return true;
+  return File::RenameSync(temp_filename, filename);
 }
 
 std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bool flagsOnly)
@@ -238,29 +374,13 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
     file.ReadArray(dataFile->m_TexMem, size);
   }
 
-  // Read frames
-  for (u32 i = 0; i < header.frameCount; ++i)
-  {
-    u64 frameOffset = header.frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, SEEK_SET);
-    FileFrameInfo srcFrame;
-    file.ReadBytes(&srcFrame, sizeof(FileFrameInfo));
-
-    FifoFrameInfo dstFrame;
-    dstFrame.fifoData.resize(srcFrame.fifoDataSize);
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
-
-    file.Seek(srcFrame.fifoDataOffset, SEEK_SET);
-    file.ReadBytes(dstFrame.fifoData.data(), srcFrame.fifoDataSize);
-
-    ReadMemoryUpdates(srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
-                      dstFrame.memoryUpdates, file);
-
-    dataFile->AddFrame(dstFrame);
-  }
+  // Only read the frame list; the frames themselves are read when they're needed.
+  dataFile->m_FrameIndex.resize(header.frameCount);
+  file.Seek(header.frameListOffset, SEEK_SET);
+  if (!file.ReadArray(dataFile->m_FrameIndex.data(), dataFile->m_FrameIndex.size()))
+    return nullptr;
 
-  file.Close();
+  dataFile->m_File = std::move(file);
 
   return dataFile;
 }
@@ -284,38 +404,119 @@ bool FifoDataFile::GetFlag(u32 flag) const
   return !!(m_Flags & flag);
 }
 
-u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates,
-                                     File::IOFile& file)
+bool FifoDataFile::CompressFrame(const FifoFrameInfo& srcFrame, FileFrameInfo& dstFrame,
+                                 std::vector<u8>& compressed)
 {
-  // Add space for memory update list
-  u64 updateListOffset = file.Tell();
-  PadFile(memUpdates.size() * sizeof(FileMemoryUpdate), file);
-
-  for (unsigned int i = 0; i < memUpdates.size(); ++i)
+  const size_t fifoDataSize = srcFrame.fifoData.size();
+  const size_t updateListSize = srcFrame.memoryUpdates.size() * sizeof(FileMemoryUpdate);
+  size_t uncompressedSize = fifoDataSize + updateListSize;
+  for (const MemoryUpdate& update : srcFrame.memoryUpdates)
+    uncompressedSize += update.data.size();
+
+  // Lay out the frame as FIFO data, memory update list, memory update data.
+  std::vector<u8> uncompressed(uncompressedSize);
+  std::copy(srcFrame.fifoData.begin(), srcFrame.fifoData.end(), uncompressed.begin());
+
+  size_t dataOffset = fifoDataSize + updateListSize;
+  for (size_t i = 0; i < srcFrame.memoryUpdates.size(); ++i)
   {
-    const MemoryUpdate& srcUpdate = memUpdates[i];
-
-    // Write memory
-    file.Seek(0, SEEK_END);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcUpdate.data.data(), srcUpdate.data.size());
+    const MemoryUpdate& srcUpdate = srcFrame.memoryUpdates[i];
 
-    FileMemoryUpdate dstUpdate;
+    FileMemoryUpdate dstUpdate = {};
     dstUpdate.address = srcUpdate.address;
     dstUpdate.dataOffset = dataOffset;
     dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
     dstUpdate.fifoPosition = srcUpdate.fifoPosition;
     dstUpdate.type = srcUpdate.type;
+    std::memcpy(&uncompressed[fifoDataSize + i * sizeof(FileMemoryUpdate)], &dstUpdate,
+                sizeof(FileMemoryUpdate));
 
-    u64 updateOffset = updateListOffset + (i * sizeof(FileMemoryUpdate));
-    file.Seek(updateOffset, SEEK_SET);
-    file.WriteBytes(&dstUpdate, sizeof(FileMemoryUpdate));
+    std::copy(srcUpdate.data.begin(), srcUpdate.data.end(), uncompressed.begin() + dataOffset);
+    dataOffset += srcUpdate.data.size();
   }
 
-  return updateListOffset;
+  // Frames are compressed on the video thread while recording, so favour speed over ratio.
+  uLongf compressedSize = compressBound(static_cast<uLong>(uncompressedSize));
+  compressed.resize(compressedSize);
+  if (compress2(compressed.data(), &compressedSize, uncompressed.data(),
+                static_cast<uLong>(uncompressedSize), Z_BEST_SPEED) != Z_OK)
+  {
+    return false;
+  }
+  compressed.resize(compressedSize);
+
+  dstFrame = {};
+  dstFrame.fifoDataSize = static_cast<u32>(fifoDataSize);
+  dstFrame.fifoStart = srcFrame.fifoStart;
+  dstFrame.fifoEnd = srcFrame.fifoEnd;
+  dstFrame.memoryUpdatesOffset = fifoDataSize;
+  dstFrame.numMemoryUpdates = static_cast<u32>(srcFrame.memoryUpdates.size());
+  dstFrame.compressedSize = static_cast<u32>(compressedSize);
+  dstFrame.uncompressedSize = static_cast<u32>(uncompressedSize);
+  return true;
 }
 
-void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
+bool FifoDataFile::ReadCompressedFrame(const FileFrameInfo& srcFrame, FifoFrameInfo& dstFrame) const
+{
+  std::vector<u8> compressed(srcFrame.compressedSize);
+  if (!m_File.Seek(srcFrame.fifoDataOffset, SEEK_SET) ||
+      !m_File.ReadBytes(compressed.data(), compressed.size()))
+  {
+    return false;
+  }
+
+  std::vector<u8> uncompressed(srcFrame.uncompressedSize);
+  uLongf uncompressedSize = static_cast<uLongf>(uncompressed.size());
+  if (uncompress(uncompressed.data(), &uncompressedSize, compressed.data(),
+                 static_cast<uLong>(compressed.size())) != Z_OK ||
+      uncompressedSize != uncompressed.size())
+  {
+    return false;
+  }
+
+  const u64 updateListEnd =
+      srcFrame.memoryUpdatesOffset + u64{srcFrame.numMemoryUpdates} * sizeof(FileMemoryUpdate);
+  if (srcFrame.fifoDataSize > uncompressed.size() || updateListEnd > uncompressed.size())
+    return false;
+
+  dstFrame.fifoData.assign(uncompressed.begin(), uncompressed.begin() + srcFrame.fifoDataSize);
+
+  dstFrame.memoryUpdates.resize(srcFrame.numMemoryUpdates);
+  for (u32 i = 0; i < srcFrame.numMemoryUpdates; ++i)
+  {
+    FileMemoryUpdate srcUpdate;
+    std::memcpy(&srcUpdate,
+                &uncompressed[srcFrame.memoryUpdatesOffset + i * sizeof(FileMemoryUpdate)],
+                sizeof(FileMemoryUpdate));
+    if (srcUpdate.dataOffset + srcUpdate.dataSize > uncompressed.size())
+      return false;
+
+    MemoryUpdate& dstUpdate = dstFrame.memoryUpdates[i];
+    dstUpdate.address = srcUpdate.address;
+    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
+    dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
+    dstUpdate.data.assign(uncompressed.begin() + srcUpdate.dataOffset,
+                          uncompressed.begin() + srcUpdate.dataOffset + srcUpdate.dataSize);
+  }
+
+  return true;
+}
+
+bool FifoDataFile::ReadUncompressedFrame(const FileFrameInfo& srcFrame,
+                                         FifoFrameInfo& dstFrame) const
+{
+  dstFrame.fifoData.resize(srcFrame.fifoDataSize);
+  if (!m_File.Seek(srcFrame.fifoDataOffset, SEEK_SET) ||
+      !m_File.ReadBytes(dstFrame.fifoData.data(), srcFrame.fifoDataSize))
+  {
+    return false;
+  }
+
+  return ReadMemoryUpdates(srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
+                           dstFrame.memoryUpdates, m_File);
+}
+
+bool FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
                                      std::vector<MemoryUpdate>& memUpdates, File::IOFile& file)
 {
   memUpdates.resize(numUpdates);
@@ -325,7 +526,8 @@ void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
     u64 updateOffset = fileOffset + (i * sizeof(FileMemoryUpdate));
     file.Seek(updateOffset, SEEK_SET);
     FileMemoryUpdate srcUpdate;
-    file.ReadBytes(&srcUpdate, sizeof(FileMemoryUpdate));
+    if (!file.ReadBytes(&srcUpdate, sizeof(FileMemoryUpdate)))
+      return false;
 
     MemoryUpdate& dstUpdate = memUpdates[i];
     dstUpdate.address = srcUpdate.address;
@@ -334,6 +536,9 @@ void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
     dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
 
     file.Seek(srcUpdate.dataOffset, SEEK_SET);
-    file.ReadBytes(dstUpdate.data.data(), srcUpdate.dataSize);
+    if (!file.ReadBytes(dstUpdate.data.data(), srcUpdate.dataSize))
+      return false;
   }
+
+  return true;
 }
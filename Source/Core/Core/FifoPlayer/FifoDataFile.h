@@ -5,15 +5,14 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/File.h"
 
-namespace File
-{
-class IOFile;
-}
+struct FileFrameInfo;
 
 struct MemoryUpdate
 {
@@ -67,9 +66,19 @@ public:
   u32* GetXFMem() { return m_XFMem; }
   u32* GetXFRegs() { return m_XFRegs; }
   u8* GetTexMem() { return m_TexMem; }
-  void AddFrame(const FifoFrameInfo& frameInfo);
-  const FifoFrameInfo& GetFrame(u32 frame) const { return m_Frames[frame]; }
-  u32 GetFrameCount() const { return static_cast<u32>(m_Frames.size()); }
+
+  // Frames are compressed and appended to a temporary file in the cache directory as they are
+  // added, so a recording never needs to hold more than the current frame in memory. Returns
+  // false if the frame couldn't be written out.
+  bool AddFrame(const FifoFrameInfo& frameInfo);
+
+  // Frames are read from disk on demand. The returned frame stays valid for as long as the
+  // caller holds a reference to it, even if other frames are read in the meantime.
+  std::shared_ptr<const FifoFrameInfo> GetFrame(u32 frame) const;
+  u32 GetFrameCount() const;
+  // Totals over all frames, taken from the frame list where possible.
+  u64 GetTotalFifoDataSize() const;
+  u64 GetTotalMemoryUpdateSize() const;
   bool Save(const std::string& filename);
 
   static std::unique_ptr<FifoDataFile> Load(const std::string& filename, bool flagsOnly);
@@ -85,8 +94,13 @@ private:
   void SetFlag(u32 flag, bool set);
   bool GetFlag(u32 flag) const;
 
-  u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
-  static void ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
+  bool IsCompressed() const;
+  bool ReadCompressedFrame(const FileFrameInfo& srcFrame, FifoFrameInfo& dstFrame) const;
+  bool ReadUncompressedFrame(const FileFrameInfo& srcFrame, FifoFrameInfo& dstFrame) const;
+  static bool CompressFrame(const FifoFrameInfo& srcFrame, FileFrameInfo& dstFrame,
+                            std::vector<u8>& compressed);
+
+  static bool ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
                                 std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
 
   u32 m_BPMem[BP_MEM_SIZE];
@@ -98,5 +112,15 @@ private:
   u32 m_Flags = 0;
   u32 m_Version = 0;
 
-  std::vector<FifoFrameInfo> m_Frames;
+  // The file frames are read from; either the loaded fifolog or the temporary file a recording
+  // is written to. Guarded by m_FileLock, as the GUI may read frames while the video thread
+  // records or plays them back.
+  mutable std::mutex m_FileLock;
+  mutable File::IOFile m_File;
+  // The temporary file of a recording, which is deleted along with this object.
+  std::string m_SpoolFilename;
+  std::vector<FileFrameInfo> m_FrameIndex;
+
+  mutable std::shared_ptr<const FifoFrameInfo> m_CachedFrame;
+  mutable u32 m_CachedFrameNum = 0;
 };
@@ -40,13 +40,13 @@ void FifoPlaybackAnalyzer::AnalyzeFrames(FifoDataFile* file,
 
   for (u32 frameIdx = 0; frameIdx < file->GetFrameCount(); ++frameIdx)
   {
-    const FifoFrameInfo& frame = file->GetFrame(frameIdx);
+    const auto frame_ptr = file->GetFrame(frameIdx);
+    const FifoFrameInfo& frame = *frame_ptr;
     AnalyzedFrameInfo& analyzed = frameInfo[frameIdx];
 
     s_DrawingObject = false;
 
     u32 cmdStart = 0;
-    u32 nextMemUpdate = 0;
 
 #if LOG_FIFO_CMDS
     // Debugging
@@ -55,14 +55,6 @@ void FifoPlaybackAnalyzer::AnalyzeFrames(FifoDataFile* file,
 
     while (cmdStart < frame.fifoData.size())
     {
-      // Add memory updates that have occurred before this point in the frame
-      while (nextMemUpdate < frame.memoryUpdates.size() &&
-             frame.memoryUpdates[nextMemUpdate].fifoPosition <= cmdStart)
-      {
-        analyzed.memoryUpdates.push_back(frame.memoryUpdates[nextMemUpdate]);
-        ++nextMemUpdate;
-      }
-
       bool wasDrawing = s_DrawingObject;
 
       u32 cmdSize = FifoAnalyzer::AnalyzeCommand(&frame.fifoData[cmdStart], DECODE_PLAYBACK);
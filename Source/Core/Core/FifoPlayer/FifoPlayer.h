@@ -86,6 +86,9 @@ public:
   void SetObjectRangeStart(u32 start) { m_ObjectRangeStart = start; }
   u32 GetObjectRangeEnd() const { return m_ObjectRangeEnd; }
   void SetObjectRangeEnd(u32 end) { m_ObjectRangeEnd = end; }
+  // Stops playback once the frame range has been played back this many times.
+  // Zero (the default) loops according to the "loop FIFO replay" setting instead.
+  void SetPlaybackCount(u32 count) { m_PlaybackCount = count; }
   // If enabled then all memory updates happen at once before the first frame
   // Default is disabled
   void SetEarlyMemoryUpdates(bool enabled) { m_EarlyMemoryUpdates = enabled; }
@@ -136,6 +139,8 @@ private:
   static bool IsHighWatermarkSet();
 
   bool m_Loop;
+  u32 m_PlaybackCount = 0;
+  u32 m_PlaybacksCompleted = 0;
 
   u32 m_CurrentFrame = 0;
   u32 m_FrameRangeStart = 0;
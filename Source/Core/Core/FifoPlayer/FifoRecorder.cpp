@@ -8,6 +8,7 @@
 #include <cstring>
 #include <mutex>
 
+#include "Common/FileUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/Thread.h"
 #include "Core/ConfigManager.h"
@@ -92,14 +93,19 @@ void FifoRecorder::WriteGPCommand(const u8* data, u32 size)
 
   if (m_FrameEnded && m_FifoData.size() > 0)
   {
-    m_CurrentFrame.fifoData = m_FifoData;
+    m_CurrentFrame.fifoData.swap(m_FifoData);
 
     {
       std::lock_guard<std::recursive_mutex> lk(sMutex);
 
-      // Copy frame to file
-      // The file will be responsible for freeing the memory allocated for each frame's fifoData
-      m_File->AddFrame(m_CurrentFrame);
+      // The file compresses the frame and writes it out straight away, so only the frame
+      // currently being recorded is ever held in memory.
+      if (!m_File->AddFrame(m_CurrentFrame) && !m_RequestedRecordingEnd)
+      {
+        PanicAlertT("Could not write the FIFO log to %s. Recording has been stopped.",
+                    File::GetUserPath(D_CACHE_IDX).c_str());
+        m_RequestedRecordingEnd = true;
+      }
 
       if (m_FinishedCb && m_RequestedRecordingEnd)
         m_FinishedCb();
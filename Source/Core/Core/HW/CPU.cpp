@@ -10,6 +10,7 @@
 #include "AudioCommon/AudioCommon.h"
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
+#include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/Host.h"
 #include "Core/PowerPC/PowerPC.h"
@@ -101,6 +102,11 @@ void Run()
       // Enter a fast runloop
       PowerPC::RunLoop();
 
+      // In single core mode this is also the GPU thread, so write out what the GPU deferred
+      // before anything reads RAM while the CPU is stopped.
+      if (!SConfig::GetInstance().bCPUThread)
+        Fifo::FlushDeferredGPUWork();
+
       state_lock.lock();
       s_state_cpu_thread_active = false;
       s_state_cpu_idle_cvar.notify_all();
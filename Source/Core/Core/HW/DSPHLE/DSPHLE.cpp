@@ -6,6 +6,7 @@
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/FrameTrace.h"
 #include "Common/MsgHandler.h"
 #include "Core/Core.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
@@ -47,6 +48,7 @@ void DSPHLE::Shutdown()
 
 void DSPHLE::DSP_Update(int cycles)
 {
+  TRACE_ZONE("DSP HLE");
   if (m_ucode != nullptr)
     m_ucode->Update();
 }
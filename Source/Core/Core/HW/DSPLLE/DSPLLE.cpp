@@ -12,6 +12,7 @@
 #include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
+#include "Common/FrameTrace.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemoryUtil.h"
 #include "Common/Thread.h"
@@ -96,6 +97,7 @@ void DSPLLE::DSPThread(DSPLLE* dsp_lle)
     const int cycles = static_cast<int>(dsp_lle->m_cycle_count.load());
     if (cycles > 0)
     {
+      TRACE_ZONE("DSP LLE");
       std::lock_guard<std::mutex> dsp_thread_lock(dsp_lle->m_dsp_thread_mutex);
       if (g_dsp_jit)
       {
@@ -312,6 +314,7 @@ void DSPLLE::DSP_Update(int cycles)
   // If we're not on a thread, run cycles here.
   if (!m_is_dsp_on_thread)
   {
+    TRACE_ZONE("DSP LLE");
     // ~1/6th as many cycles as the period PPC-side.
     DSPCore_RunCycles(dsp_cycles);
   }
@@ -18,6 +18,7 @@
 #include "Common/Event.h"
 #include "Common/FifoQueue.h"
 #include "Common/Flag.h"
+#include "Common/FrameTrace.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/Thread.h"
@@ -356,6 +357,7 @@ static void DVDThread()
     ReadRequest request;
     while (s_request_queue.Pop(request))
     {
+      TRACE_ZONE("DVD read");
       FileMonitor::Log(request.dvd_offset, request.partition);
 
       std::vector<u8> buffer(request.length);
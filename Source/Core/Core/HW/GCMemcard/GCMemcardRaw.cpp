@@ -4,7 +4,9 @@
 
 #include "Core/HW/GCMemcard/GCMemcardRaw.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
 #include <cstring>
 #include <memory>
 #include <mutex>
@@ -15,9 +17,11 @@
 #include "Common/CommonTypes.h"
 #include "Common/File.h"
 #include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
+#include "Common/Timer.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/HW/GCMemcard/GCMemcard.h"
@@ -25,9 +29,30 @@
 #define SIZE_TO_Mb (1024 * 8 * 16)
 #define MC_HDR_SIZE 0xA000
 
+// Flushes first write the modified blocks to <card>.journal, then to the card itself. If Dolphin
+// dies in the middle of writing to the card, the journal is replayed the next time it is loaded.
+constexpr u32 JOURNAL_MAGIC = 0x4A434D44;  // "DMCJ"
+constexpr u32 JOURNAL_ENTRY_SIZE = sizeof(u32) + BLOCK_SIZE;
+
+struct JournalHeader
+{
+  u32 magic;
+  u32 num_blocks;
+  u32 card_size;
+  // Adler-32 of the entries, each of which is a block index followed by the block's contents.
+  u32 checksum;
+};
+
+static std::string GetJournalPath(const std::string& filename)
+{
+  return filename + ".journal";
+}
+
 MemoryCard::MemoryCard(const std::string& filename, int card_index, u16 size_mbits)
     : MemoryCardBase(card_index, size_mbits), m_filename(filename)
 {
+  ReplayJournal();
+
   File::IOFile file(m_filename, "rb");
   if (file)
   {
@@ -58,6 +83,7 @@ MemoryCard::MemoryCard(const std::string& filename, int card_index, u16 size_mbi
   // Class members (including inherited ones) have now been initialized, so
   // it's safe to startup the flush thread (which reads them).
   m_flush_buffer = std::make_unique<u8[]>(m_memory_card_size);
+  m_dirty_blocks.assign((m_memory_card_size + BLOCK_SIZE - 1) / BLOCK_SIZE, false);
   m_flush_thread = std::thread(&MemoryCard::FlushThread, this);
 }
 
@@ -82,6 +108,10 @@ void MemoryCard::FlushThread()
       StringFromFormat("Memcard %d flushing thread", m_card_index).c_str());
 
   const auto flush_interval = std::chrono::seconds(15);
+  // Games write a save in many small pieces. Wait until the game has stopped writing for a
+  // moment so that the whole save ends up in a single flush, but don't put it off forever.
+  const u32 quiet_time_ms = 1000;
+  const int max_quiet_waits = 15;
 
   while (true)
   {
@@ -90,16 +120,24 @@ void MemoryCard::FlushThread()
     bool do_exit = m_flush_trigger.WaitFor(flush_interval);
     if (!do_exit)
     {
-      bool is_dirty = m_dirty.TestAndClear();
-      if (!is_dirty)
+      if (!m_dirty.IsSet())
       {
         continue;
       }
+
+      for (int i = 0; i < max_quiet_waits && !do_exit &&
+                      Common::Timer::GetTimeMs() - m_last_write_time < quiet_time_ms;
+           ++i)
+      {
+        do_exit = m_flush_trigger.WaitFor(std::chrono::milliseconds(quiet_time_ms));
+      }
+      m_dirty.Clear();
     }
 
     // Opening the file is purposefully done each iteration to ensure the
     // file doesn't disappear out from under us after the first check.
     File::IOFile file(m_filename, "r+b");
+    bool full = false;
 
     if (!file)
     {
@@ -110,6 +148,11 @@ void MemoryCard::FlushThread()
         File::CreateFullPath(dir);
       }
       file.Open(m_filename, "wb");
+      full = true;
+    }
+    else if (file.GetSize() != m_memory_card_size)
+    {
+      full = true;
     }
 
     // Note - file may have changed above, after ctor
@@ -127,28 +170,175 @@ void MemoryCard::FlushThread()
       return;
     }
 
+    const bool written = Flush(file, full);
+
+    if (!do_exit)
+    {
+      if (written)
+      {
+        Core::DisplayMessage(StringFromFormat("Wrote memory card %c contents to %s",
+                                              m_card_index ? 'B' : 'A', m_filename.c_str())
+                                 .c_str(),
+                             4000);
+      }
+    }
+    else
+    {
+      return;
+    }
+  }
+}
+
+bool MemoryCard::Flush(File::IOFile& file, bool full)
+{
+  std::vector<u32> blocks;
+  {
+    std::unique_lock<std::mutex> l(m_flush_mutex);
+    for (u32 i = 0; i < m_dirty_blocks.size(); ++i)
+    {
+      if (!full && !m_dirty_blocks[i])
+        continue;
+
+      const u32 offset = i * BLOCK_SIZE;
+      memcpy(&m_flush_buffer[offset], &m_memcard_data[offset],
+             std::min<u32>(BLOCK_SIZE, m_memory_card_size - offset));
+      m_dirty_blocks[i] = false;
+      blocks.push_back(i);
+    }
+  }
+
+  if (blocks.empty())
+    return false;
+
+  // There is nothing to protect when the whole card gets (re)written.
+  const std::string journal_path = GetJournalPath(m_filename);
+  bool journaled = false;
+  if (!full)
+  {
+    std::vector<u8> entries(blocks.size() * JOURNAL_ENTRY_SIZE, 0xFF);
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+      u8* entry = &entries[i * JOURNAL_ENTRY_SIZE];
+      const u32 offset = blocks[i] * BLOCK_SIZE;
+      memcpy(entry, &blocks[i], sizeof(u32));
+      memcpy(entry + sizeof(u32), &m_flush_buffer[offset],
+             std::min<u32>(BLOCK_SIZE, m_memory_card_size - offset));
+    }
+
+    const JournalHeader header{JOURNAL_MAGIC, static_cast<u32>(blocks.size()),
+                               m_memory_card_size, HashAdler32(entries.data(), entries.size())};
+    File::IOFile journal(journal_path, "wb");
+    journaled = journal.WriteArray(&header, 1) &&
+                journal.WriteBytes(entries.data(), entries.size()) && journal.Sync();
+    if (!journaled)
+      WARN_LOG(EXPANSIONINTERFACE, "Could not write memory card journal %s", journal_path.c_str());
+  }
+
+  // Write runs of consecutive blocks with a single call.
+  bool written = true;
+  for (size_t i = 0; written && i < blocks.size();)
+  {
+    size_t end = i + 1;
+    while (end < blocks.size() && blocks[end] == blocks[end - 1] + 1)
+      ++end;
+
+    const u32 offset = blocks[i] * BLOCK_SIZE;
+    const u32 size =
+        std::min<u32>((blocks[end - 1] + 1) * BLOCK_SIZE, m_memory_card_size) - offset;
+    written = file.Seek(offset, SEEK_SET) && file.WriteBytes(&m_flush_buffer[offset], size);
+    i = end;
+  }
+
+  if (!written || !file.Sync())
+  {
+    // Leave the journal in place so that the next load can finish the job, and write the blocks
+    // again on the next flush. That flush replaces the journal, so it must include them too.
+    ERROR_LOG(EXPANSIONINTERFACE, "Failed to write memory card %s", m_filename.c_str());
     {
       std::unique_lock<std::mutex> l(m_flush_mutex);
-      memcpy(&m_flush_buffer[0], &m_memcard_data[0], m_memory_card_size);
+      for (u32 block : blocks)
+        m_dirty_blocks[block] = true;
     }
-    file.WriteBytes(&m_flush_buffer[0], m_memory_card_size);
+    m_dirty.Set();
+    return false;
+  }
 
-    if (!do_exit)
+  if (journaled)
+    File::Delete(journal_path);
+  return true;
+}
+
+void MemoryCard::ReplayJournal()
+{
+  const std::string journal_path = GetJournalPath(m_filename);
+  if (!File::Exists(journal_path))
+    return;
+
+  {
+    File::IOFile journal(journal_path, "rb");
+    JournalHeader header;
+    std::vector<u8> entries;
+    bool valid = journal.ReadArray(&header, 1) && header.magic == JOURNAL_MAGIC;
+    valid = valid && journal.GetSize() == sizeof(JournalHeader) +
+                                              u64(header.num_blocks) * JOURNAL_ENTRY_SIZE;
+    if (valid)
     {
-      Core::DisplayMessage(StringFromFormat("Wrote memory card %c contents to %s",
-                                            m_card_index ? 'B' : 'A', m_filename.c_str())
-                               .c_str(),
-                           4000);
+      entries.resize(static_cast<size_t>(header.num_blocks) * JOURNAL_ENTRY_SIZE);
+      valid = journal.ReadBytes(entries.data(), entries.size()) &&
+              HashAdler32(entries.data(), entries.size()) == header.checksum;
+    }
+
+    File::IOFile file(m_filename, "r+b");
+    if (!valid || !file || file.GetSize() != header.card_size)
+    {
+      // The flush was interrupted while writing the journal, so the card itself was never touched.
+      WARN_LOG(EXPANSIONINTERFACE, "Discarding incomplete memory card journal %s",
+               journal_path.c_str());
     }
     else
     {
-      return;
+      for (u32 i = 0; i < header.num_blocks; ++i)
+      {
+        const u8* entry = &entries[i * JOURNAL_ENTRY_SIZE];
+        u32 block;
+        memcpy(&block, entry, sizeof(u32));
+        const u64 offset = static_cast<u64>(block) * BLOCK_SIZE;
+        if (offset >= header.card_size)
+          continue;
+
+        file.Seek(offset, SEEK_SET);
+        file.WriteBytes(entry + sizeof(u32),
+                        std::min<u64>(BLOCK_SIZE, header.card_size - offset));
+      }
+
+      if (!file.Sync())
+      {
+        ERROR_LOG(EXPANSIONINTERFACE, "Failed to recover memory card %s from its journal",
+                  m_filename.c_str());
+        return;
+      }
+      NOTICE_LOG(EXPANSIONINTERFACE, "Recovered %u blocks of memory card %s from its journal",
+                 header.num_blocks, m_filename.c_str());
     }
   }
+
+  File::Delete(journal_path);
+}
+
+void MemoryCard::MarkBlocksDirty(u32 address, u32 length)
+{
+  if (length == 0 || address >= m_memory_card_size)
+    return;
+
+  const u32 end = std::min(address + length, m_memory_card_size);
+  const u32 last_block = std::min<u32>((end - 1) / BLOCK_SIZE, u32(m_dirty_blocks.size()) - 1);
+  for (u32 block = address / BLOCK_SIZE; block <= last_block; ++block)
+    m_dirty_blocks[block] = true;
 }
 
 void MemoryCard::MakeDirty()
 {
+  m_last_write_time = Common::Timer::GetTimeMs();
   m_dirty.Set();
 }
 
@@ -175,6 +365,7 @@ s32 MemoryCard::Write(u32 dest_address, s32 length, const u8* src_address)
   {
     std::unique_lock<std::mutex> l(m_flush_mutex);
     memcpy(&m_memcard_data[dest_address], src_address, length);
+    MarkBlocksDirty(dest_address, length);
   }
   MakeDirty();
   return length;
@@ -191,6 +382,7 @@ void MemoryCard::ClearBlock(u32 address)
   {
     std::unique_lock<std::mutex> l(m_flush_mutex);
     memset(&m_memcard_data[address], 0xFF, BLOCK_SIZE);
+    MarkBlocksDirty(address, BLOCK_SIZE);
   }
   MakeDirty();
 }
@@ -200,6 +392,7 @@ void MemoryCard::ClearAll()
   {
     std::unique_lock<std::mutex> l(m_flush_mutex);
     memset(&m_memcard_data[0], 0xFF, m_memory_card_size);
+    MarkBlocksDirty(0, m_memory_card_size);
   }
   MakeDirty();
 }
@@ -209,4 +402,11 @@ void MemoryCard::DoState(PointerWrap& p)
   p.Do(m_card_index);
   p.Do(m_memory_card_size);
   p.DoArray(&m_memcard_data[0], m_memory_card_size);
+
+  if (p.GetMode() == PointerWrap::MODE_READ)
+  {
+    // The card file no longer matches any of the loaded contents.
+    std::unique_lock<std::mutex> l(m_flush_mutex);
+    MarkBlocksDirty(0, m_memory_card_size);
+  }
 }
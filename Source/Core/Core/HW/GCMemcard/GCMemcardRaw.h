@@ -4,16 +4,23 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Core/HW/GCMemcard/GCMemcard.h"
 
 class PointerWrap;
 
+namespace File
+{
+class IOFile;
+}
+
 class MemoryCard : public MemoryCardBase
 {
 public:
@@ -29,6 +36,12 @@ public:
   void DoState(PointerWrap& p) override;
 
 private:
+  void ReplayJournal();
+  // m_flush_mutex must be held.
+  void MarkBlocksDirty(u32 address, u32 length);
+  // Writes the blocks that were modified since the last flush, or the whole card if full is set.
+  bool Flush(File::IOFile& file, bool full);
+
   std::string m_filename;
   std::unique_ptr<u8[]> m_memcard_data;
   std::unique_ptr<u8[]> m_flush_buffer;
@@ -36,4 +49,7 @@ private:
   std::mutex m_flush_mutex;
   Common::Event m_flush_trigger;
   Common::Flag m_dirty;
+  // One entry per BLOCK_SIZE bytes. Protected by m_flush_mutex.
+  std::vector<bool> m_dirty_blocks;
+  std::atomic<u32> m_last_write_time{0};
 };
@@ -11,12 +11,16 @@
 
 #include <algorithm>
 #include <cstring>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <vector>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
+#include "Common/MemoryUtil.h"
 #include "Common/Swap.h"
 #include "Core/ConfigManager.h"
 #include "Core/HW/AudioInterface.h"
@@ -29,6 +33,7 @@
 #include "Core/HW/SI/SI.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/HW/WII_IPC.h"
+#include "Core/PowerPC/BreakPoints.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "VideoCommon/CommandProcessor.h"
@@ -164,6 +169,14 @@ static PhysicalMemoryRegion physical_regions[] = {
 
 static std::vector<LogicalMemoryView> logical_mapped_entries;
 
+// Pages of the logical view that are translated through the page table rather than the BATs,
+// mapped one at a time as they're accessed. Maps the logical address of each page to whether
+// the page is writable.
+static std::map<u32, bool> logical_mapped_pages;
+constexpr u32 LOGICAL_PAGE_SIZE = 0x1000;
+// Every page is a separate host mapping, and the number of those is limited.
+constexpr size_t MAX_LOGICAL_MAPPED_PAGES = 8192;
+
 void Init()
 {
   bool wii = SConfig::GetInstance().bWii;
@@ -222,8 +235,51 @@ void Init()
   m_IsInitialized = true;
 }
 
+static void ProtectWatchedMemory()
+{
+  if (!PowerPC::memchecks.HasAny())
+    return;
+
+  // Accesses to protected pages fault and get backpatched to the slow path, which is where
+  // memchecks are handled. Recreating the views on the next BAT update drops the protection.
+  // Read memchecks are handled last so that a write memcheck sharing a host page with them
+  // can't make that page readable again.
+  const uintptr_t page_size = Common::MemPageSize();
+  const auto& memchecks = PowerPC::memchecks.GetMemChecks();
+  std::vector<const TMemCheck*> sorted_memchecks;
+  for (const TMemCheck& mc : memchecks)
+    sorted_memchecks.push_back(&mc);
+  std::stable_partition(sorted_memchecks.begin(), sorted_memchecks.end(),
+                        [](const TMemCheck* mc) { return !mc->is_break_on_read; });
+
+  for (const TMemCheck* mc : sorted_memchecks)
+  {
+    const uintptr_t start = reinterpret_cast<uintptr_t>(logical_base + mc->start_address);
+    const uintptr_t end = reinterpret_cast<uintptr_t>(logical_base + mc->end_address) + 1;
+
+    for (const auto& entry : logical_mapped_entries)
+    {
+      const uintptr_t entry_start = reinterpret_cast<uintptr_t>(entry.mapped_pointer);
+      const uintptr_t entry_end = entry_start + entry.mapped_size;
+      const uintptr_t protect_start = std::max(start & ~(page_size - 1), entry_start);
+      const uintptr_t protect_end =
+          std::min((end + page_size - 1) & ~(page_size - 1), entry_end);
+      if (protect_start >= protect_end)
+        continue;
+
+      void* ptr = reinterpret_cast<void*>(protect_start);
+      const size_t size = protect_end - protect_start;
+      if (mc->is_break_on_read)
+        Common::ReadProtectMemory(ptr, size);
+      else if (mc->is_break_on_write)
+        Common::WriteProtectMemory(ptr, size);
+    }
+  }
+}
+
 void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
 {
+  UnmapLogicalPages(0, 0);
   for (auto& entry : logical_mapped_entries)
   {
     g_arena.ReleaseView(entry.mapped_pointer, entry.mapped_size);
@@ -231,7 +287,7 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
   logical_mapped_entries.clear();
   for (u32 i = 0; i < dbat_table.size(); ++i)
   {
-    if (dbat_table[i] & PowerPC::BAT_PHYSICAL_BIT)
+    if (dbat_table[i] & (PowerPC::BAT_PHYSICAL_BIT | PowerPC::BAT_WATCHED_BIT))
     {
       u32 logical_address = i << PowerPC::BAT_INDEX_SHIFT;
       // TODO: Merge adjacent mappings to make this faster.
@@ -261,6 +317,80 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
       }
     }
   }
+
+  ProtectWatchedMemory();
+}
+
+bool MapLogicalPage(u32 logical_address, u32 physical_address, bool writable)
+{
+#ifdef _WIN32
+  // Views have to be aligned to the 64 KiB allocation granularity.
+  return false;
+#else
+  if (!logical_base || Common::MemPageSize() != LOGICAL_PAGE_SIZE)
+    return false;
+
+  logical_address &= ~(LOGICAL_PAGE_SIZE - 1);
+  physical_address &= ~(LOGICAL_PAGE_SIZE - 1);
+  u8* base = logical_base + logical_address;
+
+  auto iter = logical_mapped_pages.find(logical_address);
+  if (iter != logical_mapped_pages.end())
+  {
+    g_arena.ReleaseView(base, LOGICAL_PAGE_SIZE);
+    logical_mapped_pages.erase(iter);
+  }
+
+  auto region = std::find_if(std::begin(physical_regions), std::end(physical_regions),
+                             [physical_address](const PhysicalMemoryRegion& r) {
+                               return *r.out_pointer && physical_address >= r.physical_address &&
+                                      physical_address - r.physical_address < r.size;
+                             });
+  if (region == std::end(physical_regions))
+    return false;
+
+  if (logical_mapped_pages.size() >= MAX_LOGICAL_MAPPED_PAGES)
+    UnmapLogicalPages(0, 0);
+
+  const u32 position = region->shm_position + physical_address - region->physical_address;
+  if (g_arena.CreateView(position, LOGICAL_PAGE_SIZE, base) != base)
+  {
+    ERROR_LOG(MEMMAP, "Failed to map logical page %08x", logical_address);
+    return false;
+  }
+  if (!writable)
+    Common::WriteProtectMemory(base, LOGICAL_PAGE_SIZE);
+
+  logical_mapped_pages.emplace(logical_address, writable);
+  return true;
+#endif
+}
+
+bool IsLogicalPageMapped(u32 logical_address, bool* writable)
+{
+  auto iter = logical_mapped_pages.find(logical_address & ~(LOGICAL_PAGE_SIZE - 1));
+  if (iter == logical_mapped_pages.end())
+    return false;
+
+  *writable = iter->second;
+  return true;
+}
+
+void UnmapLogicalPages(u32 logical_address, u32 mask)
+{
+  auto iter = logical_mapped_pages.begin();
+  while (iter != logical_mapped_pages.end())
+  {
+    if (((iter->first ^ logical_address) & mask) == 0)
+    {
+      g_arena.ReleaseView(logical_base + iter->first, LOGICAL_PAGE_SIZE);
+      iter = logical_mapped_pages.erase(iter);
+    }
+    else
+    {
+      ++iter;
+    }
+  }
 }
 
 void DoState(PointerWrap& p)
@@ -292,6 +422,7 @@ void Shutdown()
     g_arena.ReleaseView(*region.out_pointer, region.size);
     *region.out_pointer = nullptr;
   }
+  UnmapLogicalPages(0, 0);
   for (auto& entry : logical_mapped_entries)
   {
     g_arena.ReleaseView(entry.mapped_pointer, entry.mapped_size);
@@ -66,6 +66,14 @@ void DoState(PointerWrap& p);
 
 void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
 
+// Maps a single 4 KiB page of the logical view that is translated through the page table. These
+// pages are mapped lazily when a fastmem access to them faults, and have to be unmapped whenever
+// their translation may have changed. Returns false if the page isn't backed by memory.
+bool MapLogicalPage(u32 logical_address, u32 physical_address, bool writable);
+bool IsLogicalPageMapped(u32 logical_address, bool* writable);
+// Unmaps all page table pages whose logical address matches logical_address in the bits of mask.
+void UnmapLogicalPages(u32 logical_address, u32 mask);
+
 void Clear();
 
 // Routines to access physically addressed memory, designed for use by
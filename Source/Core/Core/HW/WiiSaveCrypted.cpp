@@ -30,6 +30,7 @@
 #include "Common/NandPaths.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
+#include "Core/IOS/FS/NANDIndex.h"
 
 const u8 CWiiSaveCrypted::s_sd_key[16] = {0xAB, 0x01, 0xB9, 0xD8, 0xE1, 0x62, 0x2B, 0x08,
                                           0xAF, 0xBA, 0xD8, 0x4D, 0xBF, 0xC2, 0xA5, 0x5D};
@@ -40,6 +41,7 @@ const u32 CWiiSaveCrypted::s_ng_id = 0x0403AC68;
 bool CWiiSaveCrypted::ImportWiiSave(const std::string& filename)
 {
   CWiiSaveCrypted save_file(filename);
+  IOS::HLE::NANDIndex::InvalidateAll();
   return save_file.m_valid;
 }
 
@@ -25,6 +25,7 @@
 #include "Core/ConfigManager.h"
 #include "Core/HW/Memmap.h"
 #include "Core/IOS/ES/Formats.h"
+#include "Core/IOS/FS/FS.h"
 #include "Core/IOS/IOSC.h"
 #include "Core/ec_wii.h"
 #include "DiscIO/NANDContentLoader.h"
@@ -185,6 +186,8 @@ static bool UpdateUIDAndGID(Kernel& kernel, const IOS::ES::TMDReader& tmd)
   IOS::ES::UIDSys uid_sys{Common::FromWhichRoot::FROM_SESSION_ROOT};
   const u64 title_id = tmd.GetTitleId();
   const u32 uid = uid_sys.GetOrInsertUIDForTitle(title_id);
+  // Inserting a new UID writes to uid.sys.
+  kernel.GetFS()->GetNANDIndex().Invalidate();
   if (!uid)
   {
     ERROR_LOG(IOS_ES, "Failed to get UID for title %016" PRIx64, title_id);
@@ -379,6 +382,30 @@ ReturnCode ES::Close(u32 fd)
   return IPC_SUCCESS;
 }
 
+// Title management writes to the NAND directly rather than through /dev/fs.
+bool ES::ModifiesNAND(u32 request)
+{
+  switch (request)
+  {
+  case IOCTL_ES_ADDTICKET:
+  case IOCTL_ES_ADDTMD:
+  case IOCTL_ES_ADDTITLESTART:
+  case IOCTL_ES_ADDCONTENTSTART:
+  case IOCTL_ES_ADDCONTENTDATA:
+  case IOCTL_ES_ADDCONTENTFINISH:
+  case IOCTL_ES_ADDTITLEFINISH:
+  case IOCTL_ES_ADDTITLECANCEL:
+  case IOCTL_ES_DELETETITLE:
+  case IOCTL_ES_DELETETICKET:
+  case IOCTL_ES_DELETETITLECONTENT:
+  case IOCTL_ES_DELETESHAREDCONTENT:
+  case IOCTL_ES_DELETE_CONTENT:
+    return true;
+  default:
+    return false;
+  }
+}
+
 IPCCommandResult ES::IOCtlV(const IOCtlVRequest& request)
 {
   DEBUG_LOG(IOS_ES, "%s (0x%x)", GetDeviceName().c_str(), request.request);
@@ -386,6 +413,9 @@ IPCCommandResult ES::IOCtlV(const IOCtlVRequest& request)
   if (context == m_contexts.end())
     return GetDefaultReply(ES_EINVAL);
 
+  if (ModifiesNAND(request.request))
+    m_ios.GetFS()->GetNANDIndex().Invalidate();
+
   switch (request.request)
   {
   case IOCTL_ES_ADDTICKET:
@@ -646,6 +676,7 @@ s32 ES::DIVerify(const IOS::ES::TMDReader& tmd, const IOS::ES::TicketReader& tic
     if (!tmd_file.WriteBytes(tmd_bytes.data(), tmd_bytes.size()))
       ERROR_LOG(IOS_ES, "DIVerify failed to write disc TMD to NAND.");
   }
+  GetIOS()->GetFS()->GetNANDIndex().Invalidate();
   // DI_VERIFY writes to title.tmd, which is read and cached inside the NAND Content Manager.
   // clear the cache to avoid content access mismatches.
   DiscIO::NANDContentManager::Access().ClearCache();
@@ -6,7 +6,6 @@
 
 #include <algorithm>
 #include <cstring>
-#include <deque>
 #include <memory>
 #include <vector>
 
@@ -34,7 +33,8 @@ static bool IsValidWiiPath(const std::string& path)
 
 namespace Device
 {
-FS::FS(Kernel& ios, const std::string& device_name) : Device(ios, device_name)
+FS::FS(Kernel& ios, const std::string& device_name)
+    : Device(ios, device_name), m_nand_index(BuildFilename("/tmp"))
 {
   const std::string tmp_dir = BuildFilename("/tmp");
   File::DeleteDirRecursively(tmp_dir);
@@ -46,94 +46,7 @@ void FS::DoState(PointerWrap& p)
   DoStateShared(p);
 
   // handle /tmp
-
-  std::string Path = File::GetUserPath(D_SESSION_WIIROOT_IDX) + "/tmp";
-  if (p.GetMode() == PointerWrap::MODE_READ)
-  {
-    File::DeleteDirRecursively(Path);
-    File::CreateDir(Path);
-
-    // now restore from the stream
-    while (1)
-    {
-      char type = 0;
-      p.Do(type);
-      if (!type)
-        break;
-      std::string filename;
-      p.Do(filename);
-      std::string name = Path + DIR_SEP + filename;
-      switch (type)
-      {
-      case 'd':
-      {
-        File::CreateDir(name);
-        break;
-      }
-      case 'f':
-      {
-        u32 size = 0;
-        p.Do(size);
-
-        File::IOFile handle(name, "wb");
-        char buf[65536];
-        u32 count = size;
-        while (count > 65536)
-        {
-          p.DoArray(buf);
-          handle.WriteArray(&buf[0], 65536);
-          count -= 65536;
-        }
-        p.DoArray(&buf[0], count);
-        handle.WriteArray(&buf[0], count);
-        break;
-      }
-      }
-    }
-  }
-  else
-  {
-    // recurse through tmp and save dirs and files
-
-    File::FSTEntry parentEntry = File::ScanDirectoryTree(Path, true);
-    std::deque<File::FSTEntry> todo;
-    todo.insert(todo.end(), parentEntry.children.begin(), parentEntry.children.end());
-
-    while (!todo.empty())
-    {
-      File::FSTEntry& entry = todo.front();
-      std::string name = entry.physicalName;
-      name.erase(0, Path.length() + 1);
-      char type = entry.isDirectory ? 'd' : 'f';
-      p.Do(type);
-      p.Do(name);
-      if (entry.isDirectory)
-      {
-        todo.insert(todo.end(), entry.children.begin(), entry.children.end());
-      }
-      else
-      {
-        u32 size = (u32)entry.size;
-        p.Do(size);
-
-        File::IOFile handle(entry.physicalName, "rb");
-        char buf[65536];
-        u32 count = size;
-        while (count > 65536)
-        {
-          handle.ReadArray(&buf[0], 65536);
-          p.DoArray(buf);
-          count -= 65536;
-        }
-        handle.ReadArray(&buf[0], count);
-        p.DoArray(&buf[0], count);
-      }
-      todo.pop_front();
-    }
-
-    char type = 0;
-    p.Do(type);
-  }
+  m_nand_index.DoTmpState(p);
 }
 
 ReturnCode FS::Open(const OpenRequest& request)
@@ -142,21 +55,6 @@ ReturnCode FS::Open(const OpenRequest& request)
   return IPC_SUCCESS;
 }
 
-// Get total filesize of contents of a directory (recursive)
-// Only used for ES_GetUsage atm, could be useful elsewhere?
-static u64 ComputeTotalFileSize(const File::FSTEntry& parentEntry)
-{
-  u64 sizeOfFiles = 0;
-  for (const File::FSTEntry& entry : parentEntry.children)
-  {
-    if (entry.isDirectory)
-      sizeOfFiles += ComputeTotalFileSize(entry);
-    else
-      sizeOfFiles += entry.size;
-  }
-  return sizeOfFiles;
-}
-
 IPCCommandResult FS::IOCtl(const IOCtlRequest& request)
 {
   Memory::Memset(request.buffer_out, 0, request.buffer_out_size);
@@ -259,6 +157,7 @@ IPCCommandResult FS::CreateDirectory(const IOCtlRequest& request)
 
   DirName += DIR_SEP;
   File::CreateFullPath(DirName);
+  m_nand_index.OnEntryChanged(DirName);
   _dbg_assert_msg_(IOS_FILEIO, File::IsDirectory(DirName), "FS: CREATE_DIR %s failed",
                    DirName.c_str());
 
@@ -384,10 +283,12 @@ IPCCommandResult FS::DeleteFile(const IOCtlRequest& request)
   if (File::Delete(Filename))
   {
     INFO_LOG(IOS_FILEIO, "FS: DeleteFile %s", Filename.c_str());
+    m_nand_index.OnEntryChanged(Filename);
   }
   else if (File::DeleteDir(Filename))
   {
     INFO_LOG(IOS_FILEIO, "FS: DeleteDir %s", Filename.c_str());
+    m_nand_index.OnEntryChanged(Filename);
   }
   else
   {
@@ -431,7 +332,10 @@ IPCCommandResult FS::RenameFile(const IOCtlRequest& request)
   }
 
   // finally try to rename the file
-  if (File::Rename(Filename, FilenameRename))
+  const bool renamed = File::Rename(Filename, FilenameRename);
+  m_nand_index.OnEntryChanged(Filename);
+  m_nand_index.OnEntryChanged(FilenameRename);
+  if (renamed)
   {
     INFO_LOG(IOS_FILEIO, "FS: Rename %s to %s", Filename.c_str(), FilenameRename.c_str());
   }
@@ -490,6 +394,7 @@ IPCCommandResult FS::CreateFile(const IOCtlRequest& request)
   // create the file
   File::CreateFullPath(Filename);  // just to be sure
   bool Result = File::CreateEmptyFile(Filename);
+  m_nand_index.OnEntryChanged(Filename);
   if (!Result)
   {
     ERROR_LOG(IOS_FILEIO, "FS: couldn't create new file");
@@ -613,15 +518,11 @@ IPCCommandResult FS::GetUsage(const IOCtlVRequest& request)
   u32 iNodes = 0;
 
   INFO_LOG(IOS_FILEIO, "IOCTL_GETUSAGE %s", path.c_str());
-  if (File::IsDirectory(path))
+  NANDIndex::Usage usage;
+  if (m_nand_index.GetDirectoryUsage(path, &usage))
   {
-    File::FSTEntry parentDir = File::ScanDirectoryTree(path, true);
-    // add one for the folder itself
-    iNodes = 1 + (u32)parentDir.size;
-
-    u64 totalSize = ComputeTotalFileSize(parentDir);  // "Real" size, to be converted to nand blocks
-
-    fsBlocks = (u32)(totalSize / (16 * 1024));  // one bock is 16kb
+    iNodes = usage.inodes;
+    fsBlocks = (u32)(usage.size / (16 * 1024));  // one bock is 16kb
 
     INFO_LOG(IOS_FILEIO, "FS: fsBlock: %i, iNodes: %i", fsBlocks, iNodes);
   }
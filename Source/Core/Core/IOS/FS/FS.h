@@ -8,6 +8,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Core/IOS/Device.h"
+#include "Core/IOS/FS/NANDIndex.h"
 #include "Core/IOS/IOS.h"
 
 class PointerWrap;
@@ -40,6 +41,8 @@ public:
   IPCCommandResult IOCtl(const IOCtlRequest& request) override;
   IPCCommandResult IOCtlV(const IOCtlVRequest& request) override;
 
+  NANDIndex& GetNANDIndex() { return m_nand_index; }
+
 private:
   enum
   {
@@ -68,6 +71,8 @@ private:
 
   IPCCommandResult ReadDirectory(const IOCtlVRequest& request);
   IPCCommandResult GetUsage(const IOCtlVRequest& request);
+
+  NANDIndex m_nand_index;
 };
 }  // namespace Device
 }  // namespace HLE
@@ -4,6 +4,7 @@
 
 #include "Core/IOS/FS/FileIO.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstdio>
 #include <map>
@@ -18,6 +19,7 @@
 #include "Common/NandPaths.h"
 #include "Core/CommonTitles.h"
 #include "Core/HW/Memmap.h"
+#include "Core/IOS/FS/FS.h"
 #include "Core/IOS/IOS.h"
 
 namespace IOS
@@ -248,12 +250,15 @@ IPCCommandResult FileIO::Write(const ReadWriteRequest& request)
     {
       DEBUG_LOG(IOS_FILEIO, "FileIO: Write 0x%04x bytes from 0x%08x to %s", request.size,
                 request.buffer, m_name.c_str());
+      const u64 old_size = m_file->GetSize();
       m_file->Seek(m_SeekPos,
                    SEEK_SET);  // File might be opened twice, need to seek before we write
       if (m_file->WriteBytes(Memory::GetPointer(request.buffer), request.size))
       {
         return_value = request.size;
         m_SeekPos += request.size;
+        m_ios.GetFS()->GetNANDIndex().OnFileWritten(m_filepath, old_size,
+                                                     std::max<u64>(old_size, m_SeekPos));
       }
     }
   }
@@ -0,0 +1,317 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/IOS/FS/NANDIndex.h"
+
+#include <atomic>
+#include <deque>
+#include <utility>
+
+#include "Common/ChunkFile.h"
+#include "Common/CommonPaths.h"
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+
+namespace IOS
+{
+namespace HLE
+{
+static std::string StripTrailingSeparators(std::string path)
+{
+  while (path.size() > 1 && path.back() == '/')
+    path.pop_back();
+  return path;
+}
+
+// Get total filesize of contents of a directory (recursive)
+static u64 ComputeTotalFileSize(const File::FSTEntry& parent_entry)
+{
+  u64 size_of_files = 0;
+  for (const File::FSTEntry& entry : parent_entry.children)
+  {
+    if (entry.isDirectory)
+      size_of_files += ComputeTotalFileSize(entry);
+    else
+      size_of_files += entry.size;
+  }
+  return size_of_files;
+}
+
+// Incremented by InvalidateAll.
+static std::atomic<u64> s_external_changes{0};
+
+NANDIndex::NANDIndex(const std::string& tmp_path)
+    : m_external_changes_seen(s_external_changes.load()),
+      m_tmp_path(StripTrailingSeparators(tmp_path))
+{
+}
+
+template <typename Function>
+void NANDIndex::ForEachAncestor(const std::string& path, Function function)
+{
+  std::string current = StripTrailingSeparators(path);
+  while (true)
+  {
+    function(current);
+    const size_t separator = current.rfind('/');
+    if (separator == std::string::npos || separator == 0)
+      break;
+    current.resize(separator);
+  }
+}
+
+bool NANDIndex::GetDirectoryUsage(const std::string& path, Usage* usage)
+{
+  CheckForExternalChanges();
+
+  const std::string key = StripTrailingSeparators(path);
+  auto it = m_usage.find(key);
+  if (it == m_usage.end())
+  {
+    if (!File::IsDirectory(key))
+      return false;
+
+    const File::FSTEntry entry = File::ScanDirectoryTree(key, true);
+    // add one for the folder itself
+    const Usage computed{ComputeTotalFileSize(entry), 1 + static_cast<u32>(entry.size)};
+    it = m_usage.emplace(key, computed).first;
+  }
+
+  *usage = it->second;
+  return true;
+}
+
+void NANDIndex::OnFileWritten(const std::string& path, u64 old_size, u64 new_size)
+{
+  if (new_size != old_size)
+  {
+    ForEachAncestor(path, [this, old_size, new_size](const std::string& directory) {
+      auto it = m_usage.find(directory);
+      if (it != m_usage.end())
+        it->second.size = it->second.size - old_size + new_size;
+    });
+  }
+
+  MarkTmpDirty(path);
+}
+
+void NANDIndex::OnEntryChanged(const std::string& path)
+{
+  const std::string changed = StripTrailingSeparators(path);
+
+  // The entry may itself be a directory whose usage (or whose subdirectories' usage) is cached.
+  const std::string prefix = changed + '/';
+  for (auto it = m_usage.begin(); it != m_usage.end();)
+  {
+    if (it->first.compare(0, prefix.size(), prefix) == 0)
+      it = m_usage.erase(it);
+    else
+      ++it;
+  }
+  ForEachAncestor(changed, [this](const std::string& directory) { m_usage.erase(directory); });
+
+  if (IsTmpPath(changed))
+  {
+    m_tmp_needs_rescan = true;
+    MarkTmpDirty(changed);
+  }
+}
+
+void NANDIndex::Invalidate()
+{
+  m_usage.clear();
+
+  m_tmp_needs_rescan = true;
+  for (auto& entry : m_tmp_entries)
+    entry.second.dirty = true;
+}
+
+void NANDIndex::InvalidateAll()
+{
+  ++s_external_changes;
+}
+
+void NANDIndex::CheckForExternalChanges()
+{
+  const u64 external_changes = s_external_changes.load();
+  if (external_changes == m_external_changes_seen)
+    return;
+
+  m_external_changes_seen = external_changes;
+  Invalidate();
+}
+
+bool NANDIndex::IsTmpPath(const std::string& path) const
+{
+  return path.size() > m_tmp_path.size() && path[m_tmp_path.size()] == '/' &&
+         path.compare(0, m_tmp_path.size(), m_tmp_path) == 0;
+}
+
+void NANDIndex::MarkTmpDirty(const std::string& path)
+{
+  if (!IsTmpPath(path))
+    return;
+
+  // Mark the entry and, if it is a directory, everything inside it.
+  const std::string name = StripTrailingSeparators(path.substr(m_tmp_path.size() + 1));
+  for (auto it = m_tmp_entries.lower_bound(name);
+       it != m_tmp_entries.end() && it->first.compare(0, name.size(), name) == 0; ++it)
+  {
+    if (it->first.size() == name.size() || it->first[name.size()] == '/')
+      it->second.dirty = true;
+  }
+}
+
+void NANDIndex::RescanTmp()
+{
+  if (!m_tmp_needs_rescan)
+    return;
+
+  TmpEntries entries;
+  const File::FSTEntry parent_entry = File::ScanDirectoryTree(m_tmp_path, true);
+  std::deque<const File::FSTEntry*> todo;
+  for (const File::FSTEntry& child : parent_entry.children)
+    todo.push_back(&child);
+
+  while (!todo.empty())
+  {
+    const File::FSTEntry& entry = *todo.front();
+    todo.pop_front();
+
+    const std::string name = entry.physicalName.substr(m_tmp_path.size() + 1);
+    auto old_entry = m_tmp_entries.find(name);
+    if (old_entry != m_tmp_entries.end() && old_entry->second.is_directory == entry.isDirectory)
+      entries.emplace(name, std::move(old_entry->second));
+    else
+      entries[name].is_directory = entry.isDirectory;
+
+    for (const File::FSTEntry& child : entry.children)
+      todo.push_back(&child);
+  }
+
+  m_tmp_entries = std::move(entries);
+  m_tmp_needs_rescan = false;
+}
+
+void NANDIndex::LoadTmp(TmpEntries loaded)
+{
+  if (m_tmp_needs_rescan)
+  {
+    // We don't know what is on disk, so start from scratch.
+    File::DeleteDirRecursively(m_tmp_path);
+    File::CreateDir(m_tmp_path);
+    m_tmp_entries.clear();
+  }
+
+  // Remove whatever is not part of the state. Going backwards removes contents before
+  // the directories that contain them.
+  for (auto it = m_tmp_entries.rbegin(); it != m_tmp_entries.rend(); ++it)
+  {
+    const auto loaded_entry = loaded.find(it->first);
+    if (loaded_entry != loaded.end() && loaded_entry->second.is_directory == it->second.is_directory)
+      continue;
+
+    const std::string path = m_tmp_path + DIR_SEP + it->first;
+    if (it->second.is_directory)
+      File::DeleteDirRecursively(path);
+    else
+      File::Delete(path);
+  }
+
+  // Only write out files whose contents actually differ from what is already on disk.
+  for (const auto& entry : loaded)
+  {
+    const auto current = m_tmp_entries.find(entry.first);
+    const bool exists =
+        current != m_tmp_entries.end() && current->second.is_directory == entry.second.is_directory;
+    const std::string path = m_tmp_path + DIR_SEP + entry.first;
+
+    if (entry.second.is_directory)
+    {
+      if (!exists)
+        File::CreateDir(path);
+      continue;
+    }
+
+    if (exists && !current->second.dirty && current->second.data == entry.second.data)
+      continue;
+
+    File::IOFile handle(path, "wb");
+    if (!handle.WriteBytes(entry.second.data.data(), entry.second.data.size()))
+      ERROR_LOG(IOS_FILEIO, "Failed to restore %s", path.c_str());
+  }
+
+  m_tmp_entries = std::move(loaded);
+  m_tmp_needs_rescan = false;
+  // The usage of /tmp and its parents may have changed.
+  m_usage.clear();
+}
+
+void NANDIndex::DoTmpState(PointerWrap& p)
+{
+  CheckForExternalChanges();
+
+  if (p.GetMode() == PointerWrap::MODE_READ)
+  {
+    TmpEntries loaded;
+    while (true)
+    {
+      char type = 0;
+      p.Do(type);
+      if (!type)
+        break;
+      std::string name;
+      p.Do(name);
+
+      TmpEntry& entry = loaded[name];
+      entry.is_directory = type == 'd';
+      entry.dirty = false;
+      if (type == 'f')
+      {
+        u32 size = 0;
+        p.Do(size);
+        entry.data.resize(size);
+        if (size)
+          p.DoArray(entry.data.data(), size);
+      }
+    }
+
+    LoadTmp(std::move(loaded));
+    return;
+  }
+
+  // Only the files that were modified since they were last saved or loaded are read from disk,
+  // but the state always contains all of /tmp so that it can be loaded on its own.
+  RescanTmp();
+  for (auto& entry : m_tmp_entries)
+  {
+    TmpEntry& tmp_entry = entry.second;
+    if (!tmp_entry.is_directory && tmp_entry.dirty)
+    {
+      File::IOFile handle(m_tmp_path + DIR_SEP + entry.first, "rb");
+      tmp_entry.data.resize(handle.GetSize());
+      if (!handle.ReadBytes(tmp_entry.data.data(), tmp_entry.data.size()))
+        ERROR_LOG(IOS_FILEIO, "Failed to read %s for the savestate", entry.first.c_str());
+      tmp_entry.dirty = false;
+    }
+
+    char type = tmp_entry.is_directory ? 'd' : 'f';
+    p.Do(type);
+    std::string name = entry.first;
+    p.Do(name);
+    if (!tmp_entry.is_directory)
+    {
+      u32 size = static_cast<u32>(tmp_entry.data.size());
+      p.Do(size);
+      if (size)
+        p.DoArray(tmp_entry.data.data(), size);
+    }
+  }
+
+  char type = 0;
+  p.Do(type);
+}
+}  // namespace HLE
+}  // namespace IOS
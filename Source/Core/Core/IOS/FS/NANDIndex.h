@@ -0,0 +1,82 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+class PointerWrap;
+
+namespace IOS
+{
+namespace HLE
+{
+// Keeps track of what is on the emulated NAND so that /dev/fs does not have to walk the host
+// filesystem for every usage query, and so that savestates only have to re-read the /tmp files
+// that were modified since the last time they were saved or loaded.
+//
+// All paths are host paths as returned by BuildFilename. Changes made through /dev/fs and FileIO
+// are reported to the index as they happen; anything else that writes to the session NAND while
+// IOS is running (ES title management, for example) must call Invalidate(), or InvalidateAll()
+// if it doesn't run on the CPU thread or doesn't have access to the running IOS.
+class NANDIndex
+{
+public:
+  struct Usage
+  {
+    u64 size;
+    u32 inodes;
+  };
+
+  explicit NANDIndex(const std::string& tmp_path);
+
+  // Returns false if the path is not a directory.
+  bool GetDirectoryUsage(const std::string& path, Usage* usage);
+
+  void OnFileWritten(const std::string& path, u64 old_size, u64 new_size);
+  // Called when a file or directory is created, deleted or renamed.
+  void OnEntryChanged(const std::string& path);
+  void Invalidate();
+  // Makes every index drop what it has cached the next time it is used. Thread-safe.
+  static void InvalidateAll();
+
+  // Saves or restores the contents of /tmp.
+  void DoTmpState(PointerWrap& p);
+
+private:
+  struct TmpEntry
+  {
+    bool is_directory = false;
+    bool dirty = true;
+    std::vector<u8> data;
+  };
+  using TmpEntries = std::map<std::string, TmpEntry>;
+
+  // Calls the function on the path and all of its parent directories.
+  template <typename Function>
+  void ForEachAncestor(const std::string& path, Function function);
+
+  // Invalidates the index if InvalidateAll was called since the last check.
+  void CheckForExternalChanges();
+
+  bool IsTmpPath(const std::string& path) const;
+  void MarkTmpDirty(const std::string& path);
+  void RescanTmp();
+  void LoadTmp(TmpEntries loaded);
+
+  std::unordered_map<std::string, Usage> m_usage;
+  u64 m_external_changes_seen;
+
+  std::string m_tmp_path;
+  TmpEntries m_tmp_entries;
+  // Set when the directory structure of /tmp may no longer match m_tmp_entries.
+  bool m_tmp_needs_rescan = false;
+};
+}  // namespace HLE
+}  // namespace IOS
@@ -12,6 +12,7 @@
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Core/IOS/FS/NANDIndex.h"
 
 namespace IOS
 {
@@ -50,6 +51,7 @@ void NWC24Config::WriteConfig() const
   }
 
   File::IOFile(m_path, "wb").WriteBytes(&m_data, sizeof(m_data));
+  NANDIndex::InvalidateAll();
 }
 
 void NWC24Config::ResetConfig()
@@ -24,6 +24,7 @@
 #include "Core/HW/Wiimote.h"
 #include "Core/Host.h"
 #include "Core/IOS/Device.h"
+#include "Core/IOS/FS/NANDIndex.h"
 #include "Core/IOS/IOS.h"
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
 
@@ -83,6 +84,7 @@ BluetoothEmu::BluetoothEmu(Kernel& ios, const std::string& device_name)
   std::memcpy(section.data(), &BT_DINF, sizeof(_conf_pads));
   if (!sysconf.Save())
     PanicAlertT("Failed to write BT.DINF to SYSCONF");
+  NANDIndex::InvalidateAll();
 }
 
 BluetoothEmu::~BluetoothEmu()
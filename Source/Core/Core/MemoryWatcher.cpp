@@ -2,13 +2,20 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <new>
 #include <sstream>
+#include <sys/mman.h>
 #include <unistd.h>
 
 #include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/Swap.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
@@ -18,17 +25,22 @@ static std::unique_ptr<MemoryWatcher> s_memory_watcher;
 static CoreTiming::EventType* s_event;
 static const int MW_RATE = 600;  // Steps per second
 
+static_assert(std::atomic<u64>::is_always_lock_free,
+              "The snapshot ring is shared with other processes and must not use locks");
+
 static void MWCallback(u64 userdata, s64 cyclesLate)
 {
   s_memory_watcher->Step();
-  CoreTiming::ScheduleEvent(SystemTimers::GetTicksPerSecond() / MW_RATE - cyclesLate, s_event);
+  CoreTiming::ScheduleEvent(
+      SystemTimers::GetTicksPerSecond() / s_memory_watcher->GetRate() - cyclesLate, s_event);
 }
 
 void MemoryWatcher::Init()
 {
   s_memory_watcher = std::make_unique<MemoryWatcher>();
   s_event = CoreTiming::RegisterEvent("MemoryWatcher", MWCallback);
-  CoreTiming::ScheduleEvent(0, s_event);
+  if (s_memory_watcher->GetRate())
+    CoreTiming::ScheduleEvent(0, s_event);
 }
 
 void MemoryWatcher::Shutdown()
@@ -37,13 +49,30 @@ void MemoryWatcher::Shutdown()
   s_memory_watcher.reset();
 }
 
+void MemoryWatcher::FrameUpdate()
+{
+  if (s_memory_watcher && s_memory_watcher->IsPerFrame())
+    s_memory_watcher->Step();
+}
+
 MemoryWatcher::MemoryWatcher()
 {
   m_running = false;
-  if (!LoadAddresses(File::GetUserPath(F_MEMORYWATCHERLOCATIONS_IDX)))
+  if (LoadRegions(File::GetUserPath(F_MEMORYWATCHERREGIONS_IDX)))
+  {
+    if (!OpenSnapshotRing(File::GetUserPath(F_MEMORYWATCHERSNAPSHOTS_IDX)))
+      return;
+    m_binary = true;
+  }
+  else if (!LoadAddresses(File::GetUserPath(F_MEMORYWATCHERLOCATIONS_IDX)))
+  {
     return;
+  }
   if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
+  {
+    CloseSnapshotRing();
     return;
+  }
   m_running = true;
 }
 
@@ -54,6 +83,19 @@ MemoryWatcher::~MemoryWatcher()
 
   m_running = false;
   close(m_fd);
+  CloseSnapshotRing();
+}
+
+bool MemoryWatcher::IsPerFrame() const
+{
+  return m_running && m_binary && m_snapshot_rate == 0;
+}
+
+u32 MemoryWatcher::GetRate() const
+{
+  if (!m_running)
+    return 0;
+  return m_binary ? m_snapshot_rate : MW_RATE;
 }
 
 bool MemoryWatcher::LoadAddresses(const std::string& path)
@@ -66,19 +108,21 @@ bool MemoryWatcher::LoadAddresses(const std::string& path)
   while (std::getline(locations, line))
     ParseLine(line);
 
-  return m_values.size() > 0;
+  return m_locations.size() > 0;
 }
 
 void MemoryWatcher::ParseLine(const std::string& line)
 {
-  m_values[line] = 0;
-  m_addresses[line] = std::vector<u32>();
+  Location location;
+  location.line = line;
 
   std::stringstream offsets(line);
   offsets >> std::hex;
   u32 offset;
   while (offsets >> offset)
-    m_addresses[line].push_back(offset);
+    location.offsets.push_back(offset);
+
+  m_locations.push_back(std::move(location));
 }
 
 bool MemoryWatcher::OpenSocket(const std::string& path)
@@ -91,10 +135,10 @@ bool MemoryWatcher::OpenSocket(const std::string& path)
   return m_fd >= 0;
 }
 
-u32 MemoryWatcher::ChasePointer(const std::string& line)
+u32 MemoryWatcher::ChasePointer(const std::vector<u32>& offsets)
 {
   u32 value = 0;
-  for (u32 offset : m_addresses[line])
+  for (u32 offset : offsets)
     value = Memory::Read_U32(value + offset);
   return value;
 }
@@ -106,22 +150,217 @@ std::string MemoryWatcher::ComposeMessage(const std::string& line, u32 value)
   return message_stream.str();
 }
 
+bool MemoryWatcher::LoadRegions(const std::string& path)
+{
+  std::ifstream regions(path);
+  if (!regions)
+    return false;
+
+  std::string line;
+  while (std::getline(regions, line))
+  {
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    std::stringstream stream(line);
+    std::string directive;
+    stream >> directive;
+    if (directive == "rate")
+    {
+      stream >> m_snapshot_rate;
+      continue;
+    }
+    if (directive == "slots")
+    {
+      stream >> m_slot_count;
+      m_slot_count = std::max(m_slot_count, 2u);
+      continue;
+    }
+
+    Region region;
+    region.size = 4;
+    const size_t colon = line.find(':');
+    std::stringstream offsets(line.substr(0, colon));
+    offsets >> std::hex;
+    u32 offset;
+    while (offsets >> offset)
+      region.offsets.push_back(offset);
+    if (colon != std::string::npos)
+    {
+      std::stringstream size(line.substr(colon + 1));
+      size >> std::hex >> region.size;
+    }
+
+    if (region.offsets.empty() || region.size == 0)
+    {
+      ERROR_LOG(CORE, "MemoryWatcher: ignoring invalid region \"%s\"", line.c_str());
+      continue;
+    }
+    m_regions.push_back(std::move(region));
+  }
+
+  return m_regions.size() > 0;
+}
+
+bool MemoryWatcher::OpenSnapshotRing(const std::string& path)
+{
+  const u32 region_count = static_cast<u32>(m_regions.size());
+  u32 snapshot_size = region_count * sizeof(u32);
+  std::vector<SnapshotRegion> region_table;
+  for (const Region& region : m_regions)
+  {
+    region_table.push_back({static_cast<u32>(sizeof(SnapshotSlotHeader)) + snapshot_size,
+                            region.size});
+    snapshot_size += region.size;
+  }
+
+  // Keep every slot on its own cache lines so that readers of one slot don't slow down the writer.
+  const u32 slot_size = (sizeof(SnapshotSlotHeader) + snapshot_size + 63) & ~63u;
+  const u32 slots_offset =
+      (sizeof(SnapshotRingHeader) + region_count * sizeof(SnapshotRegion) + 63) & ~63u;
+  m_ring_size = slots_offset + static_cast<size_t>(slot_size) * m_slot_count;
+
+  const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+  {
+    ERROR_LOG(CORE, "MemoryWatcher: failed to create %s", path.c_str());
+    return false;
+  }
+  void* ring = nullptr;
+  if (ftruncate(fd, m_ring_size) == 0)
+    ring = mmap(nullptr, m_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (!ring || ring == MAP_FAILED)
+  {
+    ERROR_LOG(CORE, "MemoryWatcher: failed to map %s", path.c_str());
+    return false;
+  }
+  m_ring = static_cast<u8*>(ring);
+
+  SnapshotRingHeader* header = new (m_ring) SnapshotRingHeader;
+  header->version = SNAPSHOT_VERSION;
+  header->region_count = region_count;
+  header->slot_count = m_slot_count;
+  header->slot_size = slot_size;
+  header->slots_offset = slots_offset;
+  header->sequence.store(0, std::memory_order_relaxed);
+  std::memcpy(m_ring + sizeof(SnapshotRingHeader), region_table.data(),
+              region_table.size() * sizeof(SnapshotRegion));
+  for (u32 i = 0; i < m_slot_count; ++i)
+    new (m_ring + slots_offset + i * slot_size) SnapshotSlotHeader{{0}, 0};
+  std::atomic_thread_fence(std::memory_order_release);
+  header->magic = SNAPSHOT_MAGIC;
+
+  m_snapshot.resize(snapshot_size);
+  m_last_snapshot.clear();
+  m_sequence = 0;
+  return true;
+}
+
+void MemoryWatcher::CloseSnapshotRing()
+{
+  if (!m_ring)
+    return;
+
+  munmap(m_ring, m_ring_size);
+  m_ring = nullptr;
+}
+
+// Unlike Memory::GetPointer, this doesn't complain about invalid addresses, since the pointers
+// that are being followed are often null until the game has set things up.
+static const u8* GetRAMPointer(u32 address, u32 size)
+{
+  address &= 0x3FFFFFFF;
+  if (static_cast<u64>(address) + size <= Memory::REALRAM_SIZE)
+    return Memory::m_pRAM + address;
+
+  if (Memory::m_pEXRAM && (address >> 28) == 0x1 &&
+      static_cast<u64>(address & 0x0FFFFFFF) + size <= Memory::EXRAM_SIZE)
+  {
+    return Memory::m_pEXRAM + (address & Memory::EXRAM_MASK);
+  }
+
+  return nullptr;
+}
+
+void MemoryWatcher::TakeSnapshot()
+{
+  u8* addresses = m_snapshot.data();
+  u8* data = addresses + m_regions.size() * sizeof(u32);
+  for (const Region& region : m_regions)
+  {
+    // The last offset is added to the address rather than followed, so that the region starts
+    // at the same address the text mode would read its value from.
+    u32 address = 0;
+    for (size_t i = 0; i + 1 < region.offsets.size() && address != INVALID_ADDRESS; ++i)
+    {
+      const u8* pointer = GetRAMPointer(address + region.offsets[i], sizeof(u32));
+      address = pointer ? Common::swap32(pointer) : INVALID_ADDRESS;
+    }
+
+    const u8* pointer = nullptr;
+    if (address != INVALID_ADDRESS)
+    {
+      address += region.offsets.back();
+      pointer = GetRAMPointer(address, region.size);
+    }
+    if (pointer)
+    {
+      std::memcpy(data, pointer, region.size);
+    }
+    else
+    {
+      address = INVALID_ADDRESS;
+      std::memset(data, 0, region.size);
+    }
+
+    std::memcpy(addresses, &address, sizeof(u32));
+    addresses += sizeof(u32);
+    data += region.size;
+  }
+
+  // Only publish snapshots that differ from the previous one.
+  if (m_snapshot == m_last_snapshot)
+    return;
+
+  SnapshotRingHeader* header = reinterpret_cast<SnapshotRingHeader*>(m_ring);
+  const u64 sequence = ++m_sequence;
+  u8* slot = m_ring + header->slots_offset + ((sequence - 1) % m_slot_count) * header->slot_size;
+  SnapshotSlotHeader* slot_header = reinterpret_cast<SnapshotSlotHeader*>(slot);
+
+  slot_header->sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot_header->ticks = CoreTiming::GetTicks();
+  std::memcpy(slot + sizeof(SnapshotSlotHeader), m_snapshot.data(), m_snapshot.size());
+  slot_header->sequence.store(sequence, std::memory_order_release);
+  header->sequence.store(sequence, std::memory_order_release);
+
+  std::swap(m_snapshot, m_last_snapshot);
+  m_snapshot.resize(m_last_snapshot.size());
+
+  sendto(m_fd, &sequence, sizeof(sequence), MSG_DONTWAIT, reinterpret_cast<sockaddr*>(&m_addr),
+         sizeof(m_addr));
+}
+
 void MemoryWatcher::Step()
 {
   if (!m_running)
     return;
 
-  for (auto& entry : m_values)
+  if (m_binary)
   {
-    std::string address = entry.first;
-    u32& current_value = entry.second;
+    TakeSnapshot();
+    return;
+  }
 
-    u32 new_value = ChasePointer(address);
-    if (new_value != current_value)
+  for (Location& location : m_locations)
+  {
+    u32 new_value = ChasePointer(location.offsets);
+    if (new_value != location.value)
     {
       // Update the value
-      current_value = new_value;
-      std::string message = ComposeMessage(address, new_value);
+      location.value = new_value;
+      std::string message = ComposeMessage(location.line, new_value);
       sendto(m_fd, message.c_str(), message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
              sizeof(m_addr));
     }
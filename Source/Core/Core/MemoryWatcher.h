@@ -4,11 +4,14 @@
 
 #pragma once
 
-#include <map>
+#include <atomic>
+#include <string>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <vector>
 
+#include "Common/CommonTypes.h"
+
 // MemoryWatcher reads a file containing in-game memory addresses and outputs
 // changes to those memory addresses to a unix domain socket as the game runs.
 //
@@ -17,31 +20,108 @@
 // "ABCD EF" will watch the address at (*0xABCD) + 0xEF.
 // The output to the socket is two lines. The first is the address from the
 // input file, and the second is the new value in hex.
+//
+// If Regions.txt exists, it is used instead of Locations.txt and the watcher runs in binary mode.
+// Each line declares a region with a pointer chain like above, optionally followed by ':' and the
+// size of the region in hex (4 bytes by default), e.g. "ABCD EF:40". Lines starting with '#' are
+// comments, and two directives are supported:
+//   rate <n>   takes a snapshot n times per emulated second instead of once per frame
+//   slots <n>  keeps n snapshots in the ring instead of 64
+// Whenever the watched memory changes, a snapshot of all regions is written to the next slot of a
+// ring in the Snapshots file, which consumers are expected to mmap. See the structures below for
+// the layout. If the socket is bound, the sequence number of each new snapshot is also sent to it
+// as a native-endian u64, so that consumers can wait for snapshots instead of polling.
 class MemoryWatcher final
 {
 public:
+  static constexpr u32 SNAPSHOT_MAGIC = 0x53574D44;  // "DMWS"
+  static constexpr u32 SNAPSHOT_VERSION = 1;
+  static constexpr u32 INVALID_ADDRESS = 0xFFFFFFFF;
+
+  // All fields are native-endian. magic is written last, once the rest of the file is valid.
+  struct SnapshotRingHeader
+  {
+    u32 magic;
+    u32 version;
+    u32 region_count;
+    u32 slot_count;
+    u32 slot_size;
+    u32 slots_offset;
+    // Sequence number of the latest complete snapshot, starting from 1. Snapshot n is stored in
+    // slot (n - 1) % slot_count.
+    std::atomic<u64> sequence;
+  };
+  // The header is followed by one SnapshotRegion per region, in the order of Regions.txt.
+  struct SnapshotRegion
+  {
+    // Offset of the region's data from the start of a slot.
+    u32 data_offset;
+    u32 size;
+  };
+  // Each slot starts with this header, followed by the guest address every region was read from
+  // (INVALID_ADDRESS if its pointer chain couldn't be followed) and the raw, big-endian data.
+  //
+  // The sequence number is 0 while the slot is being written. To read snapshot n, check that the
+  // slot's sequence is n, copy the slot, then check that the sequence is still n.
+  struct SnapshotSlotHeader
+  {
+    std::atomic<u64> sequence;
+    u64 ticks;
+  };
+
   MemoryWatcher();
   ~MemoryWatcher();
   void Step();
+  bool IsPerFrame() const;
+  // Steps per emulated second, or 0 if Step isn't driven by a CoreTiming event.
+  u32 GetRate() const;
 
   static void Init();
   static void Shutdown();
+  // Called on the CPU thread once per emulated frame.
+  static void FrameUpdate();
 
 private:
+  struct Location
+  {
+    std::string line;
+    std::vector<u32> offsets;
+    u32 value = 0;
+  };
+  struct Region
+  {
+    std::vector<u32> offsets;
+    u32 size;
+  };
+
   bool LoadAddresses(const std::string& path);
   bool OpenSocket(const std::string& path);
 
   void ParseLine(const std::string& line);
-  u32 ChasePointer(const std::string& line);
+  u32 ChasePointer(const std::vector<u32>& offsets);
   std::string ComposeMessage(const std::string& line, u32 value);
 
+  bool LoadRegions(const std::string& path);
+  bool OpenSnapshotRing(const std::string& path);
+  void CloseSnapshotRing();
+  void TakeSnapshot();
+
   bool m_running;
+  bool m_binary = false;
 
   int m_fd;
   sockaddr_un m_addr;
 
-  // Address as stored in the file -> list of offsets to follow
-  std::map<std::string, std::vector<u32>> m_addresses;
-  // Address as stored in the file -> current value
-  std::map<std::string, u32> m_values;
+  std::vector<Location> m_locations;
+
+  std::vector<Region> m_regions;
+  // 0 means once per frame.
+  u32 m_snapshot_rate = 0;
+  u32 m_slot_count = 64;
+  u8* m_ring = nullptr;
+  size_t m_ring_size = 0;
+  u64 m_sequence = 0;
+  // Addresses and data of the current and the last published snapshot.
+  std::vector<u8> m_snapshot;
+  std::vector<u8> m_last_snapshot;
 };
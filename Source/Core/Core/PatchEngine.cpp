@@ -9,6 +9,7 @@
 #include "Core/PatchEngine.h"
 
 #include <algorithm>
+#include <cstring>
 #include <map>
 #include <set>
 #include <string>
@@ -17,11 +18,13 @@
 #include "Common/Assert.h"
 #include "Common/IniFile.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
 
 #include "Core/ActionReplay.h"
 #include "Core/ConfigManager.h"
 #include "Core/GeckoCode.h"
 #include "Core/GeckoCodeConfig.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/PowerPC.h"
 
 namespace PatchEngine
@@ -32,6 +35,110 @@ const char* PatchTypeStrings[] = {
 
 static std::vector<Patch> onFrame;
 static std::map<u32, int> speedHacks;
+// The active onFrame patches, rebuilt whenever onFrame is reloaded.
+static WriteBatch s_on_frame_writes;
+
+void WriteBatch::AddWrite8(u8 value, u32 address)
+{
+  AddWrite(address, &value, sizeof(value));
+}
+
+void WriteBatch::AddWrite16(u16 value, u32 address)
+{
+  const u16 swapped = Common::swap16(value);
+  AddWrite(address, reinterpret_cast<const u8*>(&swapped), sizeof(swapped));
+}
+
+void WriteBatch::AddWrite32(u32 value, u32 address)
+{
+  const u32 swapped = Common::swap32(value);
+  AddWrite(address, reinterpret_cast<const u8*>(&swapped), sizeof(swapped));
+}
+
+void WriteBatch::AddWrite(u32 address, const u8* data, u32 size)
+{
+  // Runs never span two BAT pages, since those may not be contiguous in host memory.
+  if (!m_runs.empty())
+  {
+    Run& last = m_runs.back();
+    const u32 end = last.address + last.size;
+    if (last.unit == size && end == address &&
+        (last.address >> PowerPC::BAT_INDEX_SHIFT) ==
+            ((address + size - 1) >> PowerPC::BAT_INDEX_SHIFT))
+    {
+      last.size += size;
+      m_data.insert(m_data.end(), data, data + size);
+      return;
+    }
+  }
+
+  m_runs.push_back({address, size, static_cast<u32>(m_data.size()), size});
+  m_data.insert(m_data.end(), data, data + size);
+}
+
+void WriteBatch::Clear()
+{
+  m_runs.clear();
+  m_data.clear();
+}
+
+// Returns nullptr if the run isn't backed by RAM through a BAT and must go through HostWrite.
+// Like HostWrite, this ignores memchecks: the watched pages are only protected in the logical view.
+static u8* GetRunPointer(u32 address, u32 size)
+{
+  if (UReg_MSR(MSR).DR)
+  {
+    const u32 bat_result = PowerPC::dbat_table[address >> PowerPC::BAT_INDEX_SHIFT];
+    if ((bat_result & (PowerPC::BAT_PHYSICAL_BIT | PowerPC::BAT_WATCHED_BIT)) == 0 ||
+        (address >> PowerPC::BAT_INDEX_SHIFT) != ((address + size - 1) >> PowerPC::BAT_INDEX_SHIFT))
+    {
+      return nullptr;
+    }
+    address = (bat_result & PowerPC::BAT_RESULT_MASK) | (address & (PowerPC::BAT_PAGE_SIZE - 1));
+  }
+
+  if (static_cast<u64>(address) + size <= Memory::REALRAM_SIZE)
+    return Memory::m_pRAM + address;
+  if (Memory::m_pEXRAM && (address >> 28) == 0x1 &&
+      static_cast<u64>(address & 0x0FFFFFFF) + size <= Memory::EXRAM_SIZE)
+  {
+    return Memory::m_pEXRAM + (address & 0x0FFFFFFF);
+  }
+  return nullptr;
+}
+
+void WriteBatch::Apply() const
+{
+  for (const Run& run : m_runs)
+  {
+    u8* pointer = GetRunPointer(run.address, run.size);
+    if (pointer)
+      std::memcpy(pointer, &m_data[run.data_offset], run.size);
+    else
+      ApplyWithHostWrites(run);
+  }
+}
+
+void WriteBatch::ApplyWithHostWrites(const Run& run) const
+{
+  for (u32 offset = 0; offset < run.size; offset += run.unit)
+  {
+    const u8* data = &m_data[run.data_offset + offset];
+    const u32 address = run.address + offset;
+    switch (run.unit)
+    {
+    case sizeof(u8):
+      PowerPC::HostWrite_U8(*data, address);
+      break;
+    case sizeof(u16):
+      PowerPC::HostWrite_U16(Common::swap16(data), address);
+      break;
+    case sizeof(u32):
+      PowerPC::HostWrite_U32(Common::swap32(data), address);
+      break;
+    }
+  }
+}
 
 void LoadPatchSection(const std::string& section, std::vector<Patch>& patches, IniFile& globalIni,
                       IniFile& localIni)
@@ -145,22 +252,9 @@ int GetSpeedhackCycles(const u32 addr)
     return iter->second;
 }
 
-void LoadPatches()
-{
-  IniFile merged = SConfig::GetInstance().LoadGameIni();
-  IniFile globalIni = SConfig::GetInstance().LoadDefaultGameIni();
-  IniFile localIni = SConfig::GetInstance().LoadLocalGameIni();
-
-  LoadPatchSection("OnFrame", onFrame, globalIni, localIni);
-  ActionReplay::LoadAndApplyCodes(globalIni, localIni);
-
-  Gecko::SetActiveCodes(Gecko::LoadCodes(globalIni, localIni));
-
-  LoadSpeedhacks("Speedhacks", merged);
-}
-
-static void ApplyPatches(const std::vector<Patch>& patches)
+static void CompilePatches(const std::vector<Patch>& patches, WriteBatch* writes)
 {
+  writes->Clear();
   for (const Patch& patch : patches)
   {
     if (patch.active)
@@ -172,13 +266,13 @@ static void ApplyPatches(const std::vector<Patch>& patches)
         switch (entry.type)
         {
         case PATCH_8BIT:
-          PowerPC::HostWrite_U8((u8)value, addr);
+          writes->AddWrite8((u8)value, addr);
           break;
         case PATCH_16BIT:
-          PowerPC::HostWrite_U16((u16)value, addr);
+          writes->AddWrite16((u16)value, addr);
           break;
         case PATCH_32BIT:
-          PowerPC::HostWrite_U32(value, addr);
+          writes->AddWrite32(value, addr);
           break;
         default:
           // unknown patchtype
@@ -189,6 +283,21 @@ static void ApplyPatches(const std::vector<Patch>& patches)
   }
 }
 
+void LoadPatches()
+{
+  IniFile merged = SConfig::GetInstance().LoadGameIni();
+  IniFile globalIni = SConfig::GetInstance().LoadDefaultGameIni();
+  IniFile localIni = SConfig::GetInstance().LoadLocalGameIni();
+
+  LoadPatchSection("OnFrame", onFrame, globalIni, localIni);
+  CompilePatches(onFrame, &s_on_frame_writes);
+  ActionReplay::LoadAndApplyCodes(globalIni, localIni);
+
+  Gecko::SetActiveCodes(Gecko::LoadCodes(globalIni, localIni));
+
+  LoadSpeedhacks("Speedhacks", merged);
+}
+
 // Requires MSR.DR, MSR.IR
 // There's no perfect way to do this, it's just a heuristic.
 // We require at least 2 stack frames, if the stack is shallower than that then it won't work.
@@ -228,7 +337,7 @@ bool ApplyFramePatches()
     return false;
   }
 
-  ApplyPatches(onFrame);
+  s_on_frame_writes.Apply();
 
   // Run the Gecko code handler
   Gecko::RunCodeHandler();
@@ -240,6 +349,7 @@ bool ApplyFramePatches()
 void Shutdown()
 {
   onFrame.clear();
+  s_on_frame_writes.Clear();
   speedHacks.clear();
   ActionReplay::ApplyCodes({});
   Gecko::Shutdown();
@@ -39,6 +39,44 @@ struct Patch
   bool user_defined;  // False if this code is shipped with Dolphin.
 };
 
+// A list of guest memory writes that is built once and applied many times.
+//
+// Writes of the same size to contiguous addresses are merged into runs, and each run is copied
+// with a single memcpy when it is backed by RAM through a BAT. Other runs fall back to
+// PowerPC::HostWrite_*, so the result is always the same as doing every write with HostWrite in
+// order.
+class WriteBatch
+{
+public:
+  void AddWrite8(u8 value, u32 address);
+  void AddWrite16(u16 value, u32 address);
+  void AddWrite32(u32 value, u32 address);
+
+  bool IsEmpty() const { return m_runs.empty(); }
+  // Number of bytes written by Apply.
+  size_t GetSize() const { return m_data.size(); }
+  void Clear();
+
+  // Must be called on the CPU thread.
+  void Apply() const;
+
+private:
+  struct Run
+  {
+    u32 address;
+    u32 size;
+    u32 data_offset;
+    u32 unit;
+  };
+
+  void AddWrite(u32 address, const u8* data, u32 size);
+  void ApplyWithHostWrites(const Run& run) const;
+
+  std::vector<Run> m_runs;
+  // The data of all runs, big-endian.
+  std::vector<u8> m_data;
+};
+
 int GetSpeedhackCycles(const u32 addr);
 void LoadPatchSection(const std::string& section, std::vector<Patch>& patches, IniFile& globalIni,
                       IniFile& localIni);
@@ -202,6 +202,16 @@ void MemChecks::Remove(u32 address)
   }
 }
 
+void MemChecks::Clear()
+{
+  Core::RunAsCPUThread([&] {
+    m_mem_checks.clear();
+    if (g_jit)
+      g_jit->ClearCache();
+    PowerPC::DBATUpdated();
+  });
+}
+
 TMemCheck* MemChecks::GetMemCheck(u32 address, size_t size)
 {
   for (TMemCheck& mc : m_mem_checks)
@@ -15,6 +15,24 @@
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 
+// Operands of the instructions that are run without going through the generic interpreter
+// handlers, decoded once when the block is built rather than every time the block runs.
+struct PredecodedOperands
+{
+  u8 d;
+  u8 a;
+  u8 b;
+  u8 crf;
+  u32 imm;
+
+  // Used by compare + conditional branch pairs.
+  u8 bi;
+  u8 branch_if;
+  u32 target;
+};
+
+typedef void (*PredecodedCallback)(const PredecodedOperands&);
+
 struct CachedInterpreter::Instruction
 {
   typedef void (*CommonCallback)(UGeckoInstruction);
@@ -31,10 +49,16 @@ struct CachedInterpreter::Instruction
   {
   }
 
+  Instruction(const PredecodedCallback c, const PredecodedOperands& o)
+      : predecoded_callback(c), data(0), type(INSTRUCTION_TYPE_PREDECODED), operands(o)
+  {
+  }
+
   union
   {
     const CommonCallback common_callback;
     const ConditionalCallback conditional_callback;
+    const PredecodedCallback predecoded_callback;
   };
   u32 data;
   enum
@@ -42,7 +66,9 @@ struct CachedInterpreter::Instruction
     INSTRUCTION_ABORT,
     INSTRUCTION_TYPE_COMMON,
     INSTRUCTION_TYPE_CONDITIONAL,
+    INSTRUCTION_TYPE_PREDECODED,
   } type;
+  PredecodedOperands operands{};
 };
 
 CachedInterpreter::CachedInterpreter() : code_buffer(32000)
@@ -99,6 +125,10 @@ void CachedInterpreter::ExecuteOneBlock()
         return;
       break;
 
+    case Instruction::INSTRUCTION_TYPE_PREDECODED:
+      code->predecoded_callback(code->operands);
+      break;
+
     default:
       ERROR_LOG(POWERPC, "Unknown CachedInterpreter Instruction: %d", code->type);
       break;
@@ -169,6 +199,215 @@ static bool CheckDSI(u32 data)
   return false;
 }
 
+// Pre-decoded forms of the most common integer instructions. Each one must behave exactly like
+// the Interpreter function for the same instruction.
+
+static void LoadImmediate(const PredecodedOperands& op)
+{
+  rGPR[op.d] = op.imm;
+}
+
+static void AddImmediate(const PredecodedOperands& op)
+{
+  rGPR[op.d] = rGPR[op.a] + op.imm;
+}
+
+static void OrImmediate(const PredecodedOperands& op)
+{
+  rGPR[op.d] = rGPR[op.a] | op.imm;
+}
+
+static void RotateAndMask(const PredecodedOperands& op)
+{
+  rGPR[op.d] = _rotl(rGPR[op.a], op.b) & op.imm;
+}
+
+static void LoadWord(const PredecodedOperands& op)
+{
+  const u32 value = PowerPC::Read_U32(rGPR[op.a] + op.imm);
+  if (!(PowerPC::ppcState.Exceptions & EXCEPTION_DSI))
+    rGPR[op.d] = value;
+}
+
+static void LoadWordWithUpdate(const PredecodedOperands& op)
+{
+  const u32 address = rGPR[op.a] + op.imm;
+  const u32 value = PowerPC::Read_U32(address);
+  if (!(PowerPC::ppcState.Exceptions & EXCEPTION_DSI))
+  {
+    rGPR[op.d] = value;
+    rGPR[op.a] = address;
+  }
+}
+
+static void StoreWord(const PredecodedOperands& op)
+{
+  PowerPC::Write_U32(rGPR[op.d], rGPR[op.a] + op.imm);
+}
+
+static void StoreWordWithUpdate(const PredecodedOperands& op)
+{
+  const u32 address = rGPR[op.a] + op.imm;
+  PowerPC::Write_U32(rGPR[op.d], address);
+  if (!(PowerPC::ppcState.Exceptions & EXCEPTION_DSI))
+    rGPR[op.a] = address;
+}
+
+static void CompareImmediate(const PredecodedOperands& op)
+{
+  // Same as Interpreter::Helper_UpdateCRx with the difference of the operands.
+  const u64 cr_val = static_cast<u64>(static_cast<s64>(static_cast<s32>(rGPR[op.a] - op.imm)));
+  PowerPC::ppcState.cr_val[op.crf] =
+      (cr_val & ~(1ull << 61)) | (static_cast<u64>(GetXER_SO()) << 61);
+}
+
+template <typename T>
+static void SetCompareResult(u8 crf, T a, T b)
+{
+  int value = a < b ? 0x8 : (a > b ? 0x4 : 0x2);
+  if (GetXER_SO())
+    value |= 0x1;
+  SetCRField(crf, value);
+}
+
+static void CompareLogicalImmediate(const PredecodedOperands& op)
+{
+  SetCompareResult<u32>(op.crf, rGPR[op.a], op.imm);
+}
+
+static void Compare(const PredecodedOperands& op)
+{
+  SetCompareResult<s32>(op.crf, rGPR[op.a], rGPR[op.b]);
+}
+
+static void CompareLogical(const PredecodedOperands& op)
+{
+  SetCompareResult<u32>(op.crf, rGPR[op.a], rGPR[op.b]);
+}
+
+// Superinstruction for a compare directly followed by a conditional branch that does not touch
+// CTR or LR. NPC has already been set to the fall-through address.
+template <void (*CompareFunction)(const PredecodedOperands&)>
+static void CompareAndBranch(const PredecodedOperands& op)
+{
+  CompareFunction(op);
+  if (GetCRBit(op.bi) == op.branch_if)
+    NPC = op.target;
+}
+
+static u32 RotateMask(u32 mb, u32 me)
+{
+  const u32 mask = (0xFFFFFFFF >> mb) ^ (0x7FFFFFFF >> me);
+  return me < mb ? ~mask : mask;
+}
+
+// Returns nullptr if the instruction has no pre-decoded form.
+static PredecodedCallback Predecode(UGeckoInstruction inst, PredecodedOperands* op)
+{
+  *op = {};
+  switch (inst.OPCD)
+  {
+  case 10:  // cmpli
+    op->crf = inst.CRFD;
+    op->a = inst.RA;
+    op->imm = inst.UIMM;
+    return CompareLogicalImmediate;
+  case 11:  // cmpi
+    op->crf = inst.CRFD;
+    op->a = inst.RA;
+    op->imm = inst.SIMM_16;
+    return CompareImmediate;
+  case 14:  // addi
+  case 15:  // addis
+    op->d = inst.RD;
+    op->a = inst.RA;
+    op->imm = inst.OPCD == 15 ? inst.SIMM_16 << 16 : inst.SIMM_16;
+    return inst.RA ? AddImmediate : LoadImmediate;
+  case 21:  // rlwinm
+    if (inst.Rc)
+      return nullptr;
+    op->d = inst.RA;
+    op->a = inst.RS;
+    op->b = inst.SH;
+    op->imm = RotateMask(inst.MB, inst.ME);
+    return RotateAndMask;
+  case 24:  // ori
+  case 25:  // oris
+    op->d = inst.RA;
+    op->a = inst.RS;
+    op->imm = inst.OPCD == 25 ? inst.UIMM << 16 : inst.UIMM;
+    return OrImmediate;
+  case 31:
+    if (inst.SUBOP10 != 0 && inst.SUBOP10 != 32)
+      return nullptr;
+    op->crf = inst.CRFD;
+    op->a = inst.RA;
+    op->b = inst.RB;
+    return inst.SUBOP10 == 0 ? Compare : CompareLogical;
+  case 32:  // lwz
+  case 33:  // lwzu
+  case 36:  // stw
+  case 37:  // stwu
+    // With rA = 0 the non-update forms use an absolute address. Leave those to the interpreter.
+    if (inst.RA == 0)
+      return nullptr;
+    op->d = inst.RD;
+    op->a = inst.RA;
+    op->imm = inst.SIMM_16;
+    switch (inst.OPCD)
+    {
+    case 32:
+      return LoadWord;
+    case 33:
+      return LoadWordWithUpdate;
+    case 36:
+      return StoreWord;
+    default:
+      return StoreWordWithUpdate;
+    }
+  default:
+    return nullptr;
+  }
+}
+
+// Returns nullptr if the pair can't be fused.
+static PredecodedCallback PredecodeCompareAndBranch(const PPCAnalyst::CodeOp& compare,
+                                                    const PPCAnalyst::CodeOp& branch,
+                                                    PredecodedOperands* op)
+{
+  const UGeckoInstruction inst = branch.inst;
+  // Only plain "branch if condition" forms: no CTR decrement, no link.
+  if (inst.OPCD != 16 || (inst.BO & 0x14) != 0x04 || inst.LK)
+    return nullptr;
+  // Leave the idle loop detection in Interpreter::bcx alone.
+  if (inst.hex == 0x4182fff8)
+    return nullptr;
+
+  PredecodedCallback compare_callback = Predecode(compare.inst, op);
+  if (compare.inst.OPCD != 10 && compare.inst.OPCD != 11 &&
+      !(compare.inst.OPCD == 31 && compare_callback))
+  {
+    return nullptr;
+  }
+
+  op->bi = inst.BI;
+  op->branch_if = (inst.BO >> 3) & 1;
+  op->target = SignExt16(inst.BD << 2) + (inst.AA ? 0 : branch.address);
+
+  if (compare_callback == CompareImmediate)
+    return CompareAndBranch<CompareImmediate>;
+  if (compare_callback == CompareLogicalImmediate)
+    return CompareAndBranch<CompareLogicalImmediate>;
+  if (compare_callback == Compare)
+    return CompareAndBranch<Compare>;
+  return CompareAndBranch<CompareLogical>;
+}
+
+static bool HasHLEHook(u32 address)
+{
+  return HLE::GetFirstFunctionIndex(address) != 0;
+}
+
 void CachedInterpreter::Jit(u32 address)
 {
   if (m_code.size() >= CODE_SIZE / sizeof(Instruction) - 0x1000 ||
@@ -240,9 +479,28 @@ void CachedInterpreter::Jit(u32 address)
         js.firstFPInstructionFound = true;
       }
 
+      PredecodedOperands operands;
+      if (i + 1 < code_block.m_num_instructions && !ops[i + 1].skip &&
+          !HasHLEHook(ops[i + 1].address))
+      {
+        PredecodedCallback fused = PredecodeCompareAndBranch(ops[i], ops[i + 1], &operands);
+        if (fused)
+        {
+          i++;
+          js.downcountAmount += ops[i].opinfo->numCycles;
+          m_code.emplace_back(WritePC, ops[i].address);
+          m_code.emplace_back(fused, operands);
+          m_code.emplace_back(EndBlock, js.downcountAmount);
+          continue;
+        }
+      }
+
       if (endblock || memcheck)
         m_code.emplace_back(WritePC, ops[i].address);
-      m_code.emplace_back(GetInterpreterOp(ops[i].inst), ops[i].inst);
+      if (PredecodedCallback predecoded = Predecode(ops[i].inst, &operands))
+        m_code.emplace_back(predecoded, operands);
+      else
+        m_code.emplace_back(GetInterpreterOp(ops[i].inst), ops[i].inst);
       if (memcheck)
         m_code.emplace_back(CheckDSI, js.downcountAmount);
       if (endblock)
@@ -14,9 +14,6 @@
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
 
-bool Interpreter::m_reserve;
-u32 Interpreter::m_reserve_address;
-
 u32 Interpreter::Helper_Get_EA(const UGeckoInstruction inst)
 {
   return inst.RA ? (rGPR[inst.RA] + inst.SIMM_16) : (u32)inst.SIMM_16;
@@ -752,8 +749,8 @@ void Interpreter::lwarx(UGeckoInstruction inst)
   if (!(PowerPC::ppcState.Exceptions & EXCEPTION_DSI))
   {
     rGPR[inst.RD] = temp;
-    m_reserve = true;
-    m_reserve_address = uAddress;
+    PowerPC::ppcState.reserve = true;
+    PowerPC::ppcState.reserve_address = uAddress;
   }
 }
 
@@ -761,16 +758,16 @@ void Interpreter::stwcxd(UGeckoInstruction inst)
 {
   // Stores Word Conditional indeXed
   u32 uAddress;
-  if (m_reserve)
+  if (PowerPC::ppcState.reserve)
   {
     uAddress = Helper_Get_EA_X(inst);
 
-    if (uAddress == m_reserve_address)
+    if (uAddress == PowerPC::ppcState.reserve_address)
     {
       PowerPC::Write_U32(rGPR[inst.RS], uAddress);
       if (!(PowerPC::ppcState.Exceptions & EXCEPTION_DSI))
       {
-        m_reserve = false;
+        PowerPC::ppcState.reserve = false;
         SetCRField(0, 2 | GetXER_SO());
         return;
       }
@@ -14,6 +14,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/File.h"
+#include "Common/JitRegister.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemoryUtil.h"
 #include "Common/StringUtil.h"
@@ -248,6 +249,7 @@ void Jit64::Init()
   // them.
   // it'll crash because the farcode functions get cleared on JIT clears.
   m_far_code.Init();
+  InitCodeGenerations();
   Clear();
 
   code_block.m_stats = &js.st;
@@ -263,8 +265,10 @@ void Jit64::ClearCache()
   m_far_code.ClearCodeSpace();
   m_const_pool.Clear();
   ClearCodeSpace();
+  InitCodeGenerations();
   Clear();
   UpdateMemoryOptions();
+  m_code_cache_stats.full_flushes++;
 }
 
 void Jit64::Shutdown()
@@ -286,6 +290,8 @@ void Jit64::FallBackToInterpreter(UGeckoInstruction inst)
     MOV(32, PPCSTATE(pc), Imm32(js.compilerPC));
     MOV(32, PPCSTATE(npc), Imm32(js.compilerPC + 4));
   }
+  MOV(64, R(RSCRATCH), ImmPtr(&js.op->opinfo->fallbackCount));
+  ADD(64, MatR(RSCRATCH), Imm8(1));
   Interpreter::Instruction instr = GetInterpreterOp(inst);
   ABI_PushRegistersAndAdjustStack({}, 0);
   ABI_CallFunctionC(instr, inst.hex);
@@ -558,11 +564,10 @@ void Jit64::Jit(u32 em_address)
 #endif
   }
 
-  if (IsAlmostFull() || m_far_code.IsAlmostFull() || trampolines.IsAlmostFull() ||
-      SConfig::GetInstance().bJITNoBlockCache)
-  {
+  if (SConfig::GetInstance().bJITNoBlockCache)
     ClearCache();
-  }
+  else
+    EvictCodeGenerations();
 
   int blockSize = code_buffer.GetSize();
 
@@ -624,6 +629,10 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
 
   PPCAnalyst::CodeOp* ops = code_buf->codebuffer;
 
+  const bool register_code = JitRegister::IsEnabled();
+  js.instructionHostCode.clear();
+  js.farCodeStart = m_far_code.GetCodePtr();
+
   const u8* start =
       AlignCode4();  // TODO: Test if this or AlignCode16 make a difference from GetCodePtr
   b->checkedEntry = start;
@@ -718,6 +727,8 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
     js.compilerPC = ops[i].address;
     js.op = &ops[i];
     js.instructionNumber = i;
+    if (register_code)
+      js.instructionHostCode.emplace_back(GetCodePtr(), ops[i].address);
     js.instructionsLeft = (code_block.m_num_instructions - 1) - i;
     const GekkoOPInfo* opinfo = ops[i].opinfo;
     js.downcountAmount += opinfo->numCycles;
@@ -953,6 +964,7 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
 
   b->codeSize = (u32)(GetCodePtr() - start);
   b->originalSize = code_block.m_num_instructions;
+  js.farCodeEnd = m_far_code.GetCodePtr();
 
 #ifdef JIT_LOG_X86
   LogGeneratedX86(code_block.m_num_instructions, code_buf, start, b);
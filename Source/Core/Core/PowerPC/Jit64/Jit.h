@@ -157,6 +157,8 @@ public:
   void mfspr(UGeckoInstruction inst);
   void mtmsr(UGeckoInstruction inst);
   void mfmsr(UGeckoInstruction inst);
+  void mfsr(UGeckoInstruction inst);
+  void mfsrin(UGeckoInstruction inst);
   void mftb(UGeckoInstruction inst);
   void mtcrf(UGeckoInstruction inst);
   void mfcr(UGeckoInstruction inst);
@@ -225,8 +227,14 @@ public:
 
   void lmw(UGeckoInstruction inst);
   void stmw(UGeckoInstruction inst);
+  void lswi(UGeckoInstruction inst);
+  void stswi(UGeckoInstruction inst);
+
+  void lwarx(UGeckoInstruction inst);
+  void stwcxd(UGeckoInstruction inst);
 
   void dcbx(UGeckoInstruction inst);
+  void icbi(UGeckoInstruction inst);
 
   void eieio(UGeckoInstruction inst);
 
@@ -253,12 +253,12 @@ const GekkoOPTemplate table31[] = {
     {790, &Jit64::lXXx},  // lhbrx
 
     // Conditional load/store (Wii SMP)
-    {150, &Jit64::FallBackToInterpreter},  // stwcxd
-    {20, &Jit64::FallBackToInterpreter},   // lwarx
+    {150, &Jit64::stwcxd},  // stwcxd
+    {20, &Jit64::lwarx},    // lwarx
 
-    // load string (interpret these)
+    // load string
     {533, &Jit64::FallBackToInterpreter},  // lswx
-    {597, &Jit64::FallBackToInterpreter},  // lswi
+    {597, &Jit64::lswi},                   // lswi
 
     // store word
     {151, &Jit64::stXx},  // stwx
@@ -277,7 +277,7 @@ const GekkoOPTemplate table31[] = {
     {918, &Jit64::stXx},  // sthbrx
 
     {661, &Jit64::FallBackToInterpreter},  // stswx
-    {725, &Jit64::FallBackToInterpreter},  // stswi
+    {725, &Jit64::stswi},                  // stswi
 
     // fp load/store
     {535, &Jit64::lfXXX},  // lfsx
@@ -301,12 +301,12 @@ const GekkoOPTemplate table31[] = {
     {467, &Jit64::mtspr},                  // mtspr
     {371, &Jit64::mftb},                   // mftb
     {512, &Jit64::mcrxr},                  // mcrxr
-    {595, &Jit64::FallBackToInterpreter},  // mfsr
-    {659, &Jit64::FallBackToInterpreter},  // mfsrin
+    {595, &Jit64::mfsr},                   // mfsr
+    {659, &Jit64::mfsrin},                 // mfsrin
 
-    {4, &Jit64::twX},                      // tw
-    {598, &Jit64::DoNothing},              // sync
-    {982, &Jit64::FallBackToInterpreter},  // icbi
+    {4, &Jit64::twX},          // tw
+    {598, &Jit64::DoNothing},  // sync
+    {982, &Jit64::icbi},       // icbi
 
     // Unused instructions on GC
     {310, &Jit64::FallBackToInterpreter},  // eciwx
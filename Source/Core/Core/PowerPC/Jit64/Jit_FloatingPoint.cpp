@@ -126,12 +126,25 @@ void Jit64::HandleNaNs(UGeckoInstruction inst, X64Reg xmm_out, X64Reg xmm, X64Re
       FixupBranch handle_nan = J_CC(CC_NZ, true);
       SwitchToFarCode();
       SetJumpTarget(handle_nan);
-      _assert_msg_(DYNA_REC, clobber == XMM0, "BLENDVPD implicitly uses XMM0");
-      BLENDVPD(xmm, MConst(psGeneratedQNaN));
-      for (u32 x : inputs)
+      if (cpu_info.bAVX)
+      {
+        // The VEX form can take the mask from any register.
+        VBLENDVPD(xmm, xmm, MConst(psGeneratedQNaN), clobber);
+        for (u32 x : inputs)
+        {
+          avx_op(&XEmitter::VCMPPD, &XEmitter::CMPPD, clobber, fpr.R(x), fpr.R(x), CMP_UNORD);
+          VBLENDVPD(xmm, xmm, fpr.R(x), clobber);
+        }
+      }
+      else
       {
-        avx_op(&XEmitter::VCMPPD, &XEmitter::CMPPD, clobber, fpr.R(x), fpr.R(x), CMP_UNORD);
-        BLENDVPD(xmm, fpr.R(x));
+        _assert_msg_(DYNA_REC, clobber == XMM0, "BLENDVPD implicitly uses XMM0");
+        BLENDVPD(xmm, MConst(psGeneratedQNaN));
+        for (u32 x : inputs)
+        {
+          avx_op(&XEmitter::VCMPPD, &XEmitter::CMPPD, clobber, fpr.R(x), fpr.R(x), CMP_UNORD);
+          BLENDVPD(xmm, fpr.R(x));
+        }
       }
       FixupBranch done = J(true);
       SwitchToNearCode();
@@ -319,16 +332,15 @@ void Jit64::fmaddXX(UGeckoInstruction inst)
   {
     // We implement nmsub a little differently ((b - a*c) instead of -(a*c - b)), so handle it
     // separately.
-    MOVAPD(XMM1, fpr.R(b));
     if (packed)
     {
       MULPD(XMM0, fpr.R(a));
-      SUBPD(XMM1, R(XMM0));
+      avx_op(&XEmitter::VSUBPD, &XEmitter::SUBPD, XMM1, fpr.R(b), R(XMM0), true);
     }
     else
     {
       MULSD(XMM0, fpr.R(a));
-      SUBSD(XMM1, R(XMM0));
+      avx_op(&XEmitter::VSUBSD, &XEmitter::SUBSD, XMM1, fpr.R(b), R(XMM0), false);
     }
   }
   else
@@ -425,6 +437,26 @@ void Jit64::fselx(UGeckoInstruction inst)
   else
     CMPSD(XMM0, fpr.R(a), CMP_NLE);
 
+  if (cpu_info.bAVX)
+  {
+    // The VEX form takes the mask as a separate operand and doesn't overwrite c, so a packed
+    // result can be written straight into d.
+    fpr.BindToRegister(c, true, false);
+    if (packed)
+    {
+      fpr.BindToRegister(d, d == a || d == b || d == c);
+      VBLENDVPD(fpr.RX(d), fpr.RX(c), fpr.R(b), XMM0);
+    }
+    else
+    {
+      VBLENDVPD(XMM1, fpr.RX(c), fpr.R(b), XMM0);
+      fpr.BindToRegister(d, true);
+      MOVSD(fpr.RX(d), R(XMM1));
+    }
+    fpr.UnlockAll();
+    return;
+  }
+
   if (cpu_info.bSSE4_1)
   {
     MOVAPD(XMM1, fpr.R(c));
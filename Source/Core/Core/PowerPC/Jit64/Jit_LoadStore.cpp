@@ -306,6 +306,32 @@ void Jit64::dcbx(UGeckoInstruction inst)
   gpr.UnlockAllX();
 }
 
+static void InvalidateICacheLine(u32 address)
+{
+  PowerPC::ppcState.iCache.Invalidate(address);
+}
+
+void Jit64::icbi(UGeckoInstruction inst)
+{
+  INSTRUCTION_START
+  JITDISABLE(bJITLoadStoreOff);
+
+  MOV_sum(32, RSCRATCH, inst.RA ? gpr.R(inst.RA) : Imm32(0), gpr.R(inst.RB));
+  BitSet32 registersInUse = CallerSavedRegistersInUse();
+  ABI_PushRegistersAndAdjustStack(registersInUse, 0);
+  ABI_CallFunctionR(InvalidateICacheLine, RSCRATCH);
+  ABI_PopRegistersAndAdjustStack(registersInUse, 0);
+
+  // icbi is FL_ENDBLOCK, so when it's the last instruction DoJit doesn't write an exit for the
+  // block. Leave through the dispatcher, which picks up any code the invalidation replaced.
+  if (js.isLastInstruction)
+  {
+    gpr.Flush();
+    fpr.Flush();
+    WriteExit(js.compilerPC + 4);
+  }
+}
+
 void Jit64::dcbt(UGeckoInstruction inst)
 {
   INSTRUCTION_START
@@ -528,6 +554,98 @@ void Jit64::stXx(UGeckoInstruction inst)
   gpr.UnlockAllX();
 }
 
+// The following two instructions are for SMP communications. On a single CPU, stwcx. only fails
+// if the reservation was lost to an interrupt or another stwcx.
+void Jit64::lwarx(UGeckoInstruction inst)
+{
+  INSTRUCTION_START
+  JITDISABLE(bJITLoadStoreOff);
+
+  int a = inst.RA, b = inst.RB, d = inst.RD;
+  gpr.Lock(a, b, d);
+
+  MOV_sum(32, RSCRATCH2, a ? gpr.R(a) : Imm32(0), gpr.R(b));
+
+  // See lXXx for why the old value is kept in the register cache.
+  if (jo.memcheck)
+  {
+    gpr.StoreFromRegister(d);
+    js.revertGprLoad = d;
+  }
+  gpr.BindToRegister(d, false, true);
+  SafeLoadToReg(gpr.RX(d), R(RSCRATCH2), 32, 0, CallerSavedRegistersInUse() | BitSet32{RSCRATCH2},
+                false);
+
+  // Like the interpreter, only take the reservation if the load didn't raise a DSI.
+  FixupBranch dsi;
+  if (jo.memcheck)
+  {
+    TEST(32, PPCSTATE(Exceptions), Imm32(EXCEPTION_DSI));
+    dsi = J_CC(CC_NZ);
+  }
+  MOV(8, PPCSTATE(reserve), Imm8(1));
+  MOV(32, PPCSTATE(reserve_address), R(RSCRATCH2));
+  if (jo.memcheck)
+    SetJumpTarget(dsi);
+
+  gpr.UnlockAll();
+}
+
+void Jit64::stwcxd(UGeckoInstruction inst)
+{
+  INSTRUCTION_START
+  JITDISABLE(bJITLoadStoreOff);
+
+  int a = inst.RA, b = inst.RB, s = inst.RS;
+  gpr.Lock(a, b, s);
+
+  MOV_sum(32, RSCRATCH2, a ? gpr.R(a) : Imm32(0), gpr.R(b));
+
+  CMP(8, PPCSTATE(reserve), Imm8(0));
+  FixupBranch not_reserved = J_CC(CC_E, true);
+  CMP(32, PPCSTATE(reserve_address), R(RSCRATCH2));
+  FixupBranch wrong_address = J_CC(CC_NE, true);
+
+  if (gpr.R(s).IsImm())
+  {
+    SafeWriteRegToReg(gpr.R(s), RSCRATCH2, 32, 0, CallerSavedRegistersInUse());
+  }
+  else
+  {
+    MOV(32, R(RSCRATCH), gpr.R(s));
+    SafeWriteRegToReg(RSCRATCH, RSCRATCH2, 32, 0, CallerSavedRegistersInUse());
+  }
+  // Like the interpreter, a store that raised a DSI keeps the reservation and leaves EQ clear.
+  FixupBranch dsi;
+  if (jo.memcheck)
+  {
+    TEST(32, PPCSTATE(Exceptions), Imm32(EXCEPTION_DSI));
+    dsi = J_CC(CC_NZ, true);
+  }
+  MOV(8, PPCSTATE(reserve), Imm8(0));
+  // EQ is set if the store was performed.
+  MOV(32, R(RSCRATCH), Imm32(2));
+  FixupBranch done = J();
+
+  SetJumpTarget(not_reserved);
+  SetJumpTarget(wrong_address);
+  if (jo.memcheck)
+    SetJumpTarget(dsi);
+  XOR(32, R(RSCRATCH), R(RSCRATCH));
+  SetJumpTarget(done);
+
+  // CR0 = [0 0 EQ SO]
+  MOVZX(32, 8, RSCRATCH2, PPCSTATE(xer_so_ov));
+  SHR(32, R(RSCRATCH2), Imm8(1));
+  OR(32, R(RSCRATCH), R(RSCRATCH2));
+  SHL(32, R(RSCRATCH), Imm8(3));
+  MOV(64, R(RSCRATCH2), ImmPtr(m_crTable.data()));
+  MOV(64, R(RSCRATCH), MRegSum(RSCRATCH, RSCRATCH2));
+  MOV(64, PPCSTATE(cr_val[0]), R(RSCRATCH));
+
+  gpr.UnlockAll();
+}
+
 // A few games use these heavily in video codecs.
 void Jit64::lmw(UGeckoInstruction inst)
 {
@@ -575,6 +693,88 @@ void Jit64::stmw(UGeckoInstruction inst)
   gpr.UnlockAllX();
 }
 
+// lswi and stswi move NB bytes (32 if NB is 0) between memory and consecutive registers starting
+// at RD/RS, wrapping around to r0. Since the byte count is part of the instruction, whole words
+// are transferred at once and only the bytes of a final, partial word one at a time.
+void Jit64::lswi(UGeckoInstruction inst)
+{
+  INSTRUCTION_START
+  JITDISABLE(bJITLoadStoreOff);
+
+  // A DSI partway through must stop the transfer, leaving the registers and memory already
+  // written. The interpreter checks after every byte.
+  if (jo.memcheck)
+  {
+    FallBackToInterpreter(inst);
+    return;
+  }
+
+  const u32 n = inst.NB ? inst.NB : 32;
+  if (inst.RA)
+    MOV(32, R(RSCRATCH2), gpr.R(inst.RA));
+  else
+    XOR(32, R(RSCRATCH2), R(RSCRATCH2));
+  for (u32 offset = 0; offset < n;)
+  {
+    const int r = (inst.RD + offset / 4) & 31;
+    const int accessSize = n - offset >= 4 ? 32 : 8;
+    const int shift = accessSize == 32 ? 0 : 24 - (offset & 3) * 8;
+    SafeLoadToReg(RSCRATCH, R(RSCRATCH2), accessSize, offset,
+                  CallerSavedRegistersInUse() | BitSet32{RSCRATCH2}, false);
+    if (shift)
+      SHL(32, R(RSCRATCH), Imm8(shift));
+    if ((offset & 3) == 0)
+    {
+      gpr.BindToRegister(r, false, true);
+      MOV(32, gpr.R(r), R(RSCRATCH));
+    }
+    else
+    {
+      OR(32, gpr.R(r), R(RSCRATCH));
+    }
+    offset += accessSize / 8;
+  }
+}
+
+void Jit64::stswi(UGeckoInstruction inst)
+{
+  INSTRUCTION_START
+  JITDISABLE(bJITLoadStoreOff);
+
+  // A DSI partway through must stop the transfer, leaving the registers and memory already
+  // written. The interpreter checks after every byte.
+  if (jo.memcheck)
+  {
+    FallBackToInterpreter(inst);
+    return;
+  }
+
+  const u32 n = inst.NB ? inst.NB : 32;
+  for (u32 offset = 0; offset < n;)
+  {
+    const int r = (inst.RS + offset / 4) & 31;
+    const int accessSize = n - offset >= 4 ? 32 : 8;
+    const int shift = accessSize == 32 ? 0 : 24 - (offset & 3) * 8;
+    if (inst.RA)
+      MOV(32, R(RSCRATCH), gpr.R(inst.RA));
+    else
+      XOR(32, R(RSCRATCH), R(RSCRATCH));
+    if (gpr.R(r).IsImm())
+    {
+      SafeWriteRegToReg(Imm32(gpr.R(r).Imm32() >> shift), RSCRATCH, accessSize, offset,
+                        CallerSavedRegistersInUse());
+    }
+    else
+    {
+      MOV(32, R(RSCRATCH2), gpr.R(r));
+      if (shift)
+        SHR(32, R(RSCRATCH2), Imm8(shift));
+      SafeWriteRegToReg(RSCRATCH2, RSCRATCH, accessSize, offset, CallerSavedRegistersInUse());
+    }
+    offset += accessSize / 8;
+  }
+}
+
 void Jit64::eieio(UGeckoInstruction inst)
 {
   INSTRUCTION_START
@@ -436,6 +436,31 @@ void Jit64::mfmsr(UGeckoInstruction inst)
   gpr.UnlockAll();
 }
 
+void Jit64::mfsr(UGeckoInstruction inst)
+{
+  INSTRUCTION_START
+  JITDISABLE(bJITSystemRegistersOff);
+
+  gpr.Lock(inst.RD);
+  gpr.BindToRegister(inst.RD, false, true);
+  MOV(32, gpr.R(inst.RD), PPCSTATE(sr[inst.SR]));
+  gpr.UnlockAll();
+}
+
+void Jit64::mfsrin(UGeckoInstruction inst)
+{
+  INSTRUCTION_START
+  JITDISABLE(bJITSystemRegistersOff);
+
+  int b = inst.RB, d = inst.RD;
+  gpr.Lock(b, d);
+  MOV(32, R(RSCRATCH), gpr.R(b));
+  SHR(32, R(RSCRATCH), Imm8(28));
+  gpr.BindToRegister(d, false, true);
+  MOV(32, gpr.R(d), MComplex(RPPCSTATE, RSCRATCH, SCALE_4, PPCSTATE_OFF(sr[0])));
+  gpr.UnlockAll();
+}
+
 void Jit64::mftb(UGeckoInstruction inst)
 {
   INSTRUCTION_START
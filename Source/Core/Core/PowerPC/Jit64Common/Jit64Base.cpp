@@ -4,7 +4,9 @@
 
 #include "Core/PowerPC/Jit64Common/Jit64Base.h"
 
+#include <cstring>
 #include <disasm.h>
+#include <initializer_list>
 #include <sstream>
 #include <string>
 
@@ -71,8 +73,16 @@ bool Jitx86Base::BackPatch(u32 emAddress, SContext* ctx)
   js.generatingTrampoline = true;
   js.trampolineExceptionHandler = exceptionHandler;
 
-  // Generate the trampoline.
+  // Generate the trampoline into the generation of the faulting code, so that both are evicted
+  // together.
+  SaveCodeGeneration();
+  CodeGeneration& generation = m_code_generations[GetCodeGeneration(codePtr)];
+  trampolines.SetCodePtr(generation.trampolines.ptr);
   const u8* trampoline = trampolines.GenerateTrampoline(info);
+  generation.trampolines.ptr = trampolines.GetWritableCodePtr();
+  if (generation.trampolines.IsAlmostFull())
+    generation.evict_pending = true;
+  LoadCodeGeneration();
   js.generatingTrampoline = false;
   js.trampolineExceptionHandler = nullptr;
 
@@ -126,6 +136,120 @@ bool Jitx86Base::BackPatch(u32 emAddress, SContext* ctx)
   return true;
 }
 
+void Jitx86Base::InitCodeGenerations()
+{
+  const auto split = [](u8* base, size_t size, size_t index) {
+    const size_t segment_size = size / CODE_GENERATIONS;
+    CodeSegment segment;
+    segment.start = base + segment_size * index;
+    segment.end = segment.start + segment_size;
+    segment.ptr = segment.start;
+    return segment;
+  };
+
+  for (size_t i = 0; i < CODE_GENERATIONS; ++i)
+  {
+    CodeGeneration& generation = m_code_generations[i];
+    generation.near_code = split(GetRegion(), GetRegionSize(), i);
+    generation.far_code = split(m_far_code.GetRegion(), m_far_code.GetRegionSize(), i);
+    generation.trampolines = split(trampolines.GetRegion(), trampolines.GetRegionSize(), i);
+    generation.evict_pending = false;
+  }
+  m_current_generation = 0;
+  LoadCodeGeneration();
+}
+
+void Jitx86Base::EvictCodeGenerations()
+{
+  SaveCodeGeneration();
+
+  // Backpatching may have filled up the trampolines of an older generation.
+  for (size_t i = 0; i < CODE_GENERATIONS; ++i)
+  {
+    if (i != m_current_generation && m_code_generations[i].evict_pending)
+      EvictCodeGeneration(i);
+  }
+
+  const CodeGeneration& current = m_code_generations[m_current_generation];
+  if (current.evict_pending || current.near_code.IsAlmostFull() ||
+      current.far_code.IsAlmostFull() || current.trampolines.IsAlmostFull())
+  {
+    // Code can't be moved, so blocks that are still in use are simply recompiled into the new
+    // generation the next time they're dispatched to.
+    m_current_generation = (m_current_generation + 1) % CODE_GENERATIONS;
+    EvictCodeGeneration(m_current_generation);
+  }
+
+  LoadCodeGeneration();
+}
+
+size_t Jitx86Base::GetCodeGeneration(const u8* ptr) const
+{
+  for (size_t i = 0; i < CODE_GENERATIONS; ++i)
+  {
+    const CodeGeneration& generation = m_code_generations[i];
+    if (generation.near_code.Contains(ptr) || generation.far_code.Contains(ptr))
+      return i;
+  }
+  return m_current_generation;
+}
+
+void Jitx86Base::SaveCodeGeneration()
+{
+  CodeGeneration& generation = m_code_generations[m_current_generation];
+  generation.near_code.ptr = GetWritableCodePtr();
+  generation.far_code.ptr = m_far_code.GetWritableCodePtr();
+  generation.trampolines.ptr = trampolines.GetWritableCodePtr();
+}
+
+void Jitx86Base::LoadCodeGeneration()
+{
+  const CodeGeneration& generation = m_code_generations[m_current_generation];
+  SetCodePtr(generation.near_code.ptr);
+  m_far_code.SetCodePtr(generation.far_code.ptr);
+  trampolines.SetCodePtr(generation.trampolines.ptr);
+}
+
+void Jitx86Base::EvictCodeGeneration(size_t index)
+{
+  CodeGeneration& generation = m_code_generations[index];
+  generation.evict_pending = false;
+  if (generation.near_code.ptr == generation.near_code.start &&
+      generation.far_code.ptr == generation.far_code.start &&
+      generation.trampolines.ptr == generation.trampolines.start)
+  {
+    return;
+  }
+
+  // This also unlinks the blocks from all blocks that jump to them.
+  const size_t evicted_blocks =
+      blocks.EraseHostCodeRange(generation.near_code.start, generation.near_code.end);
+
+  const auto erase_generation = [&generation](auto* map) {
+    auto iter = map->begin();
+    while (iter != map->end())
+    {
+      if (generation.near_code.Contains(iter->first) || generation.far_code.Contains(iter->first))
+        iter = map->erase(iter);
+      else
+        ++iter;
+    }
+  };
+  erase_generation(&m_back_patch_info);
+  erase_generation(&m_exception_handler_at_loc);
+
+  for (CodeSegment* segment :
+       {&generation.near_code, &generation.far_code, &generation.trampolines})
+  {
+    std::memset(segment->start, 0xCC, segment->ptr - segment->start);
+    segment->ptr = segment->start;
+  }
+
+  m_code_cache_stats.evicted_generations++;
+  m_code_cache_stats.evicted_blocks += evicted_blocks;
+  INFO_LOG(DYNA_REC, "Evicted JIT code generation %zu with %zu blocks", index, evicted_blocks);
+}
+
 void LogGeneratedX86(size_t size, const PPCAnalyst::CodeBuffer* code_buffer, const u8* normalEntry,
                      const JitBlock* b)
 {
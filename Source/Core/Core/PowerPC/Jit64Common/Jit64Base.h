@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 
@@ -37,13 +38,52 @@ constexpr size_t CODE_SIZE = 1024 * 1024 * 32;
 class Jitx86Base : public JitBase, public QuantizedMemoryRoutines
 {
 protected:
+  // The near code, far code and trampoline regions are each split into this many generations.
+  // Code is emitted into the current generation until one of its parts fills up, at which point
+  // the oldest generation is evicted and reused instead of clearing the whole cache.
+  static constexpr size_t CODE_GENERATIONS = 4;
+
   bool BackPatch(u32 emAddress, SContext* ctx);
+
+  // Must be called once the child code spaces have been allocated, and whenever they're cleared.
+  void InitCodeGenerations();
+  // Makes sure that the current generation has room for another block.
+  void EvictCodeGenerations();
+
   JitBlockCache blocks{*this};
   TrampolineCache trampolines;
 
 public:
   JitBlockCache* GetBlockCache() override { return &blocks; }
   bool HandleFault(uintptr_t access_address, SContext* ctx) override;
+
+private:
+  struct CodeSegment
+  {
+    u8* start = nullptr;
+    u8* end = nullptr;
+    // Where code is emitted next. Only up to date while the generation isn't current.
+    u8* ptr = nullptr;
+
+    bool Contains(const u8* p) const { return p >= start && p < end; }
+    bool IsAlmostFull() const { return end - ptr < 0x10000; }
+  };
+  struct CodeGeneration
+  {
+    CodeSegment near_code;
+    CodeSegment far_code;
+    CodeSegment trampolines;
+    // Set when a backpatch couldn't fit into the generation's trampolines.
+    bool evict_pending = false;
+  };
+
+  size_t GetCodeGeneration(const u8* ptr) const;
+  void SaveCodeGeneration();
+  void LoadCodeGeneration();
+  void EvictCodeGeneration(size_t generation);
+
+  std::array<CodeGeneration, CODE_GENERATIONS> m_code_generations;
+  size_t m_current_generation = 0;
 };
 
 void LogGeneratedX86(size_t size, const PPCAnalyst::CodeBuffer* code_buffer, const u8* normalEntry,
@@ -9,8 +9,8 @@
 
 // We offset by 0x80 because the range of one byte memory offsets is
 // -0x80..0x7f.
-#define PPCSTATE(x)                                                                                \
-  MDisp(RPPCSTATE, (int)((char*)&PowerPC::ppcState.x - (char*)&PowerPC::ppcState) - 0x80)
+#define PPCSTATE_OFF(x) ((int)((char*)&PowerPC::ppcState.x - (char*)&PowerPC::ppcState) - 0x80)
+#define PPCSTATE(x) MDisp(RPPCSTATE, PPCSTATE_OFF(x))
 // In case you want to disable the ppcstate register:
 // #define PPCSTATE(x) M(&PowerPC::ppcState.x)
 #define PPCSTATE_LR PPCSTATE(spr[SPR_LR])
@@ -8,6 +8,7 @@
 
 #include "Common/Arm64Emitter.h"
 #include "Common/CommonTypes.h"
+#include "Common/JitRegister.h"
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
 #include "Common/PerformanceCounter.h"
@@ -134,6 +135,7 @@ void JitArm64::ClearCache()
   UpdateMemoryOptions();
 
   GenerateAsm();
+  m_code_cache_stats.full_flushes++;
 }
 
 void JitArm64::Shutdown()
@@ -655,6 +657,10 @@ void JitArm64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBlock*
 
   PPCAnalyst::CodeOp* ops = code_buf->codebuffer;
 
+  const bool register_code = JitRegister::IsEnabled();
+  js.instructionHostCode.clear();
+  js.farCodeStart = farcode.GetCodePtr();
+
   const u8* start = GetCodePtr();
   b->checkedEntry = start;
   b->runCount = 0;
@@ -718,6 +724,8 @@ void JitArm64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBlock*
     js.compilerPC = ops[i].address;
     js.op = &ops[i];
     js.instructionNumber = i;
+    if (register_code)
+      js.instructionHostCode.emplace_back(GetCodePtr(), ops[i].address);
     js.instructionsLeft = (code_block.m_num_instructions - 1) - i;
     const GekkoOPInfo* opinfo = ops[i].opinfo;
     js.downcountAmount += opinfo->numCycles;
@@ -855,6 +863,7 @@ void JitArm64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBlock*
 
   b->codeSize = (u32)(GetCodePtr() - start);
   b->originalSize = code_block.m_num_instructions;
+  js.farCodeEnd = farcode.GetCodePtr();
 
   FlushIcache();
   farcode.FlushIcache();
@@ -5,6 +5,7 @@
 #include "Core/PowerPC/JitCommon/JitBase.h"
 
 #include "Common/CommonTypes.h"
+#include "Common/FrameTrace.h"
 #include "Core/ConfigManager.h"
 #include "Core/HW/CPU.h"
 #include "Core/PowerPC/PPCAnalyst.h"
@@ -14,6 +15,7 @@ JitBase* g_jit;
 
 void JitTrampoline(u32 em_address)
 {
+  TRACE_ZONE("JIT compile");
   g_jit->Jit(em_address);
 }
 
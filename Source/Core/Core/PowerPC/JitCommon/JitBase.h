@@ -10,6 +10,8 @@
 
 #include <map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/x64Emitter.h"
@@ -18,6 +20,7 @@
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/JitCommon/JitAsmCommon.h"
 #include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 
 // Use these to control the instruction selection
@@ -96,6 +99,12 @@ protected:
 
     JitBlock* curBlock;
 
+    // Only gathered while JitRegister is enabled: the host code address and the guest address of
+    // every instruction of the current block, and the far code generated for it.
+    std::vector<std::pair<const u8*, u32>> instructionHostCode;
+    const u8* farCodeStart = nullptr;
+    const u8* farCodeEnd = nullptr;
+
     std::unordered_set<u32> fifoWriteAddresses;
     std::unordered_set<u32> pairedQuantizeAddresses;
     std::unordered_set<u32> noSpeculativeConstantsAddresses;
@@ -104,6 +113,8 @@ protected:
   PPCAnalyst::CodeBlock code_block;
   PPCAnalyst::PPCAnalyzer analyzer;
 
+  JitInterface::CodeCacheStats m_code_cache_stats;
+
   bool CanMergeNextInstructions(int count) const;
 
   void UpdateMemoryOptions();
@@ -116,7 +127,11 @@ public:
   JitBase();
   ~JitBase() override;
 
-  static const u8* Dispatch() { return g_jit->GetBlockCache()->Dispatch(); };
+  static const u8* Dispatch()
+  {
+    g_jit->m_code_cache_stats.dispatcher_misses++;
+    return g_jit->GetBlockCache()->Dispatch();
+  }
   virtual JitBaseBlockCache* GetBlockCache() = 0;
 
   virtual void Jit(u32 em_address) = 0;
@@ -125,6 +140,8 @@ public:
 
   virtual bool HandleFault(uintptr_t access_address, SContext* ctx) = 0;
   virtual bool HandleStackFault() { return false; }
+
+  const JitInterface::CodeCacheStats& GetCodeCacheStats() const { return m_code_cache_stats; }
 };
 
 void JitTrampoline(u32 em_address);
@@ -15,10 +15,13 @@
 #include <functional>
 #include <map>
 #include <set>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/JitRegister.h"
+#include "Common/StringUtil.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
@@ -47,12 +50,27 @@ void JitBaseBlockCache::Init()
 {
   JitRegister::Init(SConfig::GetInstance().m_perfDir);
 
+  if (SConfig::GetInstance().bJITFullBlockMap)
+  {
+    void* full_block_map =
+        full_block_map_region.Create(FULL_BLOCK_MAP_ELEMENTS * sizeof(JitBlock*));
+    if (full_block_map)
+    {
+      fast_block_map = static_cast<JitBlock**>(full_block_map);
+      fast_block_map_mask = FULL_BLOCK_MAP_MASK;
+    }
+  }
+
   Clear();
 }
 
 void JitBaseBlockCache::Shutdown()
 {
   JitRegister::Shutdown();
+
+  full_block_map_region.Release();
+  fast_block_map = small_block_map.data();
+  fast_block_map_mask = FAST_BLOCK_MAP_MASK;
 }
 
 // This clears the JIT cache. It's called from JitCache.cpp when the JIT cache
@@ -74,7 +92,10 @@ void JitBaseBlockCache::Clear()
 
   valid_block.ClearAll();
 
-  fast_block_map.fill(nullptr);
+  if (full_block_map_region.GetPointer())
+    full_block_map_region.Clear();
+  else
+    small_block_map.fill(nullptr);
 }
 
 void JitBaseBlockCache::Reset()
@@ -85,7 +106,7 @@ void JitBaseBlockCache::Reset()
 
 JitBlock** JitBaseBlockCache::GetFastBlockMap()
 {
-  return fast_block_map.data();
+  return fast_block_map;
 }
 
 void JitBaseBlockCache::RunOnBlocks(std::function<void(const JitBlock&)> f)
@@ -132,12 +153,54 @@ void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
     LinkBlock(block);
   }
 
+  RegisterBlock(block);
+}
+
+void JitBaseBlockCache::RegisterBlock(const JitBlock& block)
+{
+  if (!JitRegister::IsEnabled())
+    return;
+
+  std::string name;
   if (Symbol* symbol = g_symbolDB.GetSymbolFromAddr(block.effectiveAddress))
-    JitRegister::Register(block.checkedEntry, block.codeSize, "JIT_PPC_%s_%08x",
-                          symbol->function_name.c_str(), block.physicalAddress);
+  {
+    name = StringFromFormat("JIT_PPC_%s_%08x", symbol->function_name.c_str(),
+                            block.physicalAddress);
+  }
   else
-    JitRegister::Register(block.checkedEntry, block.codeSize, "JIT_PPC_%08x",
-                          block.physicalAddress);
+    name = StringFromFormat("JIT_PPC_%08x", block.physicalAddress);
+
+  // Attribute the code of every instruction to "<function>:<n>", where n is the index of the
+  // instruction in its function. Instructions outside of any known function are numbered from the
+  // start of the block instead, or get a line of their own if the block branched backwards.
+  const auto& instructions = m_jit.js.instructionHostCode;
+  std::vector<u32> addresses(instructions.size());
+  std::transform(instructions.begin(), instructions.end(), addresses.begin(),
+                 [](const auto& instruction) { return instruction.second; });
+  const std::vector<Symbol*> symbols = g_symbolDB.GetSymbolsFromAddrs(addresses);
+
+  std::vector<JitRegister::LineEntry> lines;
+  lines.reserve(instructions.size());
+  for (size_t i = 0; i < instructions.size(); ++i)
+  {
+    const u32 address = instructions[i].second;
+    if (symbols[i])
+    {
+      lines.push_back({instructions[i].first, symbols[i]->function_name,
+                       (address - symbols[i]->address) / 4 + 1});
+    }
+    else
+    {
+      const u32 base = address >= block.effectiveAddress ? block.effectiveAddress : address;
+      lines.push_back({instructions[i].first, StringFromFormat("PPC_%08x", base),
+                       (address - base) / 4 + 1});
+    }
+  }
+
+  JitRegister::RegisterWithLines(block.checkedEntry, block.checkedEntry + block.codeSize, lines,
+                                 "%s", name.c_str());
+  if (m_jit.js.farCodeEnd != m_jit.js.farCodeStart)
+    JitRegister::Register(m_jit.js.farCodeStart, m_jit.js.farCodeEnd, "%s_far", name.c_str());
 }
 
 JitBlock* JitBaseBlockCache::GetBlockFromStartAddress(u32 addr, u32 msr)
@@ -263,6 +326,38 @@ void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
   }
 }
 
+size_t JitBaseBlockCache::EraseHostCodeRange(const u8* start, const u8* end)
+{
+  const u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
+  size_t erased = 0;
+  auto iter = block_map.begin();
+  while (iter != block_map.end())
+  {
+    JitBlock& block = iter->second;
+    if (block.checkedEntry < start || block.checkedEntry >= end)
+    {
+      ++iter;
+      continue;
+    }
+
+    for (u32 addr : block.physical_addresses)
+    {
+      auto range = block_range_map.find(addr & range_mask);
+      if (range == block_range_map.end())
+        continue;
+      range->second.erase(&block);
+      if (range->second.empty())
+        block_range_map.erase(range);
+    }
+
+    // This also unlinks all blocks that jump to this one.
+    DestroyBlock(block);
+    iter = block_map.erase(iter);
+    ++erased;
+  }
+  return erased;
+}
+
 u32* JitBaseBlockCache::GetBlockBitSet() const
 {
   return valid_block.m_valid_block.get();
@@ -379,5 +474,5 @@ JitBlock* JitBaseBlockCache::MoveBlockIntoFastCache(u32 addr, u32 msr)
 
 size_t JitBaseBlockCache::FastLookupIndexForAddress(u32 address)
 {
-  return (address >> 2) & FAST_BLOCK_MAP_MASK;
+  return (address >> 2) & fast_block_map_mask;
 }
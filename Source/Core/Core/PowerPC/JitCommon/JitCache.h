@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/MemArena.h"
 
 class JitBase;
 
@@ -117,6 +118,11 @@ public:
 
   static constexpr u32 FAST_BLOCK_MAP_ELEMENTS = 0x10000;
   static constexpr u32 FAST_BLOCK_MAP_MASK = FAST_BLOCK_MAP_ELEMENTS - 1;
+  // The full block map is indexed by the low 29 bits of an instruction's address, so MEM1 and
+  // MEM2 never collide. The cached and uncached mirrors of an address share an entry, which the
+  // dispatcher's address check tells apart like any other collision.
+  static constexpr u32 FULL_BLOCK_MAP_ELEMENTS = 0x8000000;
+  static constexpr u32 FULL_BLOCK_MAP_MASK = FULL_BLOCK_MAP_ELEMENTS - 1;
 
   explicit JitBaseBlockCache(JitBase& jit);
   virtual ~JitBaseBlockCache();
@@ -128,6 +134,8 @@ public:
 
   // Code Cache
   JitBlock** GetFastBlockMap();
+  // The fast block map is indexed with (PC >> 2) & GetFastBlockMapMask().
+  u32 GetFastBlockMapMask() const { return fast_block_map_mask; }
   void RunOnBlocks(std::function<void(const JitBlock&)> f);
 
   JitBlock* AllocateBlock(u32 em_address);
@@ -146,6 +154,9 @@ public:
 
   void InvalidateICache(u32 address, u32 length, bool forced);
   void ErasePhysicalRange(u32 address, u32 length);
+  // Removes all blocks whose host code starts in [start, end), so that the memory can be reused.
+  // Returns the number of removed blocks.
+  size_t EraseHostCodeRange(const u8* start, const u8* end);
 
   u32* GetBlockBitSet() const;
 
@@ -160,6 +171,7 @@ private:
   void LinkBlock(JitBlock& block);
   void UnlinkBlock(const JitBlock& block);
   void DestroyBlock(JitBlock& block);
+  void RegisterBlock(const JitBlock& block);
 
   JitBlock* MoveBlockIntoFastCache(u32 em_address, u32 msr);
 
@@ -186,5 +198,10 @@ private:
 
   // This array is indexed with the masked PC and likely holds the correct block id.
   // This is used as a fast cache of block_map used in the assembly dispatcher.
-  std::array<JitBlock*, FAST_BLOCK_MAP_ELEMENTS> fast_block_map;  // start_addr & mask -> number
+  std::array<JitBlock*, FAST_BLOCK_MAP_ELEMENTS> small_block_map;  // start_addr & mask -> number
+  // Replaces small_block_map if bJITFullBlockMap is set and the address space can be reserved.
+  LazyMemoryRegion full_block_map_region;
+
+  JitBlock** fast_block_map = small_block_map.data();
+  u32 fast_block_map_mask = FAST_BLOCK_MAP_MASK;
 };
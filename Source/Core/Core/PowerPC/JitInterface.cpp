@@ -9,6 +9,7 @@
 #include <cstdio>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -19,9 +20,11 @@
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/File.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 
 #include "Core/Core.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
@@ -91,9 +94,16 @@ void WriteProfileResults(const std::string& filename)
   }
   fprintf(f.GetHandle(), "origAddr\tblkName\trunCount\tcost\ttimeCost\tpercent\ttimePercent\tOvAlli"
                          "nBlkTime(ms)\tblkCodeSize\n");
-  for (auto& stat : prof_stats.block_stats)
+  std::vector<u32> addresses;
+  addresses.reserve(prof_stats.block_stats.size());
+  for (const auto& stat : prof_stats.block_stats)
+    addresses.push_back(stat.addr);
+  const std::vector<Symbol*> symbols = g_symbolDB.GetSymbolsFromAddrs(addresses);
+
+  for (size_t i = 0; i < prof_stats.block_stats.size(); ++i)
   {
-    std::string name = g_symbolDB.GetDescription(stat.addr);
+    const auto& stat = prof_stats.block_stats[i];
+    const std::string name = symbols[i] ? symbols[i]->name : " --- ";
     double percent = 100.0 * (double)stat.cost / (double)prof_stats.cost_sum;
     double timePercent = 100.0 * (double)stat.tick_counter / (double)prof_stats.timecost_sum;
     fprintf(f.GetHandle(),
@@ -174,6 +184,14 @@ int GetHostCode(u32* address, const u8** code, u32* code_size)
   return 0;
 }
 
+CodeCacheStats GetCodeCacheStats()
+{
+  if (!g_jit)
+    return {};
+
+  return g_jit->GetCodeCacheStats();
+}
+
 bool HandleFault(uintptr_t access_address, SContext* ctx)
 {
   // Prevent nullptr dereference on a crash with no JIT present
@@ -182,6 +200,16 @@ bool HandleFault(uintptr_t access_address, SContext* ctx)
     return false;
   }
 
+  // Pages that are translated through the page table are mapped into the logical view on their
+  // first access, after which the faulting access is simply retried.
+  const auto logical_base = reinterpret_cast<uintptr_t>(Memory::logical_base);
+  if (logical_base && access_address >= logical_base &&
+      access_address - logical_base < 0x100000000 && Core::IsCPUThread() &&
+      PowerPC::MapPageTableTranslation(static_cast<u32>(access_address - logical_base)))
+  {
+    return true;
+  }
+
   return g_jit->HandleFault(access_address, ctx);
 }
 
@@ -257,6 +285,14 @@ void Shutdown()
 {
   if (g_jit)
   {
+    const CodeCacheStats& stats = g_jit->GetCodeCacheStats();
+    INFO_LOG(DYNA_REC,
+             "JIT code cache: %" PRIu64 " dispatcher misses, %" PRIu64 " full flushes, %" PRIu64
+             " evicted generations with %" PRIu64 " blocks",
+             stats.dispatcher_misses, stats.full_flushes, stats.evicted_generations,
+             stats.evicted_blocks);
+    PPCTables::PrintFallbackCounts();
+
     g_jit->Shutdown();
     delete g_jit;
     g_jit = nullptr;
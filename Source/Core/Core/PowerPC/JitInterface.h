@@ -32,6 +32,20 @@ void WriteProfileResults(const std::string& filename);
 void GetProfileResults(ProfileStats* prof_stats);
 int GetHostCode(u32* address, const u8** code, u32* code_size);
 
+struct CodeCacheStats
+{
+  // Generations of the code cache that were evicted to make room for new blocks, and the number
+  // of blocks that were in them.
+  u64 evicted_generations = 0;
+  u64 evicted_blocks = 0;
+  // Number of times the whole code cache was cleared.
+  u64 full_flushes = 0;
+  // Number of times the assembly dispatcher didn't find the block in the fast block map and fell
+  // back to JitBaseBlockCache::Dispatch, including blocks that still had to be compiled.
+  u64 dispatcher_misses = 0;
+};
+CodeCacheStats GetCodeCacheStats();
+
 // Memory Utilities
 bool HandleFault(uintptr_t access_address, SContext* ctx);
 bool HandleStackFault();
@@ -958,6 +958,14 @@ void SDRUpdated()
   }
   PowerPC::ppcState.pagetable_base = htaborg << 16;
   PowerPC::ppcState.pagetable_hashmask = ((htabmask << 10) | 0x3ff);
+
+  // The page table has moved, so none of the mapped translations are valid anymore.
+  Memory::UnmapLogicalPages(0, 0);
+}
+
+void SRUpdated(u32 index)
+{
+  Memory::UnmapLogicalPages(index << 28, 0xF0000000);
 }
 
 enum TLBLookupResult
@@ -1044,6 +1052,9 @@ void InvalidateTLBEntry(u32 address)
   TLBEntry& tlbe_i = ppcState.tlb[1][entry_index];
   tlbe_i.tag[0] = TLBEntry::INVALID_TAG;
   tlbe_i.tag[1] = TLBEntry::INVALID_TAG;
+
+  // Mapped pages behave like TLB entries that are never evicted.
+  Memory::UnmapLogicalPages(address, HW_PAGE_INDEX_MASK << HW_PAGE_INDEX_SHIFT);
 }
 
 // Page Address Translation
@@ -1136,6 +1147,53 @@ static TranslateAddressResult TranslatePageAddress(const u32 address, const XChe
   return TranslateAddressResult{TranslateAddressResult::PAGE_FAULT, 0};
 }
 
+// Returns whether the C bit is set in the data TLB entry for the given address.
+static bool IsTLBPageChanged(u32 address)
+{
+  const u32 tag = address >> HW_PAGE_INDEX_SHIFT;
+  const TLBEntry& tlbe = ppcState.tlb[0][tag & HW_PAGE_INDEX_MASK];
+  for (size_t i = 0; i < TLB_WAYS; ++i)
+  {
+    if (tlbe.tag[i] == tag)
+    {
+      UPTE2 PTE2;
+      PTE2.Hex = tlbe.pte[i];
+      return PTE2.C;
+    }
+  }
+  return false;
+}
+
+bool MapPageTableTranslation(u32 address)
+{
+  if (!UReg_MSR(MSR).DR)
+    return false;
+
+  // BAT translations take priority, so the access faulted because it isn't to RAM or because
+  // the memory is watched.
+  u32 bat_address = address;
+  if (TranslateBatAddess(dbat_table, &bat_address))
+    return false;
+
+  const u32 page = address & ~(HW_PAGE_SIZE - 1);
+  if (memchecks.OverlapsMemcheck(page, HW_PAGE_SIZE))
+    return false;
+
+  // Pages are mapped read-only until their C bit is set, so that the first write to them
+  // faults again and sets it. An access to a writable page can't fault.
+  bool writable = false;
+  const bool mapped = Memory::IsLogicalPageMapped(page, &writable);
+  if (mapped && writable)
+    return false;
+
+  const TranslateAddressResult translated =
+      TranslatePageAddress(page, mapped ? FLAG_WRITE : FLAG_READ);
+  if (translated.result != TranslateAddressResult::PAGE_TABLE_TRANSLATED)
+    return false;
+
+  return Memory::MapLogicalPage(page, translated.address, mapped || IsTLBPageChanged(page));
+}
+
 static void UpdateBATs(BatTable& bat_table, u32 base_spr)
 {
   // TODO: Separate BATs for MSR.PR==0 and MSR.PR==1
@@ -1198,9 +1256,14 @@ static void UpdateBATs(BatTable& bat_table, u32 base_spr)
                  physical_address < 0xE0000000 + Memory::L1_CACHE_SIZE)
           valid_bit |= BAT_PHYSICAL_BIT;
 
-        // Fastmem doesn't support memchecks, so disable it for all overlapping virtual pages.
-        if (PowerPC::memchecks.OverlapsMemcheck(virtual_address, BAT_PAGE_SIZE))
-          valid_bit &= ~BAT_PHYSICAL_BIT;
+        // Inline fast paths don't check memchecks, so they must not be used for overlapping
+        // virtual pages. Fastmem accesses are still fine: the watched host pages are protected
+        // in the logical view, and the faulting accesses get backpatched to the slow path.
+        if ((valid_bit & BAT_PHYSICAL_BIT) &&
+            PowerPC::memchecks.OverlapsMemcheck(virtual_address, BAT_PAGE_SIZE))
+        {
+          valid_bit = (valid_bit & ~BAT_PHYSICAL_BIT) | BAT_WATCHED_BIT;
+        }
 
         // (BEPI | j) == (BEPI & ~BL) | (j & BL).
         bat_table[virtual_address >> BAT_INDEX_SHIFT] = physical_address | valid_bit;
@@ -1220,7 +1283,7 @@ static void UpdateFakeMMUBat(BatTable& bat_table, u32 start_addr)
     u32 flags = BAT_MAPPED_BIT | BAT_PHYSICAL_BIT;
 
     if (PowerPC::memchecks.OverlapsMemcheck(e_address << BAT_INDEX_SHIFT, BAT_PAGE_SIZE))
-      flags &= ~BAT_PHYSICAL_BIT;
+      flags = (flags & ~BAT_PHYSICAL_BIT) | BAT_WATCHED_BIT;
 
     bat_table[e_address] = p_address | flags;
   }
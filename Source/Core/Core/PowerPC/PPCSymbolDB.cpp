@@ -4,7 +4,9 @@
 
 #include "Core/PowerPC/PPCSymbolDB.h"
 
+#include <algorithm>
 #include <map>
+#include <numeric>
 #include <string>
 #include <utility>
 #include <vector>
@@ -50,6 +52,7 @@ Symbol* PPCSymbolDB::AddFunction(u32 start_addr)
     return nullptr;
 
   functions[start_addr] = std::move(symbol);
+  m_symbols_changed.store(true, std::memory_order_release);
   Symbol* ptr = &functions[start_addr];
   ptr->type = Symbol::Type::Function;
   checksumToFunction[ptr->hash].insert(ptr);
@@ -59,6 +62,7 @@ Symbol* PPCSymbolDB::AddFunction(u32 start_addr)
 void PPCSymbolDB::AddKnownSymbol(u32 startAddr, u32 size, const std::string& name,
                                  Symbol::Type type)
 {
+  m_symbols_changed.store(true, std::memory_order_release);
   XFuncMap::iterator iter = functions.find(startAddr);
   if (iter != functions.end())
   {
@@ -88,22 +92,88 @@ void PPCSymbolDB::AddKnownSymbol(u32 startAddr, u32 size, const std::string& nam
   }
 }
 
-Symbol* PPCSymbolDB::GetSymbolFromAddr(u32 addr)
+void PPCSymbolDB::UpdateIndex()
 {
-  XFuncMap::iterator it = functions.find(addr);
-  if (it != functions.end())
+  if (!m_symbols_changed.load(std::memory_order_acquire))
+    return;
+
+  std::lock_guard<std::mutex> lock(m_index_lock);
+  if (!m_symbols_changed.load(std::memory_order_acquire))
+    return;
+
+  m_start_addresses.clear();
+  m_start_symbols.clear();
+  m_ranges.clear();
+
+  // When symbols overlap, an address belongs to the one that starts first, unless it's the start
+  // of another symbol. Since the symbols are sorted by address, the part of a symbol that isn't
+  // covered by any earlier symbol is the part after the furthest end seen so far.
+  u64 covered_end = 0;
+  for (auto& entry : functions)
   {
-    return &it->second;
+    Symbol& symbol = entry.second;
+    m_start_addresses.push_back(entry.first);
+    m_start_symbols.push_back(&symbol);
+
+    if (symbol.size <= 0)
+      continue;
+    const u64 start = std::max<u64>(symbol.address, covered_end);
+    const u64 end = std::min<u64>(u64(symbol.address) + symbol.size, u64(1) << 32);
+    if (start < end)
+      m_ranges.push_back({static_cast<u32>(start), static_cast<u32>(end - 1), &symbol});
+    covered_end = std::max(covered_end, end);
   }
-  else
+
+  m_symbols_changed.store(false, std::memory_order_release);
+}
+
+// The hints are positions in the sorted arrays that are known to be at or before the result.
+Symbol* PPCSymbolDB::LookupIndex(u32 addr, size_t* start_hint, size_t* range_hint) const
+{
+  const auto start = std::lower_bound(m_start_addresses.begin() + *start_hint,
+                                      m_start_addresses.end(), addr);
+  *start_hint = start - m_start_addresses.begin();
+  if (start != m_start_addresses.end() && *start == addr)
+    return m_start_symbols[*start_hint];
+
+  const auto range =
+      std::upper_bound(m_ranges.begin() + *range_hint, m_ranges.end(), addr,
+                       [](u32 address, const SymbolRange& r) { return address < r.start; });
+  if (range == m_ranges.begin())
+    return nullptr;
+  *range_hint = range - m_ranges.begin() - 1;
+  const SymbolRange& containing = *(range - 1);
+  return addr <= containing.last ? containing.symbol : nullptr;
+}
+
+Symbol* PPCSymbolDB::GetSymbolFromAddr(u32 addr)
+{
+  UpdateIndex();
+  size_t start_hint = 0;
+  size_t range_hint = 0;
+  return LookupIndex(addr, &start_hint, &range_hint);
+}
+
+std::vector<Symbol*> PPCSymbolDB::GetSymbolsFromAddrs(const std::vector<u32>& addrs)
+{
+  UpdateIndex();
+
+  // Resolve the addresses in ascending order, so that every search only needs to look at the
+  // part of the index after the previous result.
+  std::vector<size_t> order(addrs.size());
+  std::iota(order.begin(), order.end(), 0);
+  if (!std::is_sorted(addrs.begin(), addrs.end()))
   {
-    for (auto& p : functions)
-    {
-      if (addr >= p.second.address && addr < p.second.address + p.second.size)
-        return &p.second;
-    }
+    std::sort(order.begin(), order.end(),
+              [&addrs](size_t a, size_t b) { return addrs[a] < addrs[b]; });
   }
-  return nullptr;
+
+  std::vector<Symbol*> symbols(addrs.size());
+  size_t start_hint = 0;
+  size_t range_hint = 0;
+  for (size_t i : order)
+    symbols[i] = LookupIndex(addrs[i], &start_hint, &range_hint);
+  return symbols;
 }
 
 std::string PPCSymbolDB::GetDescription(u32 addr)
@@ -189,10 +259,11 @@ void PPCSymbolDB::PrintCallers(u32 funcAddr) const
 void PPCSymbolDB::LogFunctionCall(u32 addr)
 {
   // u32 from = PC;
-  XFuncMap::iterator iter = functions.find(addr);
-  if (iter != functions.end())
+  UpdateIndex();
+  const auto iter = std::lower_bound(m_start_addresses.begin(), m_start_addresses.end(), addr);
+  if (iter != m_start_addresses.end() && *iter == addr)
   {
-    Symbol& f = iter->second;
+    Symbol& f = *m_start_symbols[iter - m_start_addresses.begin()];
     f.numCalls++;
   }
 }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -27,6 +28,9 @@ public:
                       Symbol::Type type = Symbol::Type::Function);
 
   Symbol* GetSymbolFromAddr(u32 addr) override;
+  // Same as calling GetSymbolFromAddr for every address, but much cheaper, especially when the
+  // addresses are mostly sorted.
+  std::vector<Symbol*> GetSymbolsFromAddrs(const std::vector<u32>& addrs);
 
   std::string GetDescription(u32 addr);
 
@@ -41,7 +45,25 @@ public:
   void LogFunctionCall(u32 addr);
 
 private:
+  // A part of the address space in which GetSymbolFromAddr returns the same symbol.
+  struct SymbolRange
+  {
+    u32 start;
+    u32 last;
+    Symbol* symbol;
+  };
+
+  void UpdateIndex();
+  Symbol* LookupIndex(u32 addr, size_t* start_hint, size_t* range_hint) const;
+
   DebugInterface* debugger;
+
+  // Sorted arrays that are rebuilt from the symbol map whenever it changes, since the map is slow
+  // to search for the symbol that contains an address.
+  std::mutex m_index_lock;
+  std::vector<u32> m_start_addresses;
+  std::vector<Symbol*> m_start_symbols;
+  std::vector<SymbolRange> m_ranges;
 };
 
 extern PPCSymbolDB g_symbolDB;
@@ -165,6 +165,24 @@ void PrintInstructionRunCounts()
   }
 }
 
+void PrintFallbackCounts()
+{
+  typedef std::pair<const char*, u64> OpInfo;
+  std::vector<OpInfo> temp;
+  for (size_t i = 0; i < m_numInstructions; ++i)
+  {
+    GekkoOPInfo* pInst = m_allInstructions[i];
+    if (pInst->fallbackCount != 0)
+      temp.emplace_back(pInst->opname, pInst->fallbackCount);
+    pInst->fallbackCount = 0;
+  }
+  std::sort(temp.begin(), temp.end(),
+            [](const OpInfo& a, const OpInfo& b) { return a.second > b.second; });
+
+  for (auto& inst : temp)
+    INFO_LOG(DYNA_REC, "Interpreter fallbacks for %s: %" PRIu64, inst.first, inst.second);
+}
+
 void LogCompiledInstructions()
 {
   static unsigned int time = 0;
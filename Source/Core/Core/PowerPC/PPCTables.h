@@ -94,6 +94,8 @@ struct GekkoOPInfo
   u64 runCount;
   int compileCount;
   u32 lastUse;
+  // Number of times the JIT has run this instruction through the interpreter.
+  u64 fallbackCount;
 };
 extern std::array<GekkoOPInfo*, 64> m_infoTable;
 extern std::array<GekkoOPInfo*, 1024> m_infoTable4;
@@ -115,6 +117,7 @@ bool UsesFPU(UGeckoInstruction _inst);
 
 void CountInstruction(UGeckoInstruction _inst);
 void PrintInstructionRunCounts();
+void PrintFallbackCounts();
 void LogCompiledInstructions();
 const char* GetInstructionName(UGeckoInstruction _inst);
 }  // namespace PPCTables
@@ -23,6 +23,7 @@
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/Interpreter/Interpreter.h"
 #include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/Profiler.h"
 
 namespace PowerPC
 {
@@ -86,6 +87,8 @@ void DoState(PointerWrap& p)
   p.Do(ppcState.xer_ca);
   p.Do(ppcState.xer_so_ov);
   p.Do(ppcState.xer_stringctrl);
+  p.Do(ppcState.reserve_address);
+  p.Do(ppcState.reserve);
   p.DoArray(ppcState.ps);
   p.DoArray(ppcState.sr);
   p.DoArray(ppcState.spr);
@@ -133,6 +136,7 @@ static void ResetRegisters()
   ppcState.pc = 0;
   ppcState.npc = 0;
   ppcState.Exceptions = 0;
+  ppcState.reserve = false;
   for (auto& v : ppcState.cr_val)
     v = 0x8000000000000001;
 
@@ -219,6 +223,7 @@ void Init(int cpu_core)
 
   InitializeCPUCore(cpu_core);
   ppcState.iCache.Init();
+  Profiler::Init();
 
   if (SConfig::GetInstance().bEnableDebugging)
     breakpoints.ClearAllTemporary();
@@ -249,6 +254,7 @@ void ScheduleInvalidateCacheThreadSafe(u32 address)
 
 void Shutdown()
 {
+  Profiler::Shutdown();
   InjectExternalCPUCore(nullptr);
   JitInterface::Shutdown();
   s_interpreter->Shutdown();
@@ -93,6 +93,10 @@ struct PowerPCState
   // lscbx
   u16 xer_stringctrl;
 
+  // Reservation set by lwarx and cleared by a successful stwcx.
+  u32 reserve_address;
+  bool reserve;
+
 #if _M_X86_64
   // This member exists for the purpose of an assertion in x86 JitBase.cpp
   // that its offset <= 0x100.  To minimize code size on x86, we want as much
@@ -273,10 +277,16 @@ void ClearCacheLine(u32 address);  // Zeroes 32 bytes; address should be 32-byte
 
 // TLB functions
 void SDRUpdated();
+void SRUpdated(u32 index);
 void InvalidateTLBEntry(u32 address);
 void DBATUpdated();
 void IBATUpdated();
 
+// Called when a fastmem access to the logical view faults. If the address is translated through
+// the page table, its page gets mapped so that the access can be retried. Returns false if the
+// access has to take the slow path instead.
+bool MapPageTableTranslation(u32 address);
+
 // Result changes based on the BAT registers and MSR.DR.  Returns whether
 // it's safe to optimize a read or write to this address to an unguarded
 // memory access.  Does not consider page tables.
@@ -296,7 +306,10 @@ constexpr int BAT_INDEX_SHIFT = 17;
 constexpr u32 BAT_PAGE_SIZE = 1 << BAT_INDEX_SHIFT;
 constexpr u32 BAT_MAPPED_BIT = 0x1;
 constexpr u32 BAT_PHYSICAL_BIT = 0x2;
-constexpr u32 BAT_RESULT_MASK = UINT32_C(~0x3);
+// Set instead of BAT_PHYSICAL_BIT for RAM pages that overlap a memcheck. These pages are still
+// mapped into the fastmem logical view, but with the watched host pages protected.
+constexpr u32 BAT_WATCHED_BIT = 0x4;
+constexpr u32 BAT_RESULT_MASK = UINT32_C(~0x7);
 using BatTable = std::array<u32, 1 << (32 - BAT_INDEX_SHIFT)>;  // 128 KB
 extern BatTable ibat_table;
 extern BatTable dbat_table;
@@ -4,16 +4,233 @@
 
 #include "Core/PowerPC/Profiler.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <map>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/Flag.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+#include "Common/Swap.h"
+#include "Common/SymbolDB.h"
+#include "Common/Thread.h"
+#include "Core/HW/CPU.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+#include "Core/PowerPC/PowerPC.h"
 
 namespace Profiler
 {
 bool g_ProfileBlocks;
 
+// Deeper stacks are truncated, like in Dolphin_Debugger::GetCallstack.
+static constexpr size_t MAX_STACK_DEPTH = 20;
+
+// Guards starting and stopping the sampling thread.
+static std::mutex s_sampling_lock;
+static std::thread s_sampling_thread;
+static Common::Flag s_sampling;
+static std::mutex s_samples_lock;
+// Held while taking a sample, so that the CPU state and RAM don't go away in the meantime.
+static std::mutex s_cpu_lock;
+static bool s_cpu_initialized = false;
+// Raw guest addresses, innermost first, and how many times each stack was sampled.
+static std::map<std::vector<u32>, u64> s_samples;
+
 void WriteProfileResults(const std::string& filename)
 {
   JitInterface::WriteProfileResults(filename);
 }
 
+void Init()
+{
+  std::lock_guard<std::mutex> lock(s_cpu_lock);
+  s_cpu_initialized = true;
+}
+
+void Shutdown()
+{
+  {
+    std::lock_guard<std::mutex> lock(s_cpu_lock);
+    s_cpu_initialized = false;
+  }
+
+  // Sampling can't be started again from here on, so the thread is always joined before it is
+  // destroyed at exit.
+  StopSampling();
+}
+
+// This runs on the sampling thread, so it reads RAM directly instead of going through the MMU.
+// Returns false for addresses that aren't in RAM, which ends the stack walk.
+static bool ReadStackWord(u32 address, u32* value)
+{
+  if (address & 3)
+    return false;
+
+  const u8* pointer = nullptr;
+  address &= 0x3FFFFFFF;
+  if (address < Memory::REALRAM_SIZE)
+    pointer = Memory::m_pRAM + address;
+  else if (Memory::m_pEXRAM && (address >> 28) == 0x1 &&
+           (address & 0x0FFFFFFF) < Memory::EXRAM_SIZE)
+    pointer = Memory::m_pEXRAM + (address & 0x0FFFFFFF);
+
+  if (!pointer)
+    return false;
+  *value = Common::swap32(pointer);
+  return true;
+}
+
+static std::vector<u32> TakeSample()
+{
+  // These are read while the CPU thread is running, so they might be slightly out of sync with
+  // each other. That only makes a few samples inaccurate.
+  const PowerPC::PowerPCState& state = PowerPC::ppcState;
+  std::vector<u32> stack{state.pc, state.spr[SPR_LR]};
+
+  // Same walk as Dolphin_Debugger::GetCallstack. If the function has already saved LR in its
+  // caller's frame, the first saved address is LR again.
+  u32 frame;
+  if (!ReadStackWord(state.gpr[1], &frame))
+    return stack;
+
+  u32 return_address;
+  while (stack.size() < MAX_STACK_DEPTH && frame && ReadStackWord(frame + 4, &return_address))
+  {
+    if (stack.size() != 2 || return_address != stack.back())
+      stack.push_back(return_address);
+    if (!ReadStackWord(frame, &frame))
+      break;
+  }
+  return stack;
+}
+
+static void SamplingThread(u32 samples_per_second)
+{
+  Common::SetCurrentThreadName("Guest profiler");
+
+  const auto period = std::chrono::microseconds(1000000 / samples_per_second);
+  auto next_sample = std::chrono::steady_clock::now();
+  while (s_sampling.IsSet())
+  {
+    next_sample += period;
+    std::this_thread::sleep_until(next_sample);
+    // Don't try to catch up after the thread didn't get to run for a while.
+    next_sample = std::max(next_sample, std::chrono::steady_clock::now() - period);
+
+    std::vector<u32> stack;
+    {
+      std::lock_guard<std::mutex> lock(s_cpu_lock);
+      if (!s_cpu_initialized || CPU::GetState() != CPU::State::Running)
+        continue;
+      stack = TakeSample();
+    }
+
+    std::lock_guard<std::mutex> lock(s_samples_lock);
+    ++s_samples[std::move(stack)];
+  }
+}
+
+void StartSampling(u32 samples_per_second)
+{
+  std::lock_guard<std::mutex> lock(s_sampling_lock);
+  {
+    std::lock_guard<std::mutex> cpu_lock(s_cpu_lock);
+    if (!s_cpu_initialized)
+      return;
+  }
+
+  if (s_sampling.TestAndSet())
+  {
+    samples_per_second = std::clamp<u32>(samples_per_second, 1, 100000);
+    s_sampling_thread = std::thread(SamplingThread, samples_per_second);
+    INFO_LOG(POWERPC, "Started sampling guest code %u times per second", samples_per_second);
+  }
+}
+
+void StopSampling()
+{
+  std::lock_guard<std::mutex> lock(s_sampling_lock);
+  if (!s_sampling.TestAndClear())
+    return;
+
+  s_sampling_thread.join();
+  INFO_LOG(POWERPC, "Stopped sampling guest code");
+}
+
+bool IsSampling()
+{
+  return s_sampling.IsSet();
+}
+
+void ClearSamples()
+{
+  std::lock_guard<std::mutex> lock(s_samples_lock);
+  s_samples.clear();
+}
+
+static std::string GetFrameName(u32 address, const Symbol* symbol)
+{
+  if (!symbol)
+    return StringFromFormat("%08x", address);
+
+  // ';' separates frames in the collapsed stack format.
+  std::string name = symbol->name;
+  std::replace(name.begin(), name.end(), ';', ':');
+  return name;
+}
+
+bool WriteSampledStacks(const std::string& filename)
+{
+  std::map<std::vector<u32>, u64> samples;
+  {
+    std::lock_guard<std::mutex> lock(s_samples_lock);
+    samples = s_samples;
+  }
+
+  // Symbolize every distinct address at once.
+  std::vector<u32> addresses;
+  for (const auto& sample : samples)
+    addresses.insert(addresses.end(), sample.first.begin(), sample.first.end());
+  std::sort(addresses.begin(), addresses.end());
+  addresses.erase(std::unique(addresses.begin(), addresses.end()), addresses.end());
+  const std::vector<Symbol*> symbols = g_symbolDB.GetSymbolsFromAddrs(addresses);
+  const auto get_symbol = [&](u32 address) {
+    const auto iter = std::lower_bound(addresses.begin(), addresses.end(), address);
+    return symbols[iter - addresses.begin()];
+  };
+
+  // Stacks that only differ in addresses within the same functions are merged.
+  std::map<std::string, u64> stacks;
+  for (const auto& sample : samples)
+  {
+    std::string line;
+    for (auto iter = sample.first.rbegin(); iter != sample.first.rend(); ++iter)
+    {
+      if (!line.empty())
+        line += ';';
+      line += GetFrameName(*iter, get_symbol(*iter));
+    }
+    stacks[line] += sample.second;
+  }
+
+  File::IOFile f(filename, "w");
+  if (!f)
+  {
+    ERROR_LOG(POWERPC, "Failed to open %s", filename.c_str());
+    return false;
+  }
+  for (const auto& stack : stacks)
+    fprintf(f.GetHandle(), "%s %" PRIu64 "\n", stack.first.c_str(), stack.second);
+  return true;
+}
+
 }  // namespace
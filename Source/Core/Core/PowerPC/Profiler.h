@@ -68,4 +68,21 @@ namespace Profiler
 extern bool g_ProfileBlocks;
 
 void WriteProfileResults(const std::string& filename);
+
+// Sampling profiler. Unlike block profiling, this doesn't need any instrumentation in the JIT: a
+// host thread periodically samples the guest PC, LR and stack chain while the CPU is running, so
+// the samples are spread over guest code according to the host time spent in it. The PC is only
+// updated at block boundaries by the JITs, which is precise enough to attribute time to functions.
+//
+// Sampling can only be started while emulation is running, and stops when it is shut down.
+void Init();
+void Shutdown();
+void StartSampling(u32 samples_per_second = 1000);
+void StopSampling();
+bool IsSampling();
+void ClearSamples();
+// Writes the samples aggregated by guest symbol, in the collapsed stack format used by
+// flamegraph.pl and most other flame graph tools: one line per distinct call stack, with the
+// outermost function first and the number of samples last.
+bool WriteSampledStacks(const std::string& filename);
 }
@@ -11,6 +11,7 @@
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
@@ -115,6 +116,11 @@ bool Compare(u32 address, u32 size, const MEGASignature& sig)
   }
   return true;
 }
+
+u64 GetIndexKey(u32 size, u32 first_instruction)
+{
+  return static_cast<u64>(size) << 32 | first_instruction;
+}
 }  // Anonymous namespace
 
 MEGASignatureDB::MEGASignatureDB() = default;
@@ -123,6 +129,7 @@ MEGASignatureDB::~MEGASignatureDB() = default;
 void MEGASignatureDB::Clear()
 {
   m_signatures.clear();
+  m_index.clear();
 }
 
 bool MEGASignatureDB::Load(const std::string& file_path)
@@ -148,9 +155,21 @@ bool MEGASignatureDB::Load(const std::string& file_path)
       WARN_LOG(OSHLE, "MEGA database failed to parse line %zu", i);
     }
   }
+  UpdateIndex();
   return true;
 }
 
+void MEGASignatureDB::UpdateIndex()
+{
+  m_index.clear();
+  for (size_t i = 0; i < m_signatures.size(); ++i)
+  {
+    const MEGASignature& sig = m_signatures[i];
+    const u32 size = static_cast<u32>(sig.code.size() * sizeof(u32));
+    m_index[GetIndexKey(size, sig.code[0])].push_back(i);
+  }
+}
+
 bool MEGASignatureDB::Save(const std::string& file_path) const
 {
   ERROR_LOG(OSHLE, "MEGA database save unsupported yet.");
@@ -159,11 +178,41 @@ bool MEGASignatureDB::Save(const std::string& file_path) const
 
 void MEGASignatureDB::Apply(PPCSymbolDB* symbol_db) const
 {
+  static const std::vector<size_t> s_no_signatures;
+  const auto get_candidates = [this](u64 key) -> const std::vector<size_t>& {
+    const auto iter = m_index.find(key);
+    return iter != m_index.end() ? iter->second : s_no_signatures;
+  };
+
   for (auto& it : symbol_db->AccessSymbols())
   {
     auto& symbol = it.second;
-    for (const auto& sig : m_signatures)
+    if (symbol.size <= 0 || symbol.size % sizeof(u32) != 0)
+      continue;
+
+    // Only the signatures with the same size and first instruction can match. Try them in the
+    // order of the database, like a linear search would.
+    const u32 first_instruction = PowerPC::HostRead_U32(symbol.address);
+    const std::vector<size_t>& exact =
+        first_instruction != 0 ? get_candidates(GetIndexKey(symbol.size, first_instruction)) :
+                                 s_no_signatures;
+    const std::vector<size_t>& wildcard = get_candidates(GetIndexKey(symbol.size, 0));
+    auto exact_iter = exact.begin();
+    auto wildcard_iter = wildcard.begin();
+    while (exact_iter != exact.end() || wildcard_iter != wildcard.end())
     {
+      size_t index;
+      if (wildcard_iter == wildcard.end() ||
+          (exact_iter != exact.end() && *exact_iter < *wildcard_iter))
+      {
+        index = *exact_iter++;
+      }
+      else
+      {
+        index = *wildcard_iter++;
+      }
+
+      const MEGASignature& sig = m_signatures[index];
       if (Compare(symbol.address, symbol.size, sig))
       {
         symbol.name = sig.name;
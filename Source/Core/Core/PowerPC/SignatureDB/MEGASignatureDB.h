@@ -5,6 +5,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -53,5 +54,9 @@ public:
   bool Add(u32 startAddr, u32 size, const std::string& name) override;
 
 private:
+  void UpdateIndex();
+
   std::vector<MEGASignature> m_signatures;
+  // Indices of the signatures, keyed by their size and first instruction (0 for a wildcard).
+  std::unordered_map<u64, std::vector<size_t>> m_index;
 };
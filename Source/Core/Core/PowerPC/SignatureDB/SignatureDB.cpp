@@ -4,6 +4,7 @@
 
 #include "Core/PowerPC/SignatureDB/SignatureDB.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -122,9 +123,21 @@ void HashSignatureDB::Clear()
 
 void HashSignatureDB::Apply(PPCSymbolDB* symbol_db) const
 {
+  // Both the database and the symbols are sorted by hash, so they can be matched in one pass
+  // instead of looking up every database entry.
+  const SymbolDB::XFuncPtrMap& symbols = symbol_db->SymbolsByHash();
+  auto symbols_iter = symbols.begin();
   for (const auto& entry : m_database)
   {
-    for (const auto& function : symbol_db->GetSymbolsFromHash(entry.first))
+    symbols_iter = std::find_if(symbols_iter, symbols.end(), [&entry](const auto& symbol) {
+      return symbol.first >= entry.first;
+    });
+    if (symbols_iter == symbols.end())
+      break;
+    if (symbols_iter->first != entry.first)
+      continue;
+
+    for (Symbol* function : symbols_iter->second)
     {
       // Found the function. Let's rename it according to the symbol file.
       if (entry.second.size == static_cast<unsigned int>(function->size))
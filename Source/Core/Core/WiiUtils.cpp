@@ -31,6 +31,7 @@
 #include "Core/IOS/Device.h"
 #include "Core/IOS/ES/ES.h"
 #include "Core/IOS/ES/Formats.h"
+#include "Core/IOS/FS/NANDIndex.h"
 #include "Core/IOS/IOS.h"
 #include "DiscIO/Enums.h"
 #include "DiscIO/NANDContentLoader.h"
@@ -100,6 +101,7 @@ bool InstallWAD(const std::string& wad_path)
   }
 
   DiscIO::NANDContentManager::Access().ClearCache();
+  IOS::HLE::NANDIndex::InvalidateAll();
   return true;
 }
 
@@ -498,6 +500,7 @@ UpdateResult DoOnlineUpdate(UpdateCallback update_callback, const std::string& r
   OnlineSystemUpdater updater{std::move(update_callback), region};
   const UpdateResult result = updater.DoOnlineUpdate();
   DiscIO::NANDContentManager::Access().ClearCache();
+  IOS::HLE::NANDIndex::InvalidateAll();
   return result;
 }
 }
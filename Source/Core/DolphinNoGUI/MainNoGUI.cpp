@@ -22,6 +22,8 @@
 #include "Core/BootManager.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
+#include "Core/FifoPlayer/FifoBenchmark.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
 #include "Core/Host.h"
 #include "Core/IOS/IOS.h"
 #include "Core/IOS/STM/STM.h"
@@ -357,6 +359,15 @@ static Platform* GetPlatform()
 int main(int argc, char* argv[])
 {
   auto parser = CommandLineParse::CreateParser(CommandLineParse::ParserOptions::OmitGUIOptions);
+  parser->add_option("--fifo-benchmark")
+      .action("store")
+      .type("int")
+      .metavar("<count>")
+      .help("Play the given fifolog <count> times, then exit and report per-frame timings");
+  parser->add_option("--benchmark-output")
+      .action("store")
+      .metavar("<file>")
+      .help("Write the FIFO benchmark report to <file> instead of stdout");
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
 
@@ -405,6 +416,19 @@ int main(int argc, char* argv[])
 
   DolphinAnalytics::Instance()->ReportDolphinStart("nogui");
 
+  const bool fifo_benchmark = options.is_set("fifo_benchmark");
+  if (fifo_benchmark)
+  {
+    const int playback_count = options.get("fifo_benchmark");
+    if (playback_count <= 0)
+    {
+      fprintf(stderr, "The FIFO benchmark must play the fifolog at least once\n");
+      return 1;
+    }
+    FifoPlayer::GetInstance().SetPlaybackCount(static_cast<u32>(playback_count));
+    FifoBenchmark::GetInstance().Start();
+  }
+
   if (!BootManager::BootCore(BootParameters::GenerateFromFile(boot_filename)))
   {
     fprintf(stderr, "Could not boot %s\n", boot_filename.c_str());
@@ -422,6 +446,23 @@ int main(int argc, char* argv[])
   Core::Stop();
 
   Core::Shutdown();
+
+  if (fifo_benchmark)
+  {
+    FifoBenchmark::GetInstance().Stop();
+    const std::string backend = SConfig::GetInstance().m_strVideoBackend;
+    if (options.is_set("benchmark_output"))
+    {
+      const std::string output_path = static_cast<const char*>(options.get("benchmark_output"));
+      if (!FifoBenchmark::GetInstance().WriteReport(output_path, boot_filename, backend))
+        fprintf(stderr, "Could not write the FIFO benchmark report to %s\n", output_path.c_str());
+    }
+    else
+    {
+      fputs(FifoBenchmark::GetInstance().GetReport(boot_filename, backend).c_str(), stdout);
+    }
+  }
+
   platform->Shutdown();
   UICommon::Shutdown();
 
@@ -18,12 +18,14 @@
 #include <wx/listbox.h>
 #include <wx/menu.h>
 #include <wx/mimetype.h>
+#include <wx/msgdlg.h>
 #include <wx/srchctrl.h>
 #include <wx/textdlg.h>
 
 #include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
+#include "Common/FrameTrace.h"
 #include "Common/IniFile.h"
 #include "Common/MsgHandler.h"
 #include "Common/SymbolDB.h"
@@ -160,6 +162,46 @@ void CCodeWindow::OnProfilerMenu(wxCommandEvent& event)
         wxExecute(OpenCommand, wxEXEC_SYNC);
     }
     break;
+  case IDM_SAMPLE_FUNCTIONS:
+    // Sampling also stops when emulation does, so the menu item may be out of date.
+    if (!Profiler::IsSampling())
+    {
+      Profiler::ClearSamples();
+      Profiler::StartSampling();
+    }
+    else
+    {
+      Profiler::StopSampling();
+    }
+    GetParentMenuBar()->Check(IDM_SAMPLE_FUNCTIONS, Profiler::IsSampling());
+    break;
+  case IDM_WRITE_SAMPLED_STACKS:
+  {
+    std::string filename = File::GetUserPath(D_DUMP_IDX) + "Debug/profile_stacks.txt";
+    File::CreateFullPath(filename);
+    if (Profiler::WriteSampledStacks(filename))
+    {
+      wxMessageBox(wxString::Format(_("Wrote the sampled collapsed stacks to %s"),
+                                    StrToWxStr(filename)),
+                   _("Sample Functions"), wxOK | wxICON_INFORMATION, this);
+    }
+    break;
+  }
+#ifdef USE_FRAME_TRACE
+  case IDM_CAPTURE_FRAME_TRACE:
+  {
+    constexpr u32 FRAME_TRACE_FRAMES = 10;
+    std::string filename = File::GetUserPath(D_DUMP_IDX) + "Debug/frame_trace.json";
+    File::CreateFullPath(filename);
+    if (FrameTrace::StartCapture(filename, FRAME_TRACE_FRAMES))
+    {
+      wxMessageBox(wxString::Format(_("The next %u frames will be written to %s"),
+                                    FRAME_TRACE_FRAMES, StrToWxStr(filename)),
+                   _("Capture Frame Trace"), wxOK | wxICON_INFORMATION, this);
+    }
+    break;
+  }
+#endif
   }
 }
 
@@ -250,6 +250,9 @@ enum
 
   // Profiler
   IDM_PROFILE_BLOCKS,
+  IDM_SAMPLE_FUNCTIONS,
+  IDM_WRITE_SAMPLED_STACKS,
+  IDM_CAPTURE_FRAME_TRACE,
   IDM_WRITE_PROFILE,
   // --------------------------------------------------------------
 
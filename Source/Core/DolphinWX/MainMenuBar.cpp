@@ -507,6 +507,16 @@ wxMenu* MainMenuBar::CreateProfilerMenu() const
   profiler_menu->AppendCheckItem(IDM_PROFILE_BLOCKS, _("&Profile Blocks"));
   profiler_menu->AppendSeparator();
   profiler_menu->Append(IDM_WRITE_PROFILE, _("&Write to profile.txt, Show"));
+  profiler_menu->AppendSeparator();
+  profiler_menu->AppendCheckItem(
+      IDM_SAMPLE_FUNCTIONS, _("&Sample Functions"),
+      _("Periodically samples the guest call stack, without instrumenting the JIT. "
+        "Unlike block profiling, this can be left on while playing."));
+  profiler_menu->Append(IDM_WRITE_SAMPLED_STACKS, _("Write Sampled &Stacks to profile_stacks.txt"));
+#ifdef USE_FRAME_TRACE
+  profiler_menu->AppendSeparator();
+  profiler_menu->Append(IDM_CAPTURE_FRAME_TRACE, _("Capture &Frame Trace to frame_trace.json"));
+#endif
 
   return profiler_menu;
 }
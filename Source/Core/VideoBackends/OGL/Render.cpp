@@ -1036,6 +1036,18 @@ u32 Renderer::AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data)
   return 0;
 }
 
+bool Renderer::PeekEFBRect(EFBAccessType type, const EFBRectangle& rect, u32* data,
+                           u32 data_stride)
+{
+  // The first peek reads back the whole cache rectangle, the rest are served from it.
+  for (int y = rect.top; y < rect.bottom; y++)
+  {
+    for (int x = rect.left; x < rect.right; x++)
+      data[(y - rect.top) * data_stride + (x - rect.left)] = AccessEFB(type, x, y, 0);
+  }
+  return true;
+}
+
 void Renderer::PokeEFB(EFBAccessType type, const EfbPokeData* points, size_t num_points)
 {
   FramebufferManager::PokeEFB(type, points, num_points);
@@ -74,6 +74,35 @@ void TextureCache::CopyEFB(u8* dst, const EFBCopyFormat& format, u32 native_widt
                                            y_scale);
 }
 
+namespace
+{
+// An EFB copy being read back to a pixel pack buffer.
+class BufferEFBCopy final : public TextureCacheBase::EncodedEFBCopy
+{
+public:
+  explicit BufferEFBCopy(GLuint buffer) : m_buffer(buffer) {}
+  ~BufferEFBCopy() { glDeleteBuffers(1, &m_buffer); }
+  void WriteToMemory(u8* dst, u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride) override
+  {
+    TextureConverter::WriteBufferToRam(m_buffer, dst, bytes_per_row, num_blocks_y, memory_stride);
+    m_buffer = 0;
+  }
+
+private:
+  GLuint m_buffer;
+};
+}  // Anonymous namespace
+
+std::unique_ptr<TextureCacheBase::EncodedEFBCopy>
+TextureCache::EncodeEFBCopy(const EFBCopyFormat& format, u32 native_width, u32 bytes_per_row,
+                            u32 num_blocks_y, bool is_depth_copy, const EFBRectangle& src_rect,
+                            bool scale_by_half, float y_scale)
+{
+  return std::make_unique<BufferEFBCopy>(TextureConverter::EncodeToBufferFromTexture(
+      format, native_width, bytes_per_row, num_blocks_y, is_depth_copy, src_rect, scale_by_half,
+      y_scale));
+}
+
 TextureCache::TextureCache()
 {
   CompileShaders();
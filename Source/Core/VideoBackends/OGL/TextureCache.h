@@ -5,6 +5,7 @@
 #pragma once
 
 #include <map>
+#include <memory>
 
 #include "Common/CommonTypes.h"
 #include "Common/GL/GLUtil.h"
@@ -44,6 +45,11 @@ private:
                u32 num_blocks_y, u32 memory_stride, bool is_depth_copy,
                const EFBRectangle& src_rect, bool scale_by_half, float y_scale) override;
 
+  std::unique_ptr<EncodedEFBCopy> EncodeEFBCopy(const EFBCopyFormat& format, u32 native_width,
+                                                u32 bytes_per_row, u32 num_blocks_y,
+                                                bool is_depth_copy, const EFBRectangle& src_rect,
+                                                bool scale_by_half, float y_scale) override;
+
   void CopyEFBToCacheEntry(TCacheEntry* entry, bool is_depth_copy, const EFBRectangle& src_rect,
                            bool scale_by_half, unsigned int cbuf_id, const float* colmat) override;
 
@@ -7,6 +7,7 @@
 #include "VideoBackends/OGL/TextureConverter.h"
 
 #include <string>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
@@ -56,6 +57,10 @@ static std::map<EFBCopyFormat, EncodingProgram> s_encoding_programs;
 
 static GLuint s_PBO = 0;  // for readback with different strides
 
+// Pixel pack buffers of deferred EFB copies which have been written out, kept for reuse.
+static constexpr size_t MAX_FREE_READBACK_BUFFERS = 16;
+static std::vector<GLuint> s_free_readback_buffers;
+
 static void CreatePrograms()
 {
   /* TODO: Accuracy Improvements
@@ -200,6 +205,9 @@ void Shutdown()
   glDeleteTextures(1, &s_srcTexture);
   glDeleteTextures(1, &s_dstTexture);
   glDeleteBuffers(1, &s_PBO);
+  glDeleteBuffers(static_cast<GLsizei>(s_free_readback_buffers.size()),
+                  s_free_readback_buffers.data());
+  s_free_readback_buffers.clear();
   glDeleteFramebuffers(2, s_texConvFrameBuffer);
 
   s_rgbToYuyvProgram.Destroy();
@@ -218,8 +226,8 @@ void Shutdown()
 
 // dst_line_size, writeStride in bytes
 
-static void EncodeToRamUsingShader(GLuint srcTexture, u8* destAddr, u32 dst_line_size,
-                                   u32 dstHeight, u32 writeStride, bool linearFilter, float y_scale)
+static void EncodeUsingShader(GLuint srcTexture, u32 dst_line_size, u32 dstHeight,
+                              bool linearFilter, float y_scale)
 {
   // switch to texture converter frame buffer
   // attach render buffer as color destination
@@ -243,17 +251,25 @@ static void EncodeToRamUsingShader(GLuint srcTexture, u8* destAddr, u32 dst_line
   glViewport(0, 0, (GLsizei)(dst_line_size / 4), (GLsizei)dstHeight);
 
   glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+}
 
-  int dstSize = dst_line_size * dstHeight;
-
-  // When the dst_line_size and writeStride are the same, we could use glReadPixels directly to RAM.
-  // But instead we always copy the data via a PBO, because macOS inexplicably prefers this (most
-  // noticeably in the Super Mario Sunshine transition).
-  glBindBuffer(GL_PIXEL_PACK_BUFFER, s_PBO);
-  glBufferData(GL_PIXEL_PACK_BUFFER, dstSize, nullptr, GL_STREAM_READ);
+// Starts reading back the encoded data to buffer. The read finishes asynchronously.
+static void ReadPixelsToBuffer(GLuint buffer, u32 dst_line_size, u32 dstHeight)
+{
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+  glBufferData(GL_PIXEL_PACK_BUFFER, dst_line_size * dstHeight, nullptr, GL_STREAM_READ);
   glReadPixels(0, 0, (GLsizei)(dst_line_size / 4), (GLsizei)dstHeight, GL_BGRA, GL_UNSIGNED_BYTE,
                nullptr);
-  u8* pbo = (u8*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, dstSize, GL_MAP_READ_BIT);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+// Waits for the data in buffer and copies it to RAM.
+static void CopyBufferToRam(GLuint buffer, u8* destAddr, u32 dst_line_size, u32 dstHeight,
+                            u32 writeStride)
+{
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+  u8* pbo = (u8*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, dst_line_size * dstHeight,
+                                  GL_MAP_READ_BIT);
 
   if (dst_line_size == writeStride)
   {
@@ -273,13 +289,23 @@ static void EncodeToRamUsingShader(GLuint srcTexture, u8* destAddr, u32 dst_line
   glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 }
 
-void EncodeToRamFromTexture(u8* dest_ptr, const EFBCopyFormat& format, u32 native_width,
-                            u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
-                            bool is_depth_copy, const EFBRectangle& src_rect, bool scale_by_half,
-                            float y_scale)
+static void EncodeToRamUsingShader(GLuint srcTexture, u8* destAddr, u32 dst_line_size,
+                                   u32 dstHeight, u32 writeStride, bool linearFilter, float y_scale)
 {
-  g_renderer->ResetAPIState();
+  EncodeUsingShader(srcTexture, dst_line_size, dstHeight, linearFilter, y_scale);
 
+  // When the dst_line_size and writeStride are the same, we could use glReadPixels directly to RAM.
+  // But instead we always copy the data via a PBO, because macOS inexplicably prefers this (most
+  // noticeably in the Super Mario Sunshine transition).
+  ReadPixelsToBuffer(s_PBO, dst_line_size, dstHeight);
+  CopyBufferToRam(s_PBO, destAddr, dst_line_size, dstHeight, writeStride);
+}
+
+// Draws the EFB with the encoding shader for format. Expects the API state to be reset.
+static void EncodeEFB(const EFBCopyFormat& format, u32 native_width, u32 bytes_per_row,
+                      u32 num_blocks_y, bool is_depth_copy, const EFBRectangle& src_rect,
+                      bool scale_by_half, float y_scale)
+{
   EncodingProgram& texconv_shader = GetOrCreateEncodingShader(format);
 
   texconv_shader.program.Bind();
@@ -291,11 +317,60 @@ void EncodeToRamFromTexture(u8* dest_ptr, const EFBCopyFormat& format, u32 nativ
                                   FramebufferManager::ResolveAndGetDepthTarget(src_rect) :
                                   FramebufferManager::ResolveAndGetRenderTarget(src_rect);
 
-  EncodeToRamUsingShader(read_texture, dest_ptr, bytes_per_row, num_blocks_y, memory_stride,
-                         scale_by_half && !is_depth_copy, y_scale);
+  EncodeUsingShader(read_texture, bytes_per_row, num_blocks_y, scale_by_half && !is_depth_copy,
+                    y_scale);
+}
+
+void EncodeToRamFromTexture(u8* dest_ptr, const EFBCopyFormat& format, u32 native_width,
+                            u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
+                            bool is_depth_copy, const EFBRectangle& src_rect, bool scale_by_half,
+                            float y_scale)
+{
+  g_renderer->ResetAPIState();
+
+  EncodeEFB(format, native_width, bytes_per_row, num_blocks_y, is_depth_copy, src_rect,
+            scale_by_half, y_scale);
+  ReadPixelsToBuffer(s_PBO, bytes_per_row, num_blocks_y);
+  CopyBufferToRam(s_PBO, dest_ptr, bytes_per_row, num_blocks_y, memory_stride);
+
+  FramebufferManager::SetFramebuffer(0);
+  g_renderer->RestoreAPIState();
+}
+
+GLuint EncodeToBufferFromTexture(const EFBCopyFormat& format, u32 native_width, u32 bytes_per_row,
+                                 u32 num_blocks_y, bool is_depth_copy,
+                                 const EFBRectangle& src_rect, bool scale_by_half, float y_scale)
+{
+  g_renderer->ResetAPIState();
+
+  EncodeEFB(format, native_width, bytes_per_row, num_blocks_y, is_depth_copy, src_rect,
+            scale_by_half, y_scale);
+  GLuint buffer;
+  if (!s_free_readback_buffers.empty())
+  {
+    buffer = s_free_readback_buffers.back();
+    s_free_readback_buffers.pop_back();
+  }
+  else
+  {
+    glGenBuffers(1, &buffer);
+  }
+  ReadPixelsToBuffer(buffer, bytes_per_row, num_blocks_y);
 
   FramebufferManager::SetFramebuffer(0);
   g_renderer->RestoreAPIState();
+  return buffer;
+}
+
+void WriteBufferToRam(GLuint buffer, u8* dest_ptr, u32 bytes_per_row, u32 num_blocks_y,
+                      u32 memory_stride)
+{
+  CopyBufferToRam(buffer, dest_ptr, bytes_per_row, num_blocks_y, memory_stride);
+
+  if (s_free_readback_buffers.size() < MAX_FREE_READBACK_BUFFERS)
+    s_free_readback_buffers.push_back(buffer);
+  else
+    glDeleteBuffers(1, &buffer);
 }
 
 void EncodeToRamYUYV(GLuint srcTexture, const TargetRectangle& sourceRc, u8* destAddr, u32 dstWidth,
@@ -29,6 +29,17 @@ void EncodeToRamFromTexture(u8* dest_ptr, const EFBCopyFormat& format, u32 nativ
                             u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
                             bool is_depth_copy, const EFBRectangle& src_rect, bool scale_by_half,
                             float y_scale);
+
+// Like EncodeToRamFromTexture, but reads the data back to a pixel pack buffer without waiting
+// for the GPU. The caller owns the buffer until it is passed to WriteBufferToRam.
+GLuint EncodeToBufferFromTexture(const EFBCopyFormat& format, u32 native_width, u32 bytes_per_row,
+                                 u32 num_blocks_y, bool is_depth_copy,
+                                 const EFBRectangle& src_rect, bool scale_by_half, float y_scale);
+
+// Waits for a buffer from EncodeToBufferFromTexture and writes its data to RAM. Takes ownership
+// of the buffer, which later encodes reuse.
+void WriteBufferToRam(GLuint buffer, u8* dest_ptr, u32 bytes_per_row, u32 num_blocks_y,
+                      u32 memory_stride);
 }
 
 }  // namespace OGL
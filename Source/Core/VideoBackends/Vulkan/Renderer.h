@@ -39,6 +39,8 @@ public:
 
   void RenderText(const std::string& pstr, int left, int top, u32 color) override;
   u32 AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data) override;
+  bool PeekEFBRect(EFBAccessType type, const EFBRectangle& rect, u32* data,
+                   u32 data_stride) override;
   void PokeEFB(EFBAccessType type, const EfbPokeData* points, size_t num_points) override;
   u16 BBoxRead(int index) override;
   void BBoxWrite(int index, u16 value) override;
@@ -7,6 +7,8 @@
 #include <algorithm>
 #include <cstring>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "Common/Assert.h"
@@ -18,6 +20,7 @@
 #include "VideoBackends/Vulkan/FramebufferManager.h"
 #include "VideoBackends/Vulkan/ObjectCache.h"
 #include "VideoBackends/Vulkan/Renderer.h"
+#include "VideoBackends/Vulkan/StagingTexture2D.h"
 #include "VideoBackends/Vulkan/StateTracker.h"
 #include "VideoBackends/Vulkan/StreamBuffer.h"
 #include "VideoBackends/Vulkan/Texture2D.h"
@@ -111,9 +114,44 @@ void TextureCache::ConvertTexture(TCacheEntry* destination, TCacheEntry* source,
                            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 }
 
-void TextureCache::CopyEFB(u8* dst, const EFBCopyFormat& format, u32 native_width,
-                           u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
-                           bool is_depth_copy, const EFBRectangle& src_rect, bool scale_by_half, float y_scale)
+namespace
+{
+// An EFB copy in a readback texture, which holds the data once the command buffer the copy was
+// encoded in has been executed.
+class StagingEFBCopy final : public TextureCacheBase::EncodedEFBCopy
+{
+public:
+  StagingEFBCopy(std::unique_ptr<StagingTexture2D> texture, VkFence fence)
+      : m_texture(std::move(texture)), m_fence(fence)
+  {
+  }
+
+  void WriteToMemory(u8* dst, u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride) override
+  {
+    // A copy from the current command buffer needs it to be submitted first. Waiting for an
+    // already executed command buffer returns right away, so flushing several copies only
+    // stalls once.
+    if (m_fence == g_command_buffer_mgr->GetCurrentCommandBufferFence())
+      Util::ExecuteCurrentCommandsAndRestoreState(false, true);
+    else
+      g_command_buffer_mgr->WaitForFence(m_fence);
+
+    m_texture->InvalidateCPUCache();
+    m_texture->ReadTexels(0, 0, bytes_per_row / sizeof(u32), num_blocks_y, dst, memory_stride);
+
+    // The GPU is done with the texture now, so later copies can reuse it.
+    TextureCache::GetInstance()->GetTextureConverter()->ReleaseStagingTexture(
+        std::move(m_texture));
+  }
+
+private:
+  std::unique_ptr<StagingTexture2D> m_texture;
+  VkFence m_fence;
+};
+}  // Anonymous namespace
+
+std::pair<Texture2D*, VkImageLayout>
+TextureCache::PrepareEFBForEncoding(bool is_depth_copy, const EFBRectangle& src_rect)
 {
   // Flush EFB pokes first, as they're expected to be included.
   FramebufferManager::GetInstance()->FlushEFBPokes();
@@ -143,6 +181,16 @@ void TextureCache::CopyEFB(u8* dst, const EFBCopyFormat& format, u32 native_widt
   VkImageLayout original_layout = src_texture->GetLayout();
   src_texture->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(),
                                   VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+  return std::make_pair(src_texture, original_layout);
+}
+
+void TextureCache::CopyEFB(u8* dst, const EFBCopyFormat& format, u32 native_width,
+                           u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
+                           bool is_depth_copy, const EFBRectangle& src_rect, bool scale_by_half, float y_scale)
+{
+  Texture2D* src_texture;
+  VkImageLayout original_layout;
+  std::tie(src_texture, original_layout) = PrepareEFBForEncoding(is_depth_copy, src_rect);
 
   m_texture_converter->EncodeTextureToMemory(src_texture->GetView(), dst, format, native_width,
                                              bytes_per_row, num_blocks_y, memory_stride,
@@ -152,6 +200,31 @@ void TextureCache::CopyEFB(u8* dst, const EFBCopyFormat& format, u32 native_widt
   src_texture->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(), original_layout);
 }
 
+std::unique_ptr<TextureCacheBase::EncodedEFBCopy>
+TextureCache::EncodeEFBCopy(const EFBCopyFormat& format, u32 native_width, u32 bytes_per_row,
+                            u32 num_blocks_y, bool is_depth_copy, const EFBRectangle& src_rect,
+                            bool scale_by_half, float y_scale)
+{
+  Texture2D* src_texture;
+  VkImageLayout original_layout;
+  std::tie(src_texture, original_layout) = PrepareEFBForEncoding(is_depth_copy, src_rect);
+
+  std::unique_ptr<StagingTexture2D> staging_texture =
+      m_texture_converter->EncodeTextureToStagingTexture(src_texture->GetView(), format,
+                                                         native_width, bytes_per_row, num_blocks_y,
+                                                         is_depth_copy, src_rect, scale_by_half,
+                                                         y_scale);
+
+  // Transition back to original state
+  src_texture->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(), original_layout);
+
+  if (!staging_texture)
+    return nullptr;
+
+  return std::make_unique<StagingEFBCopy>(std::move(staging_texture),
+                                          g_command_buffer_mgr->GetCurrentCommandBufferFence());
+}
+
 bool TextureCache::SupportsGPUTextureDecode(TextureFormat format, TlutFormat palette_format)
 {
   return m_texture_converter->SupportsTextureDecoding(format, palette_format);
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 
 #include "Common/CommonTypes.h"
 #include "VideoBackends/Vulkan/StreamBuffer.h"
@@ -40,6 +41,11 @@ public:
                u32 num_blocks_y, u32 memory_stride, bool is_depth_copy,
                const EFBRectangle& src_rect, bool scale_by_half, float y_scale) override;
 
+  std::unique_ptr<EncodedEFBCopy> EncodeEFBCopy(const EFBCopyFormat& format, u32 native_width,
+                                                u32 bytes_per_row, u32 num_blocks_y,
+                                                bool is_depth_copy, const EFBRectangle& src_rect,
+                                                bool scale_by_half, float y_scale) override;
+
   bool SupportsGPUTextureDecode(TextureFormat format, TlutFormat palette_format) override;
 
   void DecodeTextureOnGPU(TCacheEntry* entry, u32 dst_level, const u8* data, size_t data_size,
@@ -54,6 +60,11 @@ public:
 private:
   bool CreateRenderPasses();
 
+  // Resolves the EFB and makes it readable by the encoding shaders. Returns the EFB texture and
+  // the layout to restore once the copy has been encoded.
+  std::pair<Texture2D*, VkImageLayout> PrepareEFBForEncoding(bool is_depth_copy,
+                                                             const EFBRectangle& src_rect);
+
   void CopyEFBToCacheEntry(TCacheEntry* entry, bool is_depth_copy, const EFBRectangle& src_rect,
                            bool scale_by_half, unsigned int cbuf_id, const float* colmat) override;
 
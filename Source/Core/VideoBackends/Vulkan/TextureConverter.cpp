@@ -231,13 +231,77 @@ void TextureConverter::EncodeTextureToMemory(VkImageView src_texture, u8* dest_p
                                              u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
                                              bool is_depth_copy, const EFBRectangle& src_rect,
                                              bool scale_by_half, float y_scale)
+{
+  if (!EncodeTexture(m_encoding_download_texture.get(), src_texture, format, native_width,
+                     bytes_per_row, num_blocks_y, is_depth_copy, src_rect, scale_by_half, y_scale))
+  {
+    return;
+  }
+
+  // Block until the GPU has finished copying to the staging texture.
+  Util::ExecuteCurrentCommandsAndRestoreState(false, true);
+
+  // Copy from staging texture to the final destination, adjusting pitch if necessary.
+  m_encoding_download_texture->ReadTexels(0, 0, bytes_per_row / sizeof(u32), num_blocks_y, dest_ptr,
+                                          memory_stride);
+}
+
+std::unique_ptr<StagingTexture2D> TextureConverter::EncodeTextureToStagingTexture(
+    VkImageView src_texture, const EFBCopyFormat& format, u32 native_width, u32 bytes_per_row,
+    u32 num_blocks_y, bool is_depth_copy, const EFBRectangle& src_rect, bool scale_by_half,
+    float y_scale)
+{
+  // Games tend to make the same copies every frame, so a free texture of the right size is
+  // usually around.
+  const u32 width = bytes_per_row / sizeof(u32);
+  std::unique_ptr<StagingTexture2D> texture;
+  auto iter = std::find_if(m_free_staging_textures.begin(), m_free_staging_textures.end(),
+                           [width, num_blocks_y](const std::unique_ptr<StagingTexture2D>& free) {
+                             return free->GetWidth() == width && free->GetHeight() == num_blocks_y;
+                           });
+  if (iter != m_free_staging_textures.end())
+  {
+    texture = std::move(*iter);
+    m_free_staging_textures.erase(iter);
+  }
+  else
+  {
+    texture = StagingTexture2D::Create(STAGING_BUFFER_TYPE_READBACK, width, num_blocks_y,
+                                       ENCODING_TEXTURE_FORMAT);
+    if (!texture || !texture->Map())
+      return nullptr;
+  }
+
+  if (!EncodeTexture(texture.get(), src_texture, format, native_width, bytes_per_row, num_blocks_y,
+                     is_depth_copy, src_rect, scale_by_half, y_scale))
+  {
+    ReleaseStagingTexture(std::move(texture));
+    return nullptr;
+  }
+
+  return texture;
+}
+
+void TextureConverter::ReleaseStagingTexture(std::unique_ptr<StagingTexture2D> texture)
+{
+  if (m_free_staging_textures.size() == MAX_FREE_STAGING_TEXTURES)
+    m_free_staging_textures.erase(m_free_staging_textures.begin());
+
+  m_free_staging_textures.push_back(std::move(texture));
+}
+
+bool TextureConverter::EncodeTexture(StagingTexture2D* dst_texture, VkImageView src_texture,
+                                     const EFBCopyFormat& format, u32 native_width,
+                                     u32 bytes_per_row, u32 num_blocks_y, bool is_depth_copy,
+                                     const EFBRectangle& src_rect, bool scale_by_half,
+                                     float y_scale)
 {
   VkShaderModule shader = GetEncodingShader(format);
   if (shader == VK_NULL_HANDLE)
   {
     ERROR_LOG(VIDEO, "Missing encoding fragment shader for format %u->%u", format.efb_format,
               static_cast<u32>(format.copy_format));
-    return;
+    return false;
   }
 
   // Can't do our own draw within a render pass.
@@ -281,16 +345,10 @@ void TextureConverter::EncodeTextureToMemory(VkImageView src_texture, u8* dest_p
   // Transition the image before copying
   m_encoding_render_texture->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(),
                                                 VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
-  m_encoding_download_texture->CopyFromImage(
-      g_command_buffer_mgr->GetCurrentCommandBuffer(), m_encoding_render_texture->GetImage(),
-      VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, render_width, render_height, 0, 0);
-
-  // Block until the GPU has finished copying to the staging texture.
-  Util::ExecuteCurrentCommandsAndRestoreState(false, true);
-
-  // Copy from staging texture to the final destination, adjusting pitch if necessary.
-  m_encoding_download_texture->ReadTexels(0, 0, render_width, render_height, dest_ptr,
-                                          memory_stride);
+  dst_texture->CopyFromImage(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                             m_encoding_render_texture->GetImage(), VK_IMAGE_ASPECT_COLOR_BIT, 0, 0,
+                             render_width, render_height, 0, 0);
+  return true;
 }
 
 void TextureConverter::EncodeTextureToMemoryYUYV(void* dst_ptr, u32 dst_width, u32 dst_stride,
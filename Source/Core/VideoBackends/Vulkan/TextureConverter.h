@@ -8,6 +8,7 @@
 #include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "VideoBackends/Vulkan/StreamBuffer.h"
@@ -42,6 +43,18 @@ public:
                              u32 memory_stride, bool is_depth_copy, const EFBRectangle& src_rect,
                              bool scale_by_half, float y_scale);
 
+  // Uses an encoding shader to copy src_texture to a readback texture, which holds the data
+  // once the current command buffer has been executed. Returns nullptr on failure.
+  std::unique_ptr<StagingTexture2D>
+  EncodeTextureToStagingTexture(VkImageView src_texture, const EFBCopyFormat& format,
+                                u32 native_width, u32 bytes_per_row, u32 num_blocks_y,
+                                bool is_depth_copy, const EFBRectangle& src_rect,
+                                bool scale_by_half, float y_scale);
+
+  // Keeps a texture returned by EncodeTextureToStagingTexture for reuse, once its data has been
+  // read back.
+  void ReleaseStagingTexture(std::unique_ptr<StagingTexture2D> texture);
+
   // Encodes texture to guest memory in XFB (YUYV) format.
   void EncodeTextureToMemoryYUYV(void* dst_ptr, u32 dst_width, u32 dst_stride, u32 dst_height,
                                  Texture2D* src_texture, const MathUtil::Rectangle<int>& src_rect);
@@ -61,6 +74,7 @@ private:
   static const u32 ENCODING_TEXTURE_HEIGHT = 1024;
   static const VkFormat ENCODING_TEXTURE_FORMAT = VK_FORMAT_B8G8R8A8_UNORM;
   static const size_t NUM_PALETTE_CONVERSION_SHADERS = 3;
+  static const size_t MAX_FREE_STAGING_TEXTURES = 16;
 
   // Maximum size of a texture based on BP registers.
   static const u32 DECODING_TEXTURE_WIDTH = 1024;
@@ -74,6 +88,12 @@ private:
   VkShaderModule CompileEncodingShader(const EFBCopyFormat& format);
   VkShaderModule GetEncodingShader(const EFBCopyFormat& format);
 
+  // Records the encoding of src_texture to dst_texture in the current command buffer.
+  bool EncodeTexture(StagingTexture2D* dst_texture, VkImageView src_texture,
+                     const EFBCopyFormat& format, u32 native_width, u32 bytes_per_row,
+                     u32 num_blocks_y, bool is_depth_copy, const EFBRectangle& src_rect,
+                     bool scale_by_half, float y_scale);
+
   bool CreateEncodingRenderPass();
   bool CreateEncodingTexture();
   bool CreateEncodingDownloadTexture();
@@ -110,6 +130,8 @@ private:
   std::unique_ptr<Texture2D> m_encoding_render_texture;
   VkFramebuffer m_encoding_render_framebuffer = VK_NULL_HANDLE;
   std::unique_ptr<StagingTexture2D> m_encoding_download_texture;
+  // Readback textures of deferred EFB copies which have been written out, oldest first.
+  std::vector<std::unique_ptr<StagingTexture2D>> m_free_staging_textures;
 
   // Texture decoding - GX format in memory->RGBA8
   struct TextureDecodingPipeline
@@ -205,6 +205,8 @@ void VertexManager::vFlush()
   vkCmdDrawIndexed(g_command_buffer_mgr->GetCurrentCommandBuffer(), index_count, 1,
                    m_current_draw_base_index, m_current_draw_base_vertex, 0);
 
+  INCSTAT(stats.thisFrame.numDrawCalls);
+
   StateTracker::GetInstance()->OnDraw();
 }
 
@@ -179,6 +179,10 @@ bool AVIDump::CreateVideoFile()
   s_codec_context->time_base.den = VideoInterface::GetTargetRefreshRate();
   s_codec_context->gop_size = 12;
   s_codec_context->pix_fmt = g_Config.bUseFFV1 ? AV_PIX_FMT_BGRA : AV_PIX_FMT_YUV420P;
+  // Let the encoder pick a thread count matching the host, so encoding high resolution dumps
+  // doesn't bottleneck on a single core.
+  s_codec_context->thread_count = 0;
+  s_codec_context->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
 
   if (output_format->flags & AVFMT_GLOBALHEADER)
     s_codec_context->flags |= CODEC_FLAG_GLOBAL_HEADER;
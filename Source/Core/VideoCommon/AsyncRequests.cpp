@@ -2,109 +2,182 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
-#include <mutex>
+#include <algorithm>
+
+#include "Common/FrameTrace.h"
 
 #include "VideoCommon/AsyncRequests.h"
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/PixelEngine.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoCommon.h"
 
 AsyncRequests AsyncRequests::s_singleton;
 
-AsyncRequests::AsyncRequests() : m_enable(false), m_passthrough(true)
-{
-}
+AsyncRequests::AsyncRequests() = default;
 
 void AsyncRequests::PullEventsInternal()
 {
-  std::unique_lock<std::mutex> lock(m_mutex);
-  m_empty.Set();
+  TRACE_ZONE("AsyncRequests::PullEvents");
 
-  while (!m_queue.empty())
+  while (!m_queue.Empty())
   {
-    Event e = m_queue.front();
+    const Event e = m_queue.Front();
 
     // try to merge as many efb pokes as possible
     // it's a bit hacky, but some games render a complete frame in this way
     if ((e.type == Event::EFB_POKE_COLOR || e.type == Event::EFB_POKE_Z))
     {
       m_merged_efb_pokes.clear();
-      Event first_event = m_queue.front();
-      const auto t = first_event.type == Event::EFB_POKE_COLOR ? EFBAccessType::PokeColor :
-                                                                 EFBAccessType::PokeZ;
+      const auto t =
+          e.type == Event::EFB_POKE_COLOR ? EFBAccessType::PokeColor : EFBAccessType::PokeZ;
 
       do
       {
-        e = m_queue.front();
-
-        EfbPokeData d;
-        d.data = e.efb_poke.data;
-        d.x = e.efb_poke.x;
-        d.y = e.efb_poke.y;
-        m_merged_efb_pokes.push_back(d);
-
-        m_queue.pop();
-      } while (!m_queue.empty() && m_queue.front().type == first_event.type);
+        const Event& poke = m_queue.Front();
+        m_merged_efb_pokes.push_back({poke.efb_poke.x, poke.efb_poke.y, poke.efb_poke.data});
+        m_queue.Pop();
+      } while (!m_queue.Empty() && m_queue.Front().type == e.type);
 
-      lock.unlock();
       g_renderer->PokeEFB(t, m_merged_efb_pokes.data(), m_merged_efb_pokes.size());
-      lock.lock();
+      m_handled_count.fetch_add(m_merged_efb_pokes.size());
       continue;
     }
 
-    lock.unlock();
     HandleEvent(e);
-    lock.lock();
-
-    m_queue.pop();
+    m_queue.Pop();
+    m_handled_count.fetch_add(1);
   }
 
-  if (m_wake_me_up_again)
-  {
-    m_wake_me_up_again = false;
-    m_cond.notify_all();
-  }
+  if (m_wake_me_up_again.exchange(false))
+    m_handled_event.Set();
 }
 
 void AsyncRequests::PushEvent(const AsyncRequests::Event& event, bool blocking)
 {
-  std::unique_lock<std::mutex> lock(m_mutex);
+  // Tiles read back after the poke are ordered behind it, so only the current ones are stale.
+  if (event.type == Event::EFB_POKE_COLOR || event.type == Event::EFB_POKE_Z)
+    InvalidateEFBPeekCache();
 
-  if (m_passthrough)
+  if (m_passthrough.load())
   {
     HandleEvent(event);
     return;
   }
 
-  m_empty.Clear();
-  m_wake_me_up_again |= blocking;
-
-  if (!m_enable)
+  if (!m_enable.load())
     return;
 
-  m_queue.push(event);
+  m_queue.Push(event);
+  const u64 pushed_count = ++m_pushed_count;
 
   Fifo::RunGpu();
-  if (blocking)
+  if (!blocking)
+    return;
+
+  // The GPU thread checks m_wake_me_up_again after updating m_handled_count, so either it sees
+  // the flag and signals us, or we see the count and don't wait.
+  while (true)
   {
-    m_cond.wait(lock, [this] { return m_queue.empty(); });
+    m_wake_me_up_again.store(true);
+    if (m_handled_count.load() >= pushed_count || !m_enable.load())
+      break;
+    m_handled_event.Wait();
   }
 }
 
 void AsyncRequests::SetEnable(bool enable)
 {
-  std::unique_lock<std::mutex> lock(m_mutex);
-  m_enable = enable;
+  // Only the GPU thread enables or disables the queue, so it may drain it here. Requests can still
+  // land in the queue while it's being disabled, and must not be handled once it's re-enabled.
+  // Dropped requests count as handled, or later blocking pushes would wait for them forever.
+  Event e;
+  if (enable)
+  {
+    while (m_queue.Pop(e))
+      m_handled_count.fetch_add(1);
+    m_enable.store(true);
+  }
+  else
+  {
+    m_enable.store(false);
+    while (m_queue.Pop(e))
+      m_handled_count.fetch_add(1);
+    m_handled_event.Set();
+  }
+}
+
+u32 AsyncRequests::PeekEFB(Event::Type type, u16 x, u16 y)
+{
+  Event e;
+  e.type = type;
+  e.time = 0;
+  e.efb_peek.x = x;
+  e.efb_peek.y = y;
+  e.efb_peek.data = &m_efb_peek_result;
+  e.efb_peek.tile = nullptr;
+
+  // Out of range peeks are left to the backend.
+  if (x < EFB_WIDTH && y < EFB_HEIGHT)
+  {
+    const bool is_color = type == Event::EFB_PEEK_COLOR;
+    const u32 alpha_read_mode = is_color ? PixelEngine::GetAlphaReadMode().Hex : 0;
+    auto& tile = (is_color ? m_efb_color_tiles : m_efb_z_tiles)[(y / EFB_PEEK_TILE_SIZE) *
+                                                                    EFB_PEEK_TILES_WIDE +
+                                                                x / EFB_PEEK_TILE_SIZE];
+    if (tile && tile->generation == m_efb_generation.load() &&
+        tile->alpha_read_mode == alpha_read_mode)
+    {
+      return tile->values[(y % EFB_PEEK_TILE_SIZE) * EFB_PEEK_TILE_SIZE + x % EFB_PEEK_TILE_SIZE];
+    }
 
-  if (!enable)
+    if (!tile)
+      tile = std::make_unique<EFBPeekTile>();
+    e.efb_peek.tile = tile.get();
+  }
+
+  PushEvent(e, true);
+  return m_efb_peek_result;
+}
+
+u16 AsyncRequests::ReadBoundingBox(int index)
+{
+  Event e;
+  e.time = 0;
+  e.type = Event::BBOX_READ;
+  e.bbox.index = index;
+  e.bbox.data = &m_bbox_result;
+  PushEvent(e, true);
+  return m_bbox_result;
+}
+
+void AsyncRequests::HandleEFBPeek(const Event& e)
+{
+  const EFBAccessType type =
+      e.type == Event::EFB_PEEK_COLOR ? EFBAccessType::PeekColor : EFBAccessType::PeekZ;
+  EFBPeekTile* tile = e.efb_peek.tile;
+  if (tile)
   {
-    // flush the queue on disabling
-    while (!m_queue.empty())
-      m_queue.pop();
-    if (m_wake_me_up_again)
-      m_cond.notify_all();
+    const u32 left = e.efb_peek.x - e.efb_peek.x % EFB_PEEK_TILE_SIZE;
+    const u32 top = e.efb_peek.y - e.efb_peek.y % EFB_PEEK_TILE_SIZE;
+    const EFBRectangle rect(left, top, std::min<u32>(left + EFB_PEEK_TILE_SIZE, EFB_WIDTH),
+                            std::min<u32>(top + EFB_PEEK_TILE_SIZE, EFB_HEIGHT));
+
+    // Read the generation first, so that an invalidation racing with the readback wins.
+    const u64 generation = m_efb_generation.load();
+    if (g_renderer->PeekEFBRect(type, rect, tile->values.data(), EFB_PEEK_TILE_SIZE))
+    {
+      tile->generation = generation;
+      tile->alpha_read_mode =
+          type == EFBAccessType::PeekColor ? PixelEngine::GetAlphaReadMode().Hex : 0;
+      *e.efb_peek.data =
+          tile->values[(e.efb_peek.y - top) * EFB_PEEK_TILE_SIZE + (e.efb_peek.x - left)];
+      return;
+    }
   }
+
+  *e.efb_peek.data = g_renderer->AccessEFB(type, e.efb_peek.x, e.efb_peek.y, 0);
 }
 
 void AsyncRequests::HandleEvent(const AsyncRequests::Event& e)
@@ -127,12 +200,8 @@ void AsyncRequests::HandleEvent(const AsyncRequests::Event& e)
   break;
 
   case Event::EFB_PEEK_COLOR:
-    *e.efb_peek.data =
-        g_renderer->AccessEFB(EFBAccessType::PeekColor, e.efb_peek.x, e.efb_peek.y, 0);
-    break;
-
   case Event::EFB_PEEK_Z:
-    *e.efb_peek.data = g_renderer->AccessEFB(EFBAccessType::PeekZ, e.efb_peek.x, e.efb_peek.y, 0);
+    HandleEFBPeek(e);
     break;
 
   case Event::SWAP_EVENT:
@@ -152,6 +221,5 @@ void AsyncRequests::HandleEvent(const AsyncRequests::Event& e)
 
 void AsyncRequests::SetPassthrough(bool enable)
 {
-  std::unique_lock<std::mutex> lock(m_mutex);
-  m_passthrough = enable;
+  m_passthrough.store(enable);
 }
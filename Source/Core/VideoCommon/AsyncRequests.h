@@ -4,19 +4,38 @@
 
 #pragma once
 
-#include <condition_variable>
-#include <mutex>
-#include <queue>
+#include <array>
+#include <atomic>
+#include <memory>
 #include <vector>
 
 #include "Common/CommonTypes.h"
-#include "Common/Flag.h"
+#include "Common/Event.h"
+#include "Common/FifoQueue.h"
+#include "VideoCommon/VideoCommon.h"
 
 struct EfbPokeData;
 
 class AsyncRequests
 {
 public:
+  // EFB peeks are answered from whole tiles of the EFB which are read back at once, so that games
+  // peeking many values in a row only wait for the GPU thread once per tile.
+  static constexpr u32 EFB_PEEK_TILE_SIZE = 64;
+  static constexpr u32 EFB_PEEK_TILES_WIDE =
+      (EFB_WIDTH + EFB_PEEK_TILE_SIZE - 1) / EFB_PEEK_TILE_SIZE;
+  static constexpr u32 EFB_PEEK_TILES_HIGH =
+      (EFB_HEIGHT + EFB_PEEK_TILE_SIZE - 1) / EFB_PEEK_TILE_SIZE;
+
+  struct EFBPeekTile
+  {
+    // Matches m_efb_generation while the values are current.
+    u64 generation = 0;
+    // Color peeks depend on the alpha read mode, which the CPU can change without touching the EFB.
+    u32 alpha_read_mode = 0;
+    std::array<u32, EFB_PEEK_TILE_SIZE * EFB_PEEK_TILE_SIZE> values;
+  };
+
   struct Event
   {
     enum Type
@@ -45,6 +64,8 @@ public:
         u16 x;
         u16 y;
         u32* data;
+        // If set, the whole tile containing (x, y) is read back into it when the backend can.
+        EFBPeekTile* tile;
       } efb_peek;
 
       struct
@@ -71,28 +92,49 @@ public:
 
   void PullEvents()
   {
-    if (!m_empty.IsSet())
+    if (!m_queue.Empty())
       PullEventsInternal();
   }
   void PushEvent(const Event& event, bool blocking = false);
   void SetEnable(bool enable);
   void SetPassthrough(bool enable);
 
+  // Only call these from the CPU thread.
+  u32 PeekEFB(Event::Type type, u16 x, u16 y);
+  u16 ReadBoundingBox(int index);
+
+  // Drops the cached EFB peek tiles. Called whenever the contents of the EFB may change.
+  void InvalidateEFBPeekCache() { m_efb_generation.fetch_add(1); }
+
   static AsyncRequests* GetInstance() { return &s_singleton; }
 private:
   void PullEventsInternal();
   void HandleEvent(const Event& e);
+  void HandleEFBPeek(const Event& e);
 
   static AsyncRequests s_singleton;
 
-  Common::Flag m_empty;
-  std::queue<Event> m_queue;
-  std::mutex m_mutex;
-  std::condition_variable m_cond;
+  // Single producer (the CPU thread), single consumer (the GPU thread).
+  Common::FifoQueue<Event, false> m_queue;
+
+  // Blocking pushes wait until the GPU thread has handled this many events.
+  u64 m_pushed_count = 0;
+  std::atomic<u64> m_handled_count{0};
+  std::atomic<bool> m_wake_me_up_again{false};
+  Common::Event m_handled_event;
 
-  bool m_wake_me_up_again;
-  bool m_enable;
-  bool m_passthrough;
+  std::atomic<bool> m_enable{false};
+  std::atomic<bool> m_passthrough{true};
 
   std::vector<EfbPokeData> m_merged_efb_pokes;
+
+  // Results of blocking requests are written here rather than to the requester's stack, as a
+  // request dropped by SetEnable(false) may still be sitting in the queue.
+  u32 m_efb_peek_result = 0;
+  u16 m_bbox_result = 0;
+
+  std::atomic<u64> m_efb_generation{1};
+  std::array<std::unique_ptr<EFBPeekTile>, EFB_PEEK_TILES_WIDE * EFB_PEEK_TILES_HIGH>
+      m_efb_color_tiles;
+  std::array<std::unique_ptr<EFBPeekTile>, EFB_PEEK_TILES_WIDE * EFB_PEEK_TILES_HIGH> m_efb_z_tiles;
 };
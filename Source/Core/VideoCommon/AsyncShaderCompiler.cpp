@@ -5,7 +5,9 @@
 #include "VideoCommon/AsyncShaderCompiler.h"
 #include <thread>
 #include "Common/Assert.h"
+#include "Common/FrameTrace.h"
 #include "Common/Logging/Log.h"
+#include "Common/Thread.h"
 
 namespace VideoCommon
 {
@@ -187,6 +189,8 @@ void AsyncShaderCompiler::WorkerThreadExit(void* param)
 
 void AsyncShaderCompiler::WorkerThreadEntryPoint(void* param)
 {
+  Common::SetCurrentThreadName("Shader compiler");
+
   // Initialize worker thread with backend-specific method.
   if (!WorkerThreadInitWorkerThread(param))
   {
@@ -218,7 +222,12 @@ void AsyncShaderCompiler::WorkerThreadRun()
       m_pending_work.pop_front();
       pending_lock.unlock();
 
-      if (item->Compile())
+      bool compiled;
+      {
+        TRACE_ZONE("Shader compile");
+        compiled = item->Compile();
+      }
+      if (compiled)
       {
         std::lock_guard<std::mutex> completed_guard(m_completed_work_lock);
         m_completed_work.push_back(std::move(item));
@@ -5,6 +5,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 
+#include "VideoCommon/AsyncRequests.h"
 #include "VideoCommon/BPFunctions.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/RenderBase.h"
@@ -132,12 +133,16 @@ void ClearScreen(const EFBRectangle& rc)
       color = RGBA8ToRGB565ToRGBA8(color);
       z = Z24ToZ16ToZ24(z);
     }
+    AsyncRequests::GetInstance()->InvalidateEFBPeekCache();
     g_renderer->ClearScreen(rc, colorEnable, alphaEnable, zEnable, color, z);
   }
 }
 
 void OnPixelFormatChange()
 {
+  // Peeked values are converted to the pixel format, and the EFB may be reinterpreted below.
+  AsyncRequests::GetInstance()->InvalidateEFBPeekCache();
+
   int convtype = -1;
 
   // TODO : Check for Z compression format change
@@ -181,11 +181,13 @@ static void BPWritten(const BPCmd& bp)
   // This is called when the game is done drawing the new frame (eg: like in DX: Begin(); Draw();
   // End();)
   // Triggers an interrupt on the PPC side so that the game knows when the GPU has finished drawing.
-  // Tokens are similar.
+  // Tokens are similar. Both tell the game that its EFB copies are done, so deferred copies have to
+  // be in RAM by then.
   case BPMEM_SETDRAWDONE:
     switch (bp.newvalue & 0xFF)
     {
     case 0x02:
+      g_texture_cache->FlushEFBCopies();
       if (!Fifo::UseDeterministicGPUThread())
         PixelEngine::SetFinish();  // may generate interrupt
       DEBUG_LOG(VIDEO, "GXSetDrawDone SetPEFinish (value: 0x%02X)", (bp.newvalue & 0xFFFF));
@@ -197,11 +199,13 @@ static void BPWritten(const BPCmd& bp)
     }
     return;
   case BPMEM_PE_TOKEN_ID:  // Pixel Engine Token ID
+    g_texture_cache->FlushEFBCopies();
     if (!Fifo::UseDeterministicGPUThread())
       PixelEngine::SetToken(static_cast<u16>(bp.newvalue & 0xFFFF), false);
     DEBUG_LOG(VIDEO, "SetPEToken 0x%04x", (bp.newvalue & 0xFFFF));
     return;
   case BPMEM_PE_TOKEN_INT_ID:  // Pixel Engine Interrupt Token ID
+    g_texture_cache->FlushEFBCopies();
     if (!Fifo::UseDeterministicGPUThread())
       PixelEngine::SetToken(static_cast<u16>(bp.newvalue & 0xFFFF), true);
     DEBUG_LOG(VIDEO, "SetPEToken + INT 0x%04x", (bp.newvalue & 0xFFFF));
@@ -301,6 +305,7 @@ static void BPWritten(const BPCmd& bp)
     if (!SConfig::GetInstance().bWii)
       addr = addr & 0x01FFFFFF;
 
+    g_texture_cache->FlushEFBCopiesInRange(addr, tlutXferCount);
     Memory::CopyFromEmu(texMem + tlutTMemAddr, addr, tlutXferCount);
 
     if (g_bRecordFifoData)
@@ -500,6 +505,11 @@ static void BPWritten(const BPCmd& bp)
       u32 bytes_read = 0;
       u32 tmem_addr_even = tmem_cfg.preload_tmem_even * TMEM_LINE_SIZE;
 
+      // RGBA8 tiles read two lines per count.
+      const u32 preload_lines = tmem_cfg.preload_tile_info.count *
+                                (tmem_cfg.preload_tile_info.type == 3 ? 2 : 1);
+      g_texture_cache->FlushEFBCopiesInRange(src_addr, preload_lines * TMEM_LINE_SIZE);
+
       if (tmem_cfg.preload_tile_info.type != 3)
       {
         bytes_read = tmem_cfg.preload_tile_info.count * TMEM_LINE_SIZE;
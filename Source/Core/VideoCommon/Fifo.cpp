@@ -11,6 +11,7 @@
 #include "Common/ChunkFile.h"
 #include "Common/Event.h"
 #include "Common/FPURoundMode.h"
+#include "Common/FrameTrace.h"
 #include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
 
@@ -26,6 +27,7 @@
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
 
@@ -97,9 +99,12 @@ void PauseAndLock(bool doLock, bool unpauseOnUnlock)
 
     const SConfig& param = SConfig::GetInstance();
 
-    if (!param.bCPUThread || s_use_deterministic_gpu_thread)
+    // In single core mode, the CPU thread flushes deferred work itself when it stops.
+    if (!param.bCPUThread)
       return;
 
+    // Make the GPU thread do one more pass in the paused state, which flushes deferred work.
+    s_gpu_mainloop.Wakeup();
     s_gpu_mainloop.WaitYield(std::chrono::milliseconds(100), Host_YieldToUI);
   }
   else
@@ -287,6 +292,12 @@ void ResetVideoBuffer()
   s_fifo_aux_read_ptr = s_fifo_aux_data;
 }
 
+void FlushDeferredGPUWork()
+{
+  if (g_texture_cache)
+    g_texture_cache->FlushEFBCopies();
+}
+
 // Description: Main FIFO update loop
 // Purpose: Keep the Core HW updated about the CPU-GPU distance
 void RunGpuLoop()
@@ -300,9 +311,13 @@ void RunGpuLoop()
 
         g_video_backend->PeekMessages();
 
-        // Do nothing while paused
+        // Do nothing while paused, except writing out deferred work, since RAM may be read or
+        // saved to a savestate now.
         if (!s_emu_running_state.IsSet())
+        {
+          FlushDeferredGPUWork();
           return;
+        }
 
         if (s_use_deterministic_gpu_thread)
         {
@@ -314,6 +329,7 @@ void RunGpuLoop()
           // See comment in SyncGPU
           if (write_ptr > seen_ptr)
           {
+            TRACE_ZONE("GPU FIFO");
             s_video_buffer_read_ptr =
                 OpcodeDecoder::Run(DataReader(s_video_buffer_read_ptr, write_ptr), nullptr, false);
             s_video_buffer_seen_ptr = write_ptr;
@@ -334,6 +350,7 @@ void RunGpuLoop()
             if (param.bSyncGPU && s_sync_ticks.load() < param.iSyncGpuMinDistance)
               break;
 
+            TRACE_ZONE("GPU FIFO");
             u32 cyclesExecuted = 0;
             u32 readPtr = fifo.CPReadPointer;
             ReadDataFromFifo(readPtr);
@@ -458,6 +475,7 @@ static int RunGpuOnCpu(int ticks)
         FPURoundMode::LoadDefaultSIMDState();
         reset_simd_state = true;
       }
+      TRACE_ZONE("GPU FIFO");
       ReadDataFromFifo(fifo.CPReadPointer);
       u32 cycles = 0;
       s_video_buffer_read_ptr = OpcodeDecoder::Run(
@@ -42,6 +42,9 @@ void GpuMaySleep();
 void RunGpuLoop();
 void ExitGpuLoop();
 void EmulatorState(bool running);
+// Writes out work that the GPU defers until its results are needed, like EFB copies to RAM.
+// Must be called on the GPU thread.
+void FlushDeferredGPUWork();
 bool AtBreakpoint();
 void ResetVideoBuffer();
 
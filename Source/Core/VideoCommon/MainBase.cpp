@@ -86,16 +86,10 @@ u32 VideoBackendBase::Video_AccessEFB(EFBAccessType type, u32 x, u32 y, u32 Inpu
   }
   else
   {
-    AsyncRequests::Event e;
-    u32 result;
-    e.type = type == EFBAccessType::PeekColor ? AsyncRequests::Event::EFB_PEEK_COLOR :
-                                                AsyncRequests::Event::EFB_PEEK_Z;
-    e.time = 0;
-    e.efb_peek.x = x;
-    e.efb_peek.y = y;
-    e.efb_peek.data = &result;
-    AsyncRequests::GetInstance()->PushEvent(e, true);
-    return result;
+    const auto event_type = type == EFBAccessType::PeekColor ?
+                                AsyncRequests::Event::EFB_PEEK_COLOR :
+                                AsyncRequests::Event::EFB_PEEK_Z;
+    return AsyncRequests::GetInstance()->PeekEFB(event_type, x, y);
   }
 }
 
@@ -143,15 +137,7 @@ u16 VideoBackendBase::Video_GetBoundingBox(int index)
 
   Fifo::SyncGPU(Fifo::SyncGPUReason::BBox);
 
-  AsyncRequests::Event e;
-  u16 result;
-  e.time = 0;
-  e.type = AsyncRequests::Event::BBOX_READ;
-  e.bbox.index = index;
-  e.bbox.data = &result;
-  AsyncRequests::GetInstance()->PushEvent(e, true);
-
-  return result;
+  return AsyncRequests::GetInstance()->ReadBoundingBox(index);
 }
 
 void VideoBackendBase::ShowConfig(void* parent_handle)
@@ -248,5 +234,6 @@ void VideoBackendBase::CheckInvalidState()
 
     BPReload();
     g_texture_cache->Invalidate();
+    AsyncRequests::GetInstance()->InvalidateEFBPeekCache();
   }
 }
@@ -14,8 +14,11 @@
 
 #include "VideoCommon/RenderBase.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <cmath>
+#include <cstring>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -26,6 +29,7 @@
 #include "Common/Event.h"
 #include "Common/FileUtil.h"
 #include "Common/Flag.h"
+#include "Common/FrameTrace.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/Profiler.h"
@@ -36,6 +40,7 @@
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
+#include "Core/FifoPlayer/FifoBenchmark.h"
 #include "Core/FifoPlayer/FifoRecorder.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/Host.h"
@@ -43,6 +48,7 @@
 
 #include "VideoCommon/AbstractRawTexture.h"
 #include "VideoCommon/AbstractTexture.h"
+#include "VideoCommon/AsyncRequests.h"
 #include "VideoCommon/AVIDump.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/CPMemory.h"
@@ -697,6 +703,9 @@ void Renderer::RecordVideoMemory()
 void Renderer::Swap(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight, const EFBRectangle& rc,
                     u64 ticks, float Gamma)
 {
+  TRACE_FRAME();
+  TRACE_ZONE("Renderer::Swap");
+
   // Heuristic to detect if a GameCube game is in 16:9 anamorphic widescreen mode.
   if (!SConfig::GetInstance().bWii)
   {
@@ -713,10 +722,15 @@ void Renderer::Swap(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight, const
       m_aspect_wide = flush_count_anamorphic > 0.75 * flush_total;
   }
 
-  // The FinishFrameData call here is necessary even after frame dumping is stopped.
-  // If left out, screenshots are "one frame" behind, as an extra frame is dumped and buffered.
-  FinishFrameData();
-  if (IsFrameDumping())
+  // Games may read their EFB copies at any point of the next frame.
+  g_texture_cache->FlushEFBCopies();
+
+  // The EFB may be recreated at a new size, so tiles cached for peeks can't be trusted anymore.
+  AsyncRequests::GetInstance()->InvalidateEFBPeekCache();
+
+  // Frames are copied out of the XFB texture immediately, so the GPU thread only waits on the
+  // frame dumping thread when the queue of pending frames is full.
+  if (IsFrameDumping() && m_last_xfb_texture)
   {
     auto result = m_last_xfb_texture->Map();
     if (result.has_value())
@@ -724,6 +738,7 @@ void Renderer::Swap(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight, const
       auto raw_data = result.value();
       DumpFrameData(raw_data.data, raw_data.width, raw_data.height, raw_data.stride,
                     AVIDump::FetchState(ticks));
+      m_last_xfb_texture->Unmap();
     }
   }
 
@@ -751,6 +766,12 @@ void Renderer::Swap(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight, const
   frameCount++;
   GFX_DEBUGGER_PAUSE_AT(NEXT_FRAME, true);
 
+  if (FifoBenchmark::GetInstance().IsRunning())
+  {
+    FifoBenchmark::GetInstance().AddGPUFrame(stats.thisFrame.numDrawCalls,
+                                             stats.thisFrame.numPrims, stats.numTexturesUploaded);
+  }
+
   // Begin new frame
   // Set default viewport and scissor, for the clear to work correctly
   // New frame
@@ -780,14 +801,14 @@ void Renderer::ShutdownFrameDumping()
     return;
 
   FinishFrameData();
+
+  std::lock_guard<std::mutex> lk(m_frame_dump_lock);
   m_frame_dump_thread_running.Clear();
-  m_frame_dump_start.Set();
+  m_frame_dump_queued.notify_one();
 }
 
 void Renderer::DumpFrameData(const u8* data, int w, int h, int stride, const AVIDump::Frame& state)
 {
-  m_frame_dump_config = FrameDumpConfig{ m_last_xfb_texture, data, w, h, stride, state };
-
   if (!m_frame_dump_thread_running.IsSet())
   {
     if (m_frame_dump_thread.joinable())
@@ -796,18 +817,51 @@ void Renderer::DumpFrameData(const u8* data, int w, int h, int stride, const AVI
     m_frame_dump_thread = std::thread(&Renderer::RunFrameDumps, this);
   }
 
-  m_frame_dump_start.Set();
-  m_frame_dump_frame_running = true;
+  FrameDumpConfig config{{}, w, h, stride, state, {}};
+  if (m_screenshot_request.TestAndClear())
+  {
+    std::lock_guard<std::mutex> lk(m_screenshot_lock);
+    config.screenshot_name = std::move(m_screenshot_name);
+    m_screenshot_name.clear();
+  }
+
+  {
+    // Only stall if the frame dumping thread has fallen too far behind.
+    std::unique_lock<std::mutex> lk(m_frame_dump_lock);
+    m_frame_dump_done.wait(
+        lk, [this] { return m_frame_dump_frames_in_flight < MAX_QUEUED_FRAME_DUMPS; });
+    m_frame_dump_frames_in_flight++;
+
+    if (!m_frame_dump_buffer_pool.empty())
+    {
+      config.data = std::move(m_frame_dump_buffer_pool.back());
+      m_frame_dump_buffer_pool.pop_back();
+    }
+  }
+
+  // Copy the frame out of the mapped texture without holding the lock, so that the frame dumping
+  // thread can keep returning buffers while we do so.
+  config.data.resize(static_cast<size_t>(stride) * h);
+  std::memcpy(config.data.data(), data, config.data.size());
+
+  std::lock_guard<std::mutex> lk(m_frame_dump_lock);
+  m_frame_dump_queue.push_back(std::move(config));
+  m_frame_dump_queued.notify_one();
 }
 
 void Renderer::FinishFrameData()
 {
-  if (!m_frame_dump_frame_running)
-    return;
+  std::unique_lock<std::mutex> lk(m_frame_dump_lock);
+  m_frame_dump_done.wait(lk, [this] { return m_frame_dump_frames_in_flight == 0; });
+}
 
-  m_frame_dump_done.Wait();
-  m_frame_dump_frame_running = false;
-  m_frame_dump_config.texture->Unmap();
+void Renderer::ReleaseFrameDumpBuffer(std::vector<u8> buffer)
+{
+  std::lock_guard<std::mutex> lk(m_frame_dump_lock);
+  if (m_frame_dump_buffer_pool.size() < MAX_QUEUED_FRAME_DUMPS)
+    m_frame_dump_buffer_pool.push_back(std::move(buffer));
+  m_frame_dump_frames_in_flight--;
+  m_frame_dump_done.notify_all();
 }
 
 void Renderer::RunFrameDumps()
@@ -828,23 +882,27 @@ void Renderer::RunFrameDumps()
 
   while (true)
   {
-    m_frame_dump_start.Wait();
-    if (!m_frame_dump_thread_running.IsSet())
-      break;
-
-    auto config = m_frame_dump_config;
+    FrameDumpConfig config;
+    {
+      // Drain the queue before exiting, so no frames are lost when dumping is stopped.
+      std::unique_lock<std::mutex> lk(m_frame_dump_lock);
+      m_frame_dump_queued.wait(lk, [this] {
+        return !m_frame_dump_queue.empty() || !m_frame_dump_thread_running.IsSet();
+      });
+      if (m_frame_dump_queue.empty())
+        break;
+
+      config = std::move(m_frame_dump_queue.front());
+      m_frame_dump_queue.pop_front();
+    }
 
     // Save screenshot
-    if (m_screenshot_request.TestAndClear())
+    if (!config.screenshot_name.empty())
     {
-      std::lock_guard<std::mutex> lk(m_screenshot_lock);
-
-      if (TextureToPng(config.data, config.stride, m_screenshot_name, config.width, config.height,
-                       false))
-        OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
+      if (TextureToPng(config.data.data(), config.stride, config.screenshot_name, config.width,
+                       config.height, false))
+        OSD::AddMessage("Screenshot saved to " + config.screenshot_name);
 
-      // Reset settings
-      m_screenshot_name.clear();
       m_screenshot_completed.Set();
     }
 
@@ -863,18 +921,22 @@ void Renderer::RunFrameDumps()
       }
 
       // If we failed to start frame dumping, don't write a frame.
-      if (frame_dump_started)
+      if (frame_dump_started && !dump_to_avi)
       {
-        if (dump_to_avi)
-          DumpFrameToAVI(config);
-        else
-          DumpFrameToImage(config);
+        // The image job takes ownership of the buffer and releases it once the PNG is written.
+        DumpFrameToImage(std::move(config));
+        continue;
       }
+
+      if (frame_dump_started)
+        DumpFrameToAVI(config);
     }
 
-    m_frame_dump_done.Set();
+    ReleaseFrameDumpBuffer(std::move(config.data));
   }
 
+  WaitForFrameDumpImageJobs(0);
+
   if (frame_dump_started)
   {
     // No additional cleanup is needed when dumping to images.
@@ -892,7 +954,7 @@ bool Renderer::StartFrameDumpToAVI(const FrameDumpConfig& config)
 
 void Renderer::DumpFrameToAVI(const FrameDumpConfig& config)
 {
-  AVIDump::AddFrame(config.data, config.width, config.height, config.stride, config.state);
+  AVIDump::AddFrame(config.data.data(), config.width, config.height, config.stride, config.state);
 }
 
 void Renderer::StopFrameDumpToAVI()
@@ -942,11 +1004,30 @@ bool Renderer::StartFrameDumpToImage(const FrameDumpConfig& config)
   return true;
 }
 
-void Renderer::DumpFrameToImage(const FrameDumpConfig& config)
+void Renderer::DumpFrameToImage(FrameDumpConfig config)
 {
+  // PNG compression is by far the most expensive part of dumping to images, and each frame is
+  // independent, so spread the frames over as many threads as the host has cores.
+  WaitForFrameDumpImageJobs(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+
   std::string filename = GetFrameDumpNextImageFileName();
-  TextureToPng(config.data, config.stride, filename, config.width, config.height, false);
   m_frame_dump_image_counter++;
+
+  m_frame_dump_image_jobs.push_back(
+      std::async(std::launch::async, [this, filename, config = std::move(config)]() mutable {
+        TextureToPng(config.data.data(), config.stride, filename, config.width, config.height,
+                     false);
+        ReleaseFrameDumpBuffer(std::move(config.data));
+      }));
+}
+
+void Renderer::WaitForFrameDumpImageJobs(size_t max_pending_jobs)
+{
+  while (m_frame_dump_image_jobs.size() > max_pending_jobs)
+  {
+    m_frame_dump_image_jobs.front().wait();
+    m_frame_dump_image_jobs.pop_front();
+  }
 }
 
 bool Renderer::UseVertexDepthRange() const
@@ -15,6 +15,8 @@
 #pragma once
 
 #include <condition_variable>
+#include <deque>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -127,6 +129,14 @@ public:
 
   virtual u32 AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data) = 0;
   virtual void PokeEFB(EFBAccessType type, const EfbPokeData* points, size_t num_points) = 0;
+  // Peeks every value in rect, as AccessEFB would, into rows of data_stride values. Backends which
+  // read the EFB back in blocks override this; the others return false, and peeks are then
+  // forwarded to AccessEFB one at a time.
+  virtual bool PeekEFBRect(EFBAccessType type, const EFBRectangle& rect, u32* data,
+                           u32 data_stride)
+  {
+    return false;
+  }
 
   virtual u16 BBoxRead(int index) = 0;
   virtual void BBoxWrite(int index, u16 value) = 0;
@@ -197,23 +207,32 @@ private:
   int m_last_window_request_height = 0;
 
   // frame dumping
-  std::thread m_frame_dump_thread;
-  Common::Event m_frame_dump_start;
-  Common::Event m_frame_dump_done;
-  Common::Flag m_frame_dump_thread_running;
-  u32 m_frame_dump_image_counter = 0;
-  bool m_frame_dump_frame_running = false;
   struct FrameDumpConfig
   {
-    AbstractTexture* texture;
-    const u8* data;
+    std::vector<u8> data;
     int width;
     int height;
     int stride;
     AVIDump::Frame state;
-  } m_frame_dump_config;
+    std::string screenshot_name;
+  };
+
+  // Number of frames which can be queued for dumping before the GPU thread has to wait for the
+  // frame dumping thread to catch up. Each queued frame holds a copy of the XFB in system memory.
+  static constexpr size_t MAX_QUEUED_FRAME_DUMPS = 4;
+
+  std::thread m_frame_dump_thread;
+  std::mutex m_frame_dump_lock;
+  std::condition_variable m_frame_dump_queued;
+  std::condition_variable m_frame_dump_done;
+  std::deque<FrameDumpConfig> m_frame_dump_queue;
+  std::vector<std::vector<u8>> m_frame_dump_buffer_pool;
+  size_t m_frame_dump_frames_in_flight = 0;
+  Common::Flag m_frame_dump_thread_running;
+  u32 m_frame_dump_image_counter = 0;
+  std::deque<std::future<void>> m_frame_dump_image_jobs;
 
-  AbstractTexture * m_last_xfb_texture;
+  AbstractTexture* m_last_xfb_texture = nullptr;
 
   // NOTE: The methods below are called on the framedumping thread.
   bool StartFrameDumpToAVI(const FrameDumpConfig& config);
@@ -221,7 +240,9 @@ private:
   void StopFrameDumpToAVI();
   std::string GetFrameDumpNextImageFileName() const;
   bool StartFrameDumpToImage(const FrameDumpConfig& config);
-  void DumpFrameToImage(const FrameDumpConfig& config);
+  void DumpFrameToImage(FrameDumpConfig config);
+  void WaitForFrameDumpImageJobs(size_t max_pending_jobs);
+  void ReleaseFrameDumpBuffer(std::vector<u8> buffer);
 
   bool IsFrameDumping();
   void DumpFrameData(const u8* data, int w, int h, int stride, const AVIDump::Frame& state);
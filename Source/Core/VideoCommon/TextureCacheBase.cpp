@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -39,6 +40,9 @@ static const u64 TEXHASH_INVALID = 0;
 // Sonic the Fighters (inside Sonic Gems Collection) loops a 64 frames animation
 static const int TEXTURE_KILL_THRESHOLD = 64;
 static const int TEXTURE_POOL_KILL_THRESHOLD = 3;
+// Granularity of textures_by_page. Most textures are much smaller than this, while the largest
+// ones (1024x1024 RGBA8) still only span 64 pages.
+static const u32 TEXTURE_PAGE_SHIFT = 16;
 
 std::unique_ptr<TextureCacheBase> g_texture_cache;
 
@@ -75,6 +79,7 @@ TextureCacheBase::TextureCacheBase()
 
   TexDecoder_SetTexFmtOverlayOptions(backup_config.texfmt_overlay,
                                      backup_config.texfmt_overlay_center);
+  TexDecoder_SetDecoderThreads(g_ActiveConfig.GetTextureDecoderThreads());
 
   HiresTexture::Init();
 
@@ -85,6 +90,8 @@ TextureCacheBase::TextureCacheBase()
 
 void TextureCacheBase::Invalidate()
 {
+  pending_efb_copies.clear();
+
   InvalidateAllBindPoints();
   for (size_t i = 0; i < bound_textures.size(); ++i)
   {
@@ -97,6 +104,7 @@ void TextureCacheBase::Invalidate()
   }
   textures_by_address.clear();
   textures_by_hash.clear();
+  textures_by_page.clear();
 
   texture_pool.clear();
 }
@@ -104,6 +112,7 @@ void TextureCacheBase::Invalidate()
 TextureCacheBase::~TextureCacheBase()
 {
   HiresTexture::Shutdown();
+  TexDecoder_SetDecoderThreads(0);
   Invalidate();
   Common::FreeAlignedMemory(temp);
   temp = nullptr;
@@ -124,6 +133,7 @@ void TextureCacheBase::OnConfigChanged(VideoConfig& config)
       config.bHiresTextures != backup_config.hires_textures ||
       config.bEnableGPUTextureDecoding != backup_config.gpu_texture_decoding)
   {
+    FlushEFBCopies();
     Invalidate();
 
     TexDecoder_SetTexFmtOverlayOptions(g_ActiveConfig.bTexFmtOverlayEnable,
@@ -138,6 +148,8 @@ void TextureCacheBase::OnConfigChanged(VideoConfig& config)
       PanicAlert("Failed to recompile one or more texture conversion shaders.");
   }
 
+  TexDecoder_SetDecoderThreads(config.GetTextureDecoderThreads());
+
   SetBackupConfig(config);
 }
 
@@ -247,7 +259,7 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::ApplyPaletteToEntry(TCacheEntry
   decoded_entry->SetMayHaveOverlappingTextures(entry->MayHaveOverlappingTextures());
 
   ConvertTexture(decoded_entry, entry, palette, static_cast<TlutFormat>(tlutfmt));
-  textures_by_address.emplace(entry->addr, decoded_entry);
+  AddTexture(decoded_entry);
 
   return decoded_entry;
 }
@@ -318,13 +330,11 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, u8* pale
 
   u32 numBlocksX = (entry_to_update->native_width + block_width - 1) / block_width;
 
-  auto iter = FindOverlappingTextures(entry_to_update->addr, entry_to_update->size_in_bytes);
-  while (iter.first != iter.second)
+  for (TCacheEntry* entry :
+       FindOverlappingTextures(entry_to_update->addr, entry_to_update->size_in_bytes))
   {
-    TCacheEntry* entry = iter.first->second;
     if (entry != entry_to_update && entry->IsCopy() && !entry->IsOnlyInTMem() &&
         entry->references.count(entry_to_update) == 0 &&
-        entry->OverlapsMemoryRange(entry_to_update->addr, entry_to_update->size_in_bytes) &&
         entry->memory_stride == numBlocksX * block_size)
     {
       if (entry->hash == entry->CalculateHash())
@@ -343,7 +353,6 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, u8* pale
           }
           else
           {
-            ++iter.first;
             continue;
           }
         }
@@ -432,11 +441,9 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, u8* pale
       else
       {
         // If the hash does not match, this EFB copy will not be used for anything, so remove it
-        iter.first = InvalidateTexture(iter.first);
-        continue;
+        InvalidateTexture(GetTexCacheIter(entry));
       }
     }
-    ++iter.first;
   }
   return entry_to_update;
 }
@@ -582,6 +589,10 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::GetTexture(u32 address, u32 wid
     return nullptr;
   }
 
+  // The texture may be the result of an EFB copy which hasn't been written to RAM yet.
+  if (!from_tmem)
+    FlushEFBCopiesInRange(address, texture_size + additional_mips_size);
+
   // If we are recording a FifoLog, keep track of what memory we read.
   // FifiRecorder does it's own memory modification tracking independant of the texture hashing
   // below.
@@ -849,7 +860,6 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::GetTexture(u32 address, u32 wid
     }
   }
 
-  iter = textures_by_address.emplace(address, entry);
   if (textureCacheSafetyColorSampleSize == 0 ||
       std::max(texture_size, palette_size) <=
           (u32)textureCacheSafetyColorSampleSize * 8)
@@ -864,6 +874,7 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::GetTexture(u32 address, u32 wid
   entry->SetNotCopy();
   entry->SetCustomTexture(hires_tex != nullptr);
   entry->memory_stride = entry->BytesPerRow();
+  iter = AddTexture(entry);
 
   std::string basename = "";
   if (g_ActiveConfig.bDumpTextures && !hires_tex)
@@ -895,6 +906,12 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::GetTexture(u32 address, u32 wid
       ptr_odd = &texMem[tmem_address_odd];
     }
 
+    // Mip levels decoded on the CPU are decoded in one batch, so that the decoder threads can
+    // work on several of them at once, and uploaded afterwards.
+    std::vector<TexDecoderJob> mip_jobs;
+    std::vector<size_t> mip_offsets;
+    size_t decoded_mips_size = 0;
+
     for (u32 level = 1; level != texLevels; ++level)
     {
       const u32 mip_width = CalculateLevelSize(width, level);
@@ -916,17 +933,35 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::GetTexture(u32 address, u32 wid
       }
       else
       {
-        // No need to call CheckTempSize here, as mips will always be smaller than the base level.
-        size_t decoded_mip_size = expanded_mip_width * sizeof(u32) * expanded_mip_height;
-        TexDecoder_Decode(temp, mip_src_data, expanded_mip_width, expanded_mip_height, texformat,
-                          tlut, (TlutFormat)tlutfmt);
-        entry->texture->Load(level, mip_width, mip_height, expanded_mip_width, temp,
-                             decoded_mip_size);
+        mip_jobs.push_back({nullptr, mip_src_data, static_cast<int>(expanded_mip_width),
+                            static_cast<int>(expanded_mip_height), texformat, tlut,
+                            static_cast<TlutFormat>(tlutfmt)});
+        mip_offsets.push_back(decoded_mips_size);
+        decoded_mips_size += expanded_mip_width * sizeof(u32) * expanded_mip_height;
       }
 
       mip_src_data += mip_size;
+    }
+
+    if (!mip_jobs.empty())
+    {
+      CheckTempSize(decoded_mips_size);
+      for (size_t i = 0; i < mip_jobs.size(); ++i)
+        mip_jobs[i].dst = temp + mip_offsets[i];
+      TexDecoder_DecodeBatch(mip_jobs.data(), mip_jobs.size());
+
+      for (u32 level = 1; level != texLevels; ++level)
+      {
+        const TexDecoderJob& job = mip_jobs[level - 1];
+        entry->texture->Load(level, CalculateLevelSize(width, level),
+                             CalculateLevelSize(height, level), job.width, job.dst,
+                             job.width * sizeof(u32) * job.height);
+      }
+    }
 
-      if (g_ActiveConfig.bDumpTextures)
+    if (g_ActiveConfig.bDumpTextures)
+    {
+      for (u32 level = 1; level != texLevels; ++level)
         DumpTexture(entry, basename, level);
     }
   }
@@ -1313,14 +1348,37 @@ void TextureCacheBase::CopyRenderTargetToTexture(u32 dstAddr, unsigned int dstFo
   const u32 bytes_per_row = num_blocks_x * bytes_per_block;
   const u32 covered_range = num_blocks_y * dstStride;
 
+  // Deferred copies are only encoded here, and written to RAM once the data may be looked at.
+  // XFB copies are always written right away, since they are displayed at the end of the frame.
+  bool deferred_copy = false;
   if (copy_to_ram)
   {
     EFBCopyFormat format(srcFormat, static_cast<TextureFormat>(dstFormat));
-    CopyEFB(dst, format, tex_w, bytes_per_row, num_blocks_y, dstStride, is_depth_copy, srcRect,
-            scaleByHalf, y_scale);
+    std::unique_ptr<EncodedEFBCopy> encoded_copy;
+    if (g_ActiveConfig.bDeferEFBCopies && !is_xfb_copy)
+    {
+      encoded_copy = EncodeEFBCopy(format, tex_w, bytes_per_row, num_blocks_y, is_depth_copy,
+                                   srcRect, scaleByHalf, y_scale);
+    }
+
+    if (encoded_copy)
+    {
+      pending_efb_copies.push_back(
+          {dstAddr, bytes_per_row, num_blocks_y, dstStride, nullptr, std::move(encoded_copy)});
+      deferred_copy = true;
+    }
+    else
+    {
+      // Older deferred copies must not overwrite this one later on.
+      FlushEFBCopies();
+      CopyEFB(dst, format, tex_w, bytes_per_row, num_blocks_y, dstStride, is_depth_copy, srcRect,
+              scaleByHalf, y_scale);
+    }
   }
   else
   {
+    FlushEFBCopiesInRange(dstAddr, covered_range);
+
     // Hack: Most games don't actually need the correct texture data in RAM
     //       and we can just keep a copy in VRAM. We zero the memory so we
     //       can check it hasn't changed before using our copy in VRAM.
@@ -1364,31 +1422,25 @@ void TextureCacheBase::CopyRenderTargetToTexture(u32 dstAddr, unsigned int dstFo
   // TODO: This also invalidates partial overlaps, which we currently don't have a better way
   //       of dealing with.
   bool strided_efb_copy = dstStride != bytes_per_row;
-  auto iter = FindOverlappingTextures(dstAddr, covered_range);
-  while (iter.first != iter.second)
+  for (TCacheEntry* entry : FindOverlappingTextures(dstAddr, covered_range))
   {
-    TCacheEntry* entry = iter.first->second;
-    if (entry->OverlapsMemoryRange(dstAddr, covered_range))
-    {
-      u32 overlap_range = std::min(entry->addr + entry->size_in_bytes, dstAddr + covered_range) -
-                          std::max(entry->addr, dstAddr);
-      if (entry->memory_stride != dstStride || !copy_to_vram ||
+    u32 overlap_range = std::min(entry->addr + entry->size_in_bytes, dstAddr + covered_range) -
+                        std::max(entry->addr, dstAddr);
+    if (entry->memory_stride != dstStride || !copy_to_vram ||
         (!strided_efb_copy && entry->size_in_bytes == overlap_range) ||
         (strided_efb_copy && entry->size_in_bytes == overlap_range && entry->addr == dstAddr))
-      {
-        iter.first = InvalidateTexture(iter.first);
-        continue;
-      }
-      entry->SetMayHaveOverlappingTextures(true);
+    {
+      InvalidateTexture(GetTexCacheIter(entry));
+      continue;
+    }
+    entry->SetMayHaveOverlappingTextures(true);
 
-      // Do not load textures by hash, if they were at least partly overwritten by an efb copy
-      if (entry->textures_by_hash_iter != textures_by_hash.end())
-      {
-        textures_by_hash.erase(entry->textures_by_hash_iter);
-        entry->textures_by_hash_iter = textures_by_hash.end();
-      }
+    // Do not load textures by hash, if they were at least partly overwritten by an efb copy
+    if (entry->textures_by_hash_iter != textures_by_hash.end())
+    {
+      textures_by_hash.erase(entry->textures_by_hash_iter);
+      entry->textures_by_hash_iter = textures_by_hash.end();
     }
-    ++iter.first;
   }
 
   if (copy_to_vram)
@@ -1423,8 +1475,18 @@ void TextureCacheBase::CopyRenderTargetToTexture(u32 dstAddr, unsigned int dstFo
 
       CopyEFBToCacheEntry(entry, is_depth_copy, srcRect, scaleByHalf, cbufid, colmat);
 
-      u64 hash = entry->CalculateHash();
-      entry->SetHashes(hash, hash);
+      if (deferred_copy)
+      {
+        // The hashes are calculated when the copy is flushed, which happens before anything
+        // looks at this range of RAM.
+        entry->SetHashes(TEXHASH_INVALID, TEXHASH_INVALID);
+        pending_efb_copies.back().entry = entry;
+      }
+      else
+      {
+        u64 hash = entry->CalculateHash();
+        entry->SetHashes(hash, hash);
+      }
 
       if (g_ActiveConfig.bDumpEFBTarget && !is_xfb_copy)
       {
@@ -1444,7 +1506,38 @@ void TextureCacheBase::CopyRenderTargetToTexture(u32 dstAddr, unsigned int dstFo
                              0);
       }
 
-      textures_by_address.emplace(dstAddr, entry);
+      AddTexture(entry);
+    }
+  }
+}
+
+void TextureCacheBase::FlushEFBCopies()
+{
+  // The first copy waits for the GPU, which has finished the later ones by then as well.
+  for (PendingEFBCopy& copy : pending_efb_copies)
+  {
+    u8* dst = Memory::GetPointer(copy.dst_addr);
+    copy.data->WriteToMemory(dst, copy.bytes_per_row, copy.num_blocks_y, copy.memory_stride);
+
+    if (copy.entry)
+    {
+      u64 hash = copy.entry->CalculateHash();
+      copy.entry->SetHashes(hash, hash);
+    }
+  }
+  pending_efb_copies.clear();
+}
+
+void TextureCacheBase::FlushEFBCopiesInRange(u32 address, u32 size)
+{
+  // Copies are flushed all together, so that newer copies still end up on top of older ones.
+  for (const PendingEFBCopy& copy : pending_efb_copies)
+  {
+    const u32 covered_range = copy.num_blocks_y * copy.memory_stride;
+    if (copy.dst_addr < address + size && address < copy.dst_addr + covered_range)
+    {
+      FlushEFBCopies();
+      return;
     }
   }
 }
@@ -1514,21 +1607,50 @@ TextureCacheBase::GetTexCacheIter(TextureCacheBase::TCacheEntry* entry)
   return textures_by_address.end();
 }
 
-std::pair<TextureCacheBase::TexAddrCache::iterator, TextureCacheBase::TexAddrCache::iterator>
+// Returns the first and the last page touched by a memory range. Empty ranges are treated as
+// touching the page of their address.
+static std::pair<u32, u32> GetTexturePageRange(u32 addr, u32 size_in_bytes)
+{
+  const u64 last_byte = std::min<u64>(static_cast<u64>(addr) + std::max(size_in_bytes, 1u) - 1,
+                                      std::numeric_limits<u32>::max());
+  return std::make_pair(addr >> TEXTURE_PAGE_SHIFT,
+                        static_cast<u32>(last_byte >> TEXTURE_PAGE_SHIFT));
+}
+
+TextureCacheBase::TexAddrCache::iterator TextureCacheBase::AddTexture(TCacheEntry* entry)
+{
+  const auto pages = GetTexturePageRange(entry->addr, entry->size_in_bytes);
+  for (u32 page = pages.first; page <= pages.second; ++page)
+    textures_by_page[page].push_back(entry);
+
+  return textures_by_address.emplace(entry->addr, entry);
+}
+
+std::vector<TextureCacheBase::TCacheEntry*>
 TextureCacheBase::FindOverlappingTextures(u32 addr, u32 size_in_bytes)
 {
-  // We index by the starting address only, so there is no way to query all textures
-  // which end after the given addr. But the GC textures have a limited size, so we
-  // look for all textures which have a start address bigger than addr minus the maximal
-  // texture size. But this yields false-positives which must be checked later on.
-
-  // 1024 x 1024 texel times 8 nibbles per texel
-  constexpr u32 max_texture_size = 1024 * 1024 * 4;
-  u32 lower_addr = addr > max_texture_size ? addr - max_texture_size : 0;
-  auto begin = textures_by_address.lower_bound(lower_addr);
-  auto end = textures_by_address.upper_bound(addr + size_in_bytes);
-
-  return std::make_pair(begin, end);
+  std::vector<TCacheEntry*> result;
+  const auto pages = GetTexturePageRange(addr, size_in_bytes);
+  for (u32 page = pages.first; page <= pages.second; ++page)
+  {
+    auto bucket = textures_by_page.find(page);
+    if (bucket == textures_by_page.end())
+      continue;
+
+    for (TCacheEntry* entry : bucket->second)
+    {
+      // A texture spanning several of the queried pages is only reported from the first of them.
+      const u32 first_page = std::max(entry->addr >> TEXTURE_PAGE_SHIFT, pages.first);
+      if (first_page == page && entry->OverlapsMemoryRange(addr, size_in_bytes))
+        result.push_back(entry);
+    }
+  }
+
+  // Buckets keep their textures in insertion order, so a stable sort orders textures at the
+  // same address the same way as textures_by_address does.
+  std::stable_sort(result.begin(), result.end(),
+                   [](const TCacheEntry* a, const TCacheEntry* b) { return a->addr < b->addr; });
+  return result;
 }
 
 TextureCacheBase::TexAddrCache::iterator
@@ -1557,6 +1679,22 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter)
     }
   }
 
+  // The data of a deferred EFB copy still has to reach RAM, but the entry is gone.
+  for (PendingEFBCopy& copy : pending_efb_copies)
+  {
+    if (copy.entry == entry)
+      copy.entry = nullptr;
+  }
+
+  const auto pages = GetTexturePageRange(entry->addr, entry->size_in_bytes);
+  for (u32 page = pages.first; page <= pages.second; ++page)
+  {
+    auto bucket = textures_by_page.find(page);
+    bucket->second.erase(std::find(bucket->second.begin(), bucket->second.end(), entry));
+    if (bucket->second.empty())
+      textures_by_page.erase(bucket);
+  }
+
   auto config = entry->texture->GetConfig();
   texture_pool.emplace(config, TexPoolEntry(std::move(entry->texture)));
 
@@ -11,6 +11,7 @@
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "VideoCommon/AbstractTexture.h"
@@ -139,6 +140,18 @@ public:
     u32 format;  // bits 0-3 will contain the in-memory format.
   };
 
+  // EFB copy data which has been encoded by the GPU, but not yet written to emulated RAM.
+  class EncodedEFBCopy
+  {
+  public:
+    virtual ~EncodedEFBCopy() = default;
+
+    // Waits for the GPU to finish encoding if necessary, and writes num_blocks_y rows of
+    // bytes_per_row bytes to dst, memory_stride bytes apart.
+    virtual void WriteToMemory(u8* dst, u32 bytes_per_row, u32 num_blocks_y,
+                               u32 memory_stride) = 0;
+  };
+
   virtual ~TextureCacheBase();  // needs virtual for DX11 dtor
 
   void OnConfigChanged(VideoConfig& config);
@@ -147,12 +160,30 @@ public:
   // frameCount is the current frame number.
   void Cleanup(int _frameCount);
 
+  // Also drops all deferred EFB copies without writing them to RAM.
   void Invalidate();
 
+  // Writes all deferred EFB copies to RAM, in the order they were made. This has to happen
+  // whenever the CPU could look at the copied data, e.g. at PE tokens and draw done events.
+  void FlushEFBCopies();
+
+  // Flushes the deferred EFB copies if any of them overlaps the given range of emulated RAM.
+  void FlushEFBCopiesInRange(u32 address, u32 size);
+
   virtual void CopyEFB(u8* dst, const EFBCopyFormat& format, u32 native_width, u32 bytes_per_row,
                        u32 num_blocks_y, u32 memory_stride, bool is_depth_copy,
                        const EFBRectangle& src_rect, bool scale_by_half, float y_scale) = 0;
 
+  // Like CopyEFB, but only queues the encoding on the GPU without waiting for the result.
+  // Returns nullptr if the backend can't defer EFB copies, in which case CopyEFB is used.
+  virtual std::unique_ptr<EncodedEFBCopy>
+  EncodeEFBCopy(const EFBCopyFormat& format, u32 native_width, u32 bytes_per_row,
+                u32 num_blocks_y, bool is_depth_copy, const EFBRectangle& src_rect,
+                bool scale_by_half, float y_scale)
+  {
+    return nullptr;
+  }
+
   virtual bool CompileShaders() = 0;
   virtual void DeleteShaders() = 0;
 
@@ -213,6 +244,18 @@ private:
   typedef std::multimap<u64, TCacheEntry*> TexHashCache;
   typedef std::unordered_multimap<TextureConfig, TexPoolEntry, TextureConfig::Hasher> TexPool;
 
+  struct PendingEFBCopy
+  {
+    u32 dst_addr;
+    u32 bytes_per_row;
+    u32 num_blocks_y;
+    u32 memory_stride;
+    // The VRAM copy made alongside, if any. Its hashes can only be calculated once the data has
+    // been written to RAM.
+    TCacheEntry* entry;
+    std::unique_ptr<EncodedEFBCopy> data;
+  };
+
   void SetBackupConfig(const VideoConfig& config);
 
   TCacheEntry* ApplyPaletteToEntry(TCacheEntry* entry, u8* palette, u32 tlutfmt);
@@ -227,10 +270,13 @@ private:
   TexPool::iterator FindMatchingTextureFromPool(const TextureConfig& config);
   TexAddrCache::iterator GetTexCacheIter(TCacheEntry* entry);
 
-  // Return all possible overlapping textures. As addr+size of the textures is not
-  // indexed, this may return false positives.
-  std::pair<TexAddrCache::iterator, TexAddrCache::iterator>
-  FindOverlappingTextures(u32 addr, u32 size_in_bytes);
+  // Adds the entry to textures_by_address and to the page index. The address and size of the
+  // entry must not change while it is in the cache.
+  TexAddrCache::iterator AddTexture(TCacheEntry* entry);
+
+  // Return all textures which overlap the given range, ordered by address like
+  // textures_by_address.
+  std::vector<TCacheEntry*> FindOverlappingTextures(u32 addr, u32 size_in_bytes);
 
   virtual std::unique_ptr<AbstractTexture> CreateTexture(const TextureConfig& config) = 0;
 
@@ -243,7 +289,11 @@ private:
 
   TexAddrCache textures_by_address;
   TexHashCache textures_by_hash;
+  // Every texture in textures_by_address is also listed for each page its memory range touches,
+  // so that FindOverlappingTextures only looks at textures near the queried range.
+  std::unordered_map<u32, std::vector<TCacheEntry*>> textures_by_page;
   TexPool texture_pool;
+  std::vector<PendingEFBCopy> pending_efb_copies;
 
   // Backup configuration values
   struct BackupConfig
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <tuple>
 #include "Common/CommonTypes.h"
 
@@ -98,6 +99,25 @@ int TexDecoder_GetEfbCopyBaseFormat(int format);
 
 void TexDecoder_Decode(u8* dst, const u8* src, int width, int height, int texformat, const u8* tlut,
                        TlutFormat tlutfmt);
+
+// A texture or mip level for TexDecoder_DecodeBatch, with the same meaning as the arguments of
+// TexDecoder_Decode.
+struct TexDecoderJob
+{
+  u8* dst;
+  const u8* src;
+  int width;
+  int height;
+  int texformat;
+  const u8* tlut;
+  TlutFormat tlutfmt;
+};
+
+// Decodes all jobs and returns once they are done. Large jobs are split into ranges of block rows,
+// which are spread across the decoder threads along with the other jobs.
+void TexDecoder_DecodeBatch(const TexDecoderJob* jobs, size_t num_jobs);
+// Sets the number of threads helping the calling thread with TexDecoder_DecodeBatch.
+void TexDecoder_SetDecoderThreads(u32 num_threads);
 void TexDecoder_DecodeRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* src_gb, int width,
                                     int height);
 void TexDecoder_DecodeTexel(u8* dst, const u8* src, int s, int t, int imageWidth, int texformat,
@@ -110,3 +130,7 @@ void TexDecoder_SetTexFmtOverlayOptions(bool enable, bool center);
 /* Internal method, implemented by TextureDecoder_Generic and TextureDecoder_x64. */
 void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, int texformat,
                             const u8* tlut, TlutFormat tlutfmt);
+/* The portable implementation in TextureDecoder_Generic. It is built on all architectures, as the
+   reference the optimized decoders are tested against. */
+void _TexDecoder_DecodeImpl_Generic(u32* dst, const u8* src, int width, int height, int texformat,
+                                    const u8* tlut, TlutFormat tlutfmt);
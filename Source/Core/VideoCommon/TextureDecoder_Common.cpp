@@ -4,11 +4,17 @@
 
 #include <algorithm>
 #include <cmath>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/MathUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
+#include "Common/Thread.h"
 
 #include "VideoCommon/LookUpTables.h"
 #include "VideoCommon/TextureDecoder.h"
@@ -372,13 +378,160 @@ static void TexDecoder_DrawOverlay(u8* dst, int width, int height, int texformat
   }
 }
 
-void TexDecoder_Decode(u8* dst, const u8* src, int width, int height, int texformat, const u8* tlut,
-                       TlutFormat tlutfmt)
+namespace
 {
-  _TexDecoder_DecodeImpl((u32*)dst, src, width, height, texformat, tlut, tlutfmt);
+// Runs the tasks of a batch on the calling thread and the worker threads, and waits until all of
+// them are done.
+class DecoderThreadPool
+{
+public:
+  ~DecoderThreadPool() { SetNumThreads(0); }
+
+  void SetNumThreads(u32 num_threads)
+  {
+    if (num_threads == m_threads.size())
+      return;
+
+    {
+      std::lock_guard<std::mutex> guard(m_lock);
+      m_exit = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& thread : m_threads)
+      thread.join();
+    m_threads.clear();
+    m_exit = false;
+
+    for (u32 i = 0; i < num_threads; ++i)
+      m_threads.emplace_back(&DecoderThreadPool::WorkerThread, this);
+  }
+
+  bool HasThreads() const { return !m_threads.empty(); }
+
+  void Run(size_t num_tasks, const std::function<void(size_t)>& task)
+  {
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_task = &task;
+    m_num_tasks = num_tasks;
+    m_next_task = 0;
+    m_remaining_tasks = num_tasks;
+    m_wake.notify_all();
+
+    RunTasks(lock);
+    m_done.wait(lock, [this] { return m_remaining_tasks == 0; });
+    m_task = nullptr;
+    m_num_tasks = 0;
+  }
+
+private:
+  void WorkerThread()
+  {
+    Common::SetCurrentThreadName("Texture decoder");
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    while (true)
+    {
+      m_wake.wait(lock, [this] { return m_exit || m_next_task < m_num_tasks; });
+      if (m_exit)
+        return;
+      RunTasks(lock);
+    }
+  }
+
+  // Takes tasks until there are none left. m_lock is only held while picking a task.
+  void RunTasks(std::unique_lock<std::mutex>& lock)
+  {
+    while (m_next_task < m_num_tasks)
+    {
+      const size_t index = m_next_task++;
+      const std::function<void(size_t)>& task = *m_task;
+      lock.unlock();
+      task(index);
+      lock.lock();
+      if (--m_remaining_tasks == 0)
+        m_done.notify_one();
+    }
+  }
+
+  std::vector<std::thread> m_threads;
+  std::mutex m_lock;
+  std::condition_variable m_wake;
+  std::condition_variable m_done;
+  const std::function<void(size_t)>* m_task = nullptr;
+  size_t m_num_tasks = 0;
+  size_t m_next_task = 0;
+  size_t m_remaining_tasks = 0;
+  bool m_exit = false;
+};
+
+struct DecoderTask
+{
+  const TexDecoderJob* job;
+  int first_row;
+  int num_rows;
+};
+}  // Anonymous namespace
+
+// Jobs are split into tasks of at least this many texels, which keeps the cost of handing a task
+// to another thread small compared to decoding it.
+static const int MIN_TEXELS_PER_TASK = 32 * 1024;
+
+static DecoderThreadPool s_decoder_pool;
+// Held while the pool is used. Batches from other threads are decoded on their own thread.
+static std::mutex s_decoder_pool_lock;
+
+void TexDecoder_SetDecoderThreads(u32 num_threads)
+{
+  std::lock_guard<std::mutex> guard(s_decoder_pool_lock);
+  s_decoder_pool.SetNumThreads(num_threads);
+}
+
+void TexDecoder_DecodeBatch(const TexDecoderJob* jobs, size_t num_jobs)
+{
+  std::vector<DecoderTask> tasks;
+  for (size_t i = 0; i < num_jobs; ++i)
+  {
+    const TexDecoderJob& job = jobs[i];
+    const int block_height = TexDecoder_GetBlockHeightInTexels(job.texformat);
+    const int rows_per_task =
+        std::max(MIN_TEXELS_PER_TASK / std::max(job.width * block_height, 1), 1) * block_height;
+    for (int row = 0; row < job.height; row += rows_per_task)
+      tasks.push_back({&job, row, std::min(rows_per_task, job.height - row)});
+  }
+
+  const std::function<void(size_t)> decode_task = [&tasks](size_t index) {
+    const DecoderTask& task = tasks[index];
+    const TexDecoderJob& job = *task.job;
+    // Both the source and the destination of a range of block rows are contiguous.
+    _TexDecoder_DecodeImpl(reinterpret_cast<u32*>(job.dst) + task.first_row * job.width,
+                           job.src + TexDecoder_GetTextureSizeInBytes(job.width, task.first_row,
+                                                                      job.texformat),
+                           job.width, task.num_rows, job.texformat, job.tlut, job.tlutfmt);
+  };
+
+  std::unique_lock<std::mutex> pool_lock(s_decoder_pool_lock, std::try_to_lock);
+  if (tasks.size() > 1 && pool_lock && s_decoder_pool.HasThreads())
+  {
+    s_decoder_pool.Run(tasks.size(), decode_task);
+  }
+  else
+  {
+    for (size_t i = 0; i < tasks.size(); ++i)
+      decode_task(i);
+  }
 
   if (TexFmt_Overlay_Enable)
-    TexDecoder_DrawOverlay(dst, width, height, texformat);
+  {
+    for (size_t i = 0; i < num_jobs; ++i)
+      TexDecoder_DrawOverlay(jobs[i].dst, jobs[i].width, jobs[i].height, jobs[i].texformat);
+  }
+}
+
+void TexDecoder_Decode(u8* dst, const u8* src, int width, int height, int texformat, const u8* tlut,
+                       TlutFormat tlutfmt)
+{
+  const TexDecoderJob job = {dst, src, width, height, texformat, tlut, tlutfmt};
+  TexDecoder_DecodeBatch(&job, 1);
 }
 
 static inline u32 DecodePixel_IA8(u16 val)
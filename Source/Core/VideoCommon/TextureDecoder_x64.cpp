@@ -162,6 +162,123 @@ static inline void DecodeBytes_IA4(u32* dst, const u8* src)
   }
 }
 
+// AVX2 helpers. The texels are processed in 32-bit lanes: on input, a lane holds a 16-bit color
+// in its lower half and zero in its upper half. On output, it holds the decoded RGBA8 color.
+
+FUNCTION_TARGET_AVX2
+static inline __m256i DecodePixels_IA8_AVX2(__m256i val)
+{
+  // (0 0 I A) -> (A I I I)
+  const __m256i mask = _mm256_setr_epi8(1, 1, 1, 0, 5, 5, 5, 4, 9, 9, 9, 8, 13, 13, 13, 12, 1, 1,
+                                        1, 0, 5, 5, 5, 4, 9, 9, 9, 8, 13, 13, 13, 12);
+  return _mm256_shuffle_epi8(val, mask);
+}
+
+FUNCTION_TARGET_AVX2
+static inline __m256i DecodePixels_RGB565_AVX2(__m256i val)
+{
+  const __m256i kMask_x1f = _mm256_set1_epi32(0x1f);
+  const __m256i kMask_x3f = _mm256_set1_epi32(0x3f);
+
+  // Swizzle bits: 00012345 -> 12345123 and 00123456 -> 12345612
+  const __m256i r5 = _mm256_and_si256(_mm256_srli_epi32(val, 11), kMask_x1f);
+  const __m256i g6 = _mm256_and_si256(_mm256_srli_epi32(val, 5), kMask_x3f);
+  const __m256i b5 = _mm256_and_si256(val, kMask_x1f);
+  const __m256i r = _mm256_or_si256(_mm256_slli_epi32(r5, 3), _mm256_srli_epi32(r5, 2));
+  const __m256i g = _mm256_or_si256(_mm256_slli_epi32(g6, 2), _mm256_srli_epi32(g6, 4));
+  const __m256i b = _mm256_or_si256(_mm256_slli_epi32(b5, 3), _mm256_srli_epi32(b5, 2));
+
+  return _mm256_or_si256(_mm256_or_si256(r, _mm256_slli_epi32(g, 8)),
+                         _mm256_or_si256(_mm256_slli_epi32(b, 16), _mm256_set1_epi32(0xFF000000)));
+}
+
+FUNCTION_TARGET_AVX2
+static inline __m256i DecodePixels_RGB5A3_AVX2(__m256i val)
+{
+  const __m256i kMask_x1f = _mm256_set1_epi32(0x1f);
+  const __m256i kMask_x0f = _mm256_set1_epi32(0x0f);
+  const __m256i kMask_x07 = _mm256_set1_epi32(0x07);
+
+  // Both encodings are decoded for all texels, and the top bit selects between them.
+
+  // RGB555 with an alpha of 0xFF. Swizzle bits: 00012345 -> 12345123
+  const __m256i r5 = _mm256_and_si256(_mm256_srli_epi32(val, 10), kMask_x1f);
+  const __m256i g5 = _mm256_and_si256(_mm256_srli_epi32(val, 5), kMask_x1f);
+  const __m256i b5 = _mm256_and_si256(val, kMask_x1f);
+  const __m256i r0 = _mm256_or_si256(_mm256_slli_epi32(r5, 3), _mm256_srli_epi32(r5, 2));
+  const __m256i g0 = _mm256_or_si256(_mm256_slli_epi32(g5, 3), _mm256_srli_epi32(g5, 2));
+  const __m256i b0 = _mm256_or_si256(_mm256_slli_epi32(b5, 3), _mm256_srli_epi32(b5, 2));
+  const __m256i rgb555 =
+      _mm256_or_si256(_mm256_or_si256(r0, _mm256_slli_epi32(g0, 8)),
+                      _mm256_or_si256(_mm256_slli_epi32(b0, 16), _mm256_set1_epi32(0xFF000000)));
+
+  // RGBA4443. Swizzle bits: 00001234 -> 12341234 and 00000123 -> 12312312
+  const __m256i r4 = _mm256_and_si256(_mm256_srli_epi32(val, 8), kMask_x0f);
+  const __m256i g4 = _mm256_and_si256(_mm256_srli_epi32(val, 4), kMask_x0f);
+  const __m256i b4 = _mm256_and_si256(val, kMask_x0f);
+  const __m256i a3 = _mm256_and_si256(_mm256_srli_epi32(val, 12), kMask_x07);
+  const __m256i r1 = _mm256_or_si256(_mm256_slli_epi32(r4, 4), r4);
+  const __m256i g1 = _mm256_or_si256(_mm256_slli_epi32(g4, 4), g4);
+  const __m256i b1 = _mm256_or_si256(_mm256_slli_epi32(b4, 4), b4);
+  const __m256i a1 =
+      _mm256_or_si256(_mm256_slli_epi32(a3, 5),
+                      _mm256_or_si256(_mm256_slli_epi32(a3, 2), _mm256_srli_epi32(a3, 1)));
+  const __m256i rgba4443 =
+      _mm256_or_si256(_mm256_or_si256(r1, _mm256_slli_epi32(g1, 8)),
+                      _mm256_or_si256(_mm256_slli_epi32(b1, 16), _mm256_slli_epi32(a1, 24)));
+
+  const __m256i is_rgb555 = _mm256_srai_epi32(_mm256_slli_epi32(val, 16), 31);
+  return _mm256_blendv_epi8(rgba4443, rgb555, is_rgb555);
+}
+
+// Decodes palette entries, as read from the TLUT in memory.
+FUNCTION_TARGET_AVX2
+static inline __m256i DecodeTlutEntries_AVX2(__m256i entries, TlutFormat tlutfmt)
+{
+  // The RGB565 and RGB5A3 entries are big-endian.
+  const __m256i swap16 = _mm256_setr_epi8(1, 0, -128, -128, 5, 4, -128, -128, 9, 8, -128, -128,
+                                          13, 12, -128, -128, 1, 0, -128, -128, 5, 4, -128, -128,
+                                          9, 8, -128, -128, 13, 12, -128, -128);
+  switch (tlutfmt)
+  {
+  case GX_TL_IA8:
+    return DecodePixels_IA8_AVX2(entries);
+  case GX_TL_RGB565:
+    return DecodePixels_RGB565_AVX2(_mm256_shuffle_epi8(entries, swap16));
+  case GX_TL_RGB5A3:
+    return DecodePixels_RGB5A3_AVX2(_mm256_shuffle_epi8(entries, swap16));
+  default:
+    return _mm256_setzero_si256();
+  }
+}
+
+// Reads the palette entries of 8 texels. To avoid reading past the end of the palette, the 32-bit
+// words containing the entries are gathered, and the wanted halves shifted down.
+FUNCTION_TARGET_AVX2
+static inline __m256i GatherTlutEntries_AVX2(const u8* tlut, __m256i indices)
+{
+  const __m256i words =
+      _mm256_i32gather_epi32(reinterpret_cast<const int*>(tlut), _mm256_srli_epi32(indices, 1), 4);
+  const __m256i shifts = _mm256_slli_epi32(_mm256_and_si256(indices, _mm256_set1_epi32(1)), 4);
+  return _mm256_and_si256(_mm256_srlv_epi32(words, shifts), _mm256_set1_epi32(0xFFFF));
+}
+
+// Loads two rows of a 4x4 block of big-endian 16-bit texels, one texel per 32-bit lane.
+FUNCTION_TARGET_AVX2
+static inline __m256i LoadTwoRowsBE16_AVX2(const u8* src)
+{
+  const __m128i swap16 = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+  return _mm256_cvtepu16_epi32(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)src), swap16));
+}
+
+// Stores 4 texels to each of two rows.
+FUNCTION_TARGET_AVX2
+static inline void StoreTwoRows_AVX2(u32* row0, u32* row1, __m256i texels)
+{
+  _mm_storeu_si128((__m128i*)row0, _mm256_castsi256_si128(texels));
+  _mm_storeu_si128((__m128i*)row1, _mm256_extracti128_si256(texels, 1));
+}
+
 #ifdef CHECK
 static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
 {
@@ -250,6 +367,41 @@ static void TexDecoder_DecodeImpl_C4(u32* dst, const u8* src, int width, int hei
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_C4_AVX2(u32* dst, const u8* src, int width, int height,
+                                          int texformat, const u8* tlut, TlutFormat tlutfmt,
+                                          int Wsteps4, int Wsteps8)
+{
+  // The 16 palette entries are decoded once, and looked up with permutes.
+  const __m256i palette_lo =
+      DecodeTlutEntries_AVX2(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)tlut)), tlutfmt);
+  const __m256i palette_hi = DecodeTlutEntries_AVX2(
+      _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(tlut + 16))), tlutfmt);
+  // Shifts bringing the nibble of each texel of a row down, the high nibble of a byte coming first.
+  const __m256i shifts = _mm256_setr_epi32(4, 0, 12, 8, 20, 16, 28, 24);
+  const __m256i kMask_x0f = _mm256_set1_epi32(0x0f);
+  const __m256i kIndex_x07 = _mm256_set1_epi32(0x07);
+
+  for (int y = 0; y < height; y += 8)
+  {
+    for (int x = 0, yStep = (y / 8) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      // An 8x8 block is 8 rows of 4 bytes.
+      const __m256i block = _mm256_loadu_si256((const __m256i*)(src + 32 * yStep));
+      for (int iy = 0; iy < 8; iy++)
+      {
+        const __m256i row = _mm256_permutevar8x32_epi32(block, _mm256_set1_epi32(iy));
+        const __m256i indices = _mm256_and_si256(_mm256_srlv_epi32(row, shifts), kMask_x0f);
+        const __m256i use_hi = _mm256_cmpgt_epi32(indices, kIndex_x07);
+        const __m256i texels =
+            _mm256_blendv_epi8(_mm256_permutevar8x32_epi32(palette_lo, indices),
+                               _mm256_permutevar8x32_epi32(palette_hi, indices), use_hi);
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy) * width + x), texels);
+      }
+    }
+  }
+}
+
 FUNCTION_TARGET_SSSE3
 static void TexDecoder_DecodeImpl_I4_SSSE3(u32* dst, const u8* src, int width, int height,
                                            int texformat, const u8* tlut, TlutFormat tlutfmt,
@@ -389,6 +541,53 @@ static void TexDecoder_DecodeImpl_I4(u32* dst, const u8* src, int width, int hei
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_I4_AVX2(u32* dst, const u8* src, int width, int height,
+                                          int texformat, const u8* tlut, TlutFormat tlutfmt,
+                                          int Wsteps4, int Wsteps8)
+{
+  const __m256i kMask_x0f = _mm256_set1_epi8(0x0f);
+  // Replicate the first and the second 8 bytes of a 128-bit lane to 32-bit texels, with the lower
+  // 128 bits of the output coming from the first 4 bytes.
+  const __m256i mask_row0 = _mm256_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4,
+                                             4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7);
+  const __m256i mask_row1 = _mm256_add_epi8(mask_row0, _mm256_set1_epi8(8));
+
+  for (int y = 0; y < height; y += 8)
+  {
+    for (int x = 0, yStep = (y / 8) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      // An 8x8 block is 8 rows of 4 bytes, each holding two texels.
+      const __m256i block = _mm256_loadu_si256((const __m256i*)(src + 32 * yStep));
+
+      // Expand the nibbles to bytes: 0000abcd -> abcdabcd
+      const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(block, 4), kMask_x0f);
+      const __m256i lo = _mm256_and_si256(block, kMask_x0f);
+      const __m256i hi8 = _mm256_or_si256(hi, _mm256_slli_epi16(hi, 4));
+      const __m256i lo8 = _mm256_or_si256(lo, _mm256_slli_epi16(lo, 4));
+
+      // Interleave them to put the texels in order. Each 128-bit lane now holds two rows:
+      // rows 0, 1 and 4, 5 in rows_a, rows 2, 3 and 6, 7 in rows_b.
+      const __m256i rows_a = _mm256_unpacklo_epi8(hi8, lo8);
+      const __m256i rows_b = _mm256_unpackhi_epi8(hi8, lo8);
+      const __m256i rows01 = _mm256_permute2x128_si256(rows_a, rows_a, 0x00);
+      const __m256i rows23 = _mm256_permute2x128_si256(rows_b, rows_b, 0x00);
+      const __m256i rows45 = _mm256_permute2x128_si256(rows_a, rows_a, 0x11);
+      const __m256i rows67 = _mm256_permute2x128_si256(rows_b, rows_b, 0x11);
+
+      u32* row = dst + y * width + x;
+      _mm256_storeu_si256((__m256i*)(row + 0 * width), _mm256_shuffle_epi8(rows01, mask_row0));
+      _mm256_storeu_si256((__m256i*)(row + 1 * width), _mm256_shuffle_epi8(rows01, mask_row1));
+      _mm256_storeu_si256((__m256i*)(row + 2 * width), _mm256_shuffle_epi8(rows23, mask_row0));
+      _mm256_storeu_si256((__m256i*)(row + 3 * width), _mm256_shuffle_epi8(rows23, mask_row1));
+      _mm256_storeu_si256((__m256i*)(row + 4 * width), _mm256_shuffle_epi8(rows45, mask_row0));
+      _mm256_storeu_si256((__m256i*)(row + 5 * width), _mm256_shuffle_epi8(rows45, mask_row1));
+      _mm256_storeu_si256((__m256i*)(row + 6 * width), _mm256_shuffle_epi8(rows67, mask_row0));
+      _mm256_storeu_si256((__m256i*)(row + 7 * width), _mm256_shuffle_epi8(rows67, mask_row1));
+    }
+  }
+}
+
 FUNCTION_TARGET_SSSE3
 static void TexDecoder_DecodeImpl_I8_SSSE3(u32* dst, const u8* src, int width, int height,
                                            int texformat, const u8* tlut, TlutFormat tlutfmt,
@@ -519,6 +718,34 @@ static void TexDecoder_DecodeImpl_I8(u32* dst, const u8* src, int width, int hei
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_I8_AVX2(u32* dst, const u8* src, int width, int height,
+                                          int texformat, const u8* tlut, TlutFormat tlutfmt,
+                                          int Wsteps4, int Wsteps8)
+{
+  const __m256i mask_row0 = _mm256_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4,
+                                             4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7);
+  const __m256i mask_row1 = _mm256_add_epi8(mask_row0, _mm256_set1_epi8(8));
+
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      // An 8x4 block is 4 rows of 8 bytes. Broadcast each pair of rows to both 128-bit lanes, and
+      // replicate the bytes of a row to 32-bit texels.
+      const __m256i block = _mm256_loadu_si256((const __m256i*)(src + 32 * yStep));
+      const __m256i rows01 = _mm256_permute2x128_si256(block, block, 0x00);
+      const __m256i rows23 = _mm256_permute2x128_si256(block, block, 0x11);
+
+      u32* row = dst + y * width + x;
+      _mm256_storeu_si256((__m256i*)(row + 0 * width), _mm256_shuffle_epi8(rows01, mask_row0));
+      _mm256_storeu_si256((__m256i*)(row + 1 * width), _mm256_shuffle_epi8(rows01, mask_row1));
+      _mm256_storeu_si256((__m256i*)(row + 2 * width), _mm256_shuffle_epi8(rows23, mask_row0));
+      _mm256_storeu_si256((__m256i*)(row + 3 * width), _mm256_shuffle_epi8(rows23, mask_row1));
+    }
+  }
+}
+
 static void TexDecoder_DecodeImpl_C8(u32* dst, const u8* src, int width, int height, int texformat,
                                      const u8* tlut, TlutFormat tlutfmt, int Wsteps4, int Wsteps8)
 {
@@ -556,6 +783,35 @@ static void TexDecoder_DecodeImpl_C8(u32* dst, const u8* src, int width, int hei
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_C8_AVX2(u32* dst, const u8* src, int width, int height,
+                                          int texformat, const u8* tlut, TlutFormat tlutfmt,
+                                          int Wsteps4, int Wsteps8)
+{
+  // The 256 palette entries are decoded once, and looked up with gathers.
+  alignas(32) u32 palette[256];
+  for (int i = 0; i < 256; i += 8)
+  {
+    const __m256i entries = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(tlut + 2 * i)));
+    _mm256_store_si256((__m256i*)(palette + i), DecodeTlutEntries_AVX2(entries, tlutfmt));
+  }
+
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; iy++, xStep++)
+      {
+        const __m256i indices =
+            _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + 8 * xStep)));
+        const __m256i texels =
+            _mm256_i32gather_epi32(reinterpret_cast<const int*>(palette), indices, 4);
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy) * width + x), texels);
+      }
+    }
+  }
+}
+
 static void TexDecoder_DecodeImpl_IA4(u32* dst, const u8* src, int width, int height, int texformat,
                                       const u8* tlut, TlutFormat tlutfmt, int Wsteps4, int Wsteps8)
 {
@@ -571,6 +827,49 @@ static void TexDecoder_DecodeImpl_IA4(u32* dst, const u8* src, int width, int he
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_IA4_AVX2(u32* dst, const u8* src, int width, int height,
+                                           int texformat, const u8* tlut, TlutFormat tlutfmt,
+                                           int Wsteps4, int Wsteps8)
+{
+  const __m256i kMask_x0f = _mm256_set1_epi8(0x0f);
+  // (L A) pairs -> (L L L A) texels, from the first 4 pairs of a 128-bit lane for the lower 128
+  // bits of the output, and from the last 4 pairs for the upper 128 bits.
+  const __m256i mask = _mm256_setr_epi8(0, 0, 0, 1, 2, 2, 2, 3, 4, 4, 4, 5, 6, 6, 6, 7, 8, 8, 8, 9,
+                                        10, 10, 10, 11, 12, 12, 12, 13, 14, 14, 14, 15);
+
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      // An 8x4 block is 4 rows of 8 bytes, with the alpha in the high nibble.
+      const __m256i block = _mm256_loadu_si256((const __m256i*)(src + 32 * yStep));
+
+      // Expand the nibbles to bytes: 0000abcd -> abcdabcd
+      const __m256i a = _mm256_and_si256(_mm256_srli_epi16(block, 4), kMask_x0f);
+      const __m256i l = _mm256_and_si256(block, kMask_x0f);
+      const __m256i a8 = _mm256_or_si256(a, _mm256_slli_epi16(a, 4));
+      const __m256i l8 = _mm256_or_si256(l, _mm256_slli_epi16(l, 4));
+
+      // Each 128-bit lane now holds the 8 (L A) pairs of one row: rows 0 and 2 in rows_a, rows 1
+      // and 3 in rows_b.
+      const __m256i rows_a = _mm256_unpacklo_epi8(l8, a8);
+      const __m256i rows_b = _mm256_unpackhi_epi8(l8, a8);
+
+      const __m256i row0 = _mm256_permute2x128_si256(rows_a, rows_a, 0x00);
+      const __m256i row1 = _mm256_permute2x128_si256(rows_b, rows_b, 0x00);
+      const __m256i row2 = _mm256_permute2x128_si256(rows_a, rows_a, 0x11);
+      const __m256i row3 = _mm256_permute2x128_si256(rows_b, rows_b, 0x11);
+
+      u32* row = dst + y * width + x;
+      _mm256_storeu_si256((__m256i*)(row + 0 * width), _mm256_shuffle_epi8(row0, mask));
+      _mm256_storeu_si256((__m256i*)(row + 1 * width), _mm256_shuffle_epi8(row1, mask));
+      _mm256_storeu_si256((__m256i*)(row + 2 * width), _mm256_shuffle_epi8(row2, mask));
+      _mm256_storeu_si256((__m256i*)(row + 3 * width), _mm256_shuffle_epi8(row3, mask));
+    }
+  }
+}
+
 FUNCTION_TARGET_SSSE3
 static void TexDecoder_DecodeImpl_IA8_SSSE3(u32* dst, const u8* src, int width, int height,
                                             int texformat, const u8* tlut, TlutFormat tlutfmt,
@@ -656,6 +955,27 @@ static void TexDecoder_DecodeImpl_IA8(u32* dst, const u8* src, int width, int he
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_IA8_AVX2(u32* dst, const u8* src, int width, int height,
+                                           int texformat, const u8* tlut, TlutFormat tlutfmt,
+                                           int Wsteps4, int Wsteps8)
+{
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      // A 4x4 block is 4 rows of 4 little-endian 16-bit texels.
+      const u8* block = src + 32 * yStep;
+      const __m256i rows01 = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)block));
+      const __m256i rows23 = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(block + 16)));
+
+      u32* row = dst + y * width + x;
+      StoreTwoRows_AVX2(row, row + width, DecodePixels_IA8_AVX2(rows01));
+      StoreTwoRows_AVX2(row + 2 * width, row + 3 * width, DecodePixels_IA8_AVX2(rows23));
+    }
+  }
+}
+
 static void TexDecoder_DecodeImpl_C14X2(u32* dst, const u8* src, int width, int height,
                                         int texformat, const u8* tlut, TlutFormat tlutfmt,
                                         int Wsteps4, int Wsteps8)
@@ -694,6 +1014,32 @@ static void TexDecoder_DecodeImpl_C14X2(u32* dst, const u8* src, int width, int
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_C14X2_AVX2(u32* dst, const u8* src, int width, int height,
+                                             int texformat, const u8* tlut, TlutFormat tlutfmt,
+                                             int Wsteps4, int Wsteps8)
+{
+  const __m256i kMask_x3fff = _mm256_set1_epi32(0x3fff);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      // A 4x4 block is 4 rows of 4 big-endian 16-bit indices.
+      const u8* block = src + 32 * yStep;
+      const __m256i indices01 = _mm256_and_si256(LoadTwoRowsBE16_AVX2(block), kMask_x3fff);
+      const __m256i indices23 = _mm256_and_si256(LoadTwoRowsBE16_AVX2(block + 16), kMask_x3fff);
+      const __m256i texels01 =
+          DecodeTlutEntries_AVX2(GatherTlutEntries_AVX2(tlut, indices01), tlutfmt);
+      const __m256i texels23 =
+          DecodeTlutEntries_AVX2(GatherTlutEntries_AVX2(tlut, indices23), tlutfmt);
+
+      u32* row = dst + y * width + x;
+      StoreTwoRows_AVX2(row, row + width, texels01);
+      StoreTwoRows_AVX2(row + 2 * width, row + 3 * width, texels23);
+    }
+  }
+}
+
 static void TexDecoder_DecodeImpl_RGB565(u32* dst, const u8* src, int width, int height,
                                          int texformat, const u8* tlut, TlutFormat tlutfmt,
                                          int Wsteps4, int Wsteps8)
@@ -765,6 +1111,27 @@ static void TexDecoder_DecodeImpl_RGB565(u32* dst, const u8* src, int width, int
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_RGB565_AVX2(u32* dst, const u8* src, int width, int height,
+                                              int texformat, const u8* tlut, TlutFormat tlutfmt,
+                                              int Wsteps4, int Wsteps8)
+{
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      // A 4x4 block is 4 rows of 4 big-endian 16-bit texels.
+      const u8* block = src + 32 * yStep;
+      const __m256i texels01 = DecodePixels_RGB565_AVX2(LoadTwoRowsBE16_AVX2(block));
+      const __m256i texels23 = DecodePixels_RGB565_AVX2(LoadTwoRowsBE16_AVX2(block + 16));
+
+      u32* row = dst + y * width + x;
+      StoreTwoRows_AVX2(row, row + width, texels01);
+      StoreTwoRows_AVX2(row + 2 * width, row + 3 * width, texels23);
+    }
+  }
+}
+
 FUNCTION_TARGET_SSSE3
 static void TexDecoder_DecodeImpl_RGB5A3_SSSE3(u32* dst, const u8* src, int width, int height,
                                                int texformat, const u8* tlut, TlutFormat tlutfmt,
@@ -992,6 +1359,27 @@ static void TexDecoder_DecodeImpl_RGB5A3(u32* dst, const u8* src, int width, int
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_RGB5A3_AVX2(u32* dst, const u8* src, int width, int height,
+                                              int texformat, const u8* tlut, TlutFormat tlutfmt,
+                                              int Wsteps4, int Wsteps8)
+{
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      // A 4x4 block is 4 rows of 4 big-endian 16-bit texels.
+      const u8* block = src + 32 * yStep;
+      const __m256i texels01 = DecodePixels_RGB5A3_AVX2(LoadTwoRowsBE16_AVX2(block));
+      const __m256i texels23 = DecodePixels_RGB5A3_AVX2(LoadTwoRowsBE16_AVX2(block + 16));
+
+      u32* row = dst + y * width + x;
+      StoreTwoRows_AVX2(row, row + width, texels01);
+      StoreTwoRows_AVX2(row + 2 * width, row + 3 * width, texels23);
+    }
+  }
+}
+
 FUNCTION_TARGET_SSSE3
 static void TexDecoder_DecodeImpl_RGBA8_SSSE3(u32* dst, const u8* src, int width, int height,
                                               int texformat, const u8* tlut, TlutFormat tlutfmt,
@@ -1148,6 +1536,34 @@ static void TexDecoder_DecodeImpl_RGBA8(u32* dst, const u8* src, int width, int
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_RGBA8_AVX2(u32* dst, const u8* src, int width, int height,
+                                             int texformat, const u8* tlut, TlutFormat tlutfmt,
+                                             int Wsteps4, int Wsteps8)
+{
+  // (A G R B) -> (R G B A)
+  const __m256i mask = _mm256_setr_epi8(2, 1, 3, 0, 6, 5, 7, 4, 10, 9, 11, 8, 14, 13, 15, 12, 2, 1,
+                                        3, 0, 6, 5, 7, 4, 10, 9, 11, 8, 14, 13, 15, 12);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      // The 16 (A R) pairs of a 4x4 block come first, followed by its 16 (G B) pairs.
+      const u8* block = src + 64 * yStep;
+      const __m256i ar = _mm256_loadu_si256((const __m256i*)block);
+      const __m256i gb = _mm256_loadu_si256((const __m256i*)(block + 32));
+
+      // Interleaving them gives rows 0 and 2 in rows02, and rows 1 and 3 in rows13.
+      const __m256i rows02 = _mm256_shuffle_epi8(_mm256_unpacklo_epi8(ar, gb), mask);
+      const __m256i rows13 = _mm256_shuffle_epi8(_mm256_unpackhi_epi8(ar, gb), mask);
+
+      u32* row = dst + y * width + x;
+      StoreTwoRows_AVX2(row, row + 2 * width, rows02);
+      StoreTwoRows_AVX2(row + width, row + 3 * width, rows13);
+    }
+  }
+}
+
 static void TexDecoder_DecodeImpl_CMPR(u32* dst, const u8* src, int width, int height,
                                        int texformat, const u8* tlut, TlutFormat tlutfmt,
                                        int Wsteps4, int Wsteps8)
@@ -1404,6 +1820,112 @@ static void TexDecoder_DecodeImpl_CMPR(u32* dst, const u8* src, int width, int h
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_CMPR_AVX2(u32* dst, const u8* src, int width, int height,
+                                            int texformat, const u8* tlut, TlutFormat tlutfmt,
+                                            int Wsteps4, int Wsteps8)
+{
+  const __m128i swap16 = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+  const __m128i kMask_xffff = _mm_set1_epi32(0xffff);
+  const __m128i kMask_x00ffffff = _mm_set1_epi32(0x00ffffff);
+  // Moves the colors of the 4 DXT blocks to the lower 128 bits and their indices to the upper.
+  const __m256i split = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+  // Broadcasts the indices of the left block of a row of blocks to texels 0-3, and the indices of
+  // the right block to texels 4-7.
+  const __m256i top_indices = _mm256_setr_epi32(4, 4, 4, 4, 5, 5, 5, 5);
+  const __m256i bottom_indices = _mm256_setr_epi32(6, 6, 6, 6, 7, 7, 7, 7);
+  // Bring the 2-bit index of each texel of a row down, and select the palette of the right block
+  // for texels 4-7.
+  const __m256i shifts = _mm256_setr_epi32(6, 4, 2, 0, 6, 4, 2, 0);
+  const __m256i right_block = _mm256_setr_epi32(0, 0, 0, 0, 4, 4, 4, 4);
+  const __m256i kMask_x03 = _mm256_set1_epi32(0x03);
+
+  for (int y = 0; y < height; y += 8)
+  {
+    for (int x = 0, yStep = (y / 8) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      // An 8x8 block is made of 4 DXT blocks: top left, top right, bottom left, bottom right.
+      const __m256i dxt = _mm256_permutevar8x32_epi32(
+          _mm256_loadu_si256((const __m256i*)(src + 32 * yStep)), split);
+
+      // Decode both colors of the 4 DXT blocks at once.
+      const __m128i colors = _mm_shuffle_epi8(_mm256_castsi256_si128(dxt), swap16);
+      const __m128i c1 = _mm_and_si128(colors, kMask_xffff);
+      const __m128i c2 = _mm_srli_epi32(colors, 16);
+      const __m256i rgb =
+          DecodePixels_RGB565_AVX2(_mm256_inserti128_si256(_mm256_castsi128_si256(c1), c2, 1));
+      const __m128i color0 = _mm256_castsi256_si128(rgb);
+      const __m128i color1 = _mm256_extracti128_si256(rgb, 1);
+
+      // Calculate the blended colors with 16-bit channels.
+      // RGB2 = (RGB0 * 5 + RGB1 * 3) / 8 = (RGB0 << 2 + RGB1 << 1 + (RGB0 + RGB1)) >> 3
+      // RGB3 = (RGB0 * 3 + RGB1 * 5) / 8 = (RGB0 << 1 + RGB1 << 2 + (RGB0 + RGB1)) >> 3
+      // The alpha stays at 0xFF.
+      const __m256i rrggbbaa0 = _mm256_cvtepu8_epi16(color0);
+      const __m256i rrggbbaa1 = _mm256_cvtepu8_epi16(color1);
+      const __m256i sum = _mm256_add_epi16(rrggbbaa0, rrggbbaa1);
+      const __m256i blend2 = _mm256_srli_epi16(
+          _mm256_add_epi16(_mm256_add_epi16(_mm256_slli_epi16(rrggbbaa0, 2),
+                                            _mm256_slli_epi16(rrggbbaa1, 1)),
+                           sum),
+          3);
+      const __m256i blend3 = _mm256_srli_epi16(
+          _mm256_add_epi16(_mm256_add_epi16(_mm256_slli_epi16(rrggbbaa0, 1),
+                                            _mm256_slli_epi16(rrggbbaa1, 2)),
+                           sum),
+          3);
+      const __m256i average = _mm256_srli_epi16(sum, 1);
+
+      // Pack them back to 8-bit channels. packus works within 128-bit lanes, so the qwords holding
+      // the colors of blocks 0, 1 and 2, 3 are moved next to each other.
+      const __m256i packed2 = _mm256_packus_epi16(blend2, average);
+      const __m256i packed3 = _mm256_packus_epi16(blend3, blend3);
+      const __m128i blended2 = _mm256_castsi256_si128(
+          _mm256_permute4x64_epi64(packed2, _MM_SHUFFLE(3, 1, 2, 0)));
+      const __m128i averaged = _mm256_extracti128_si256(
+          _mm256_permute4x64_epi64(packed2, _MM_SHUFFLE(3, 1, 2, 0)), 1);
+      const __m128i blended3 = _mm256_castsi256_si128(
+          _mm256_permute4x64_epi64(packed3, _MM_SHUFFLE(3, 1, 2, 0)));
+
+      // if (rgb0 > rgb1): the blended colors, else the average, and a transparent average.
+      const __m128i use_blend = _mm_cmpgt_epi32(c1, c2);
+      const __m128i color2 = _mm_blendv_epi8(averaged, blended2, use_blend);
+      const __m128i color3 =
+          _mm_blendv_epi8(_mm_and_si128(averaged, kMask_x00ffffff), blended3, use_blend);
+
+      // Transpose the colors to the 4-entry palettes of each block, with the palettes of the left
+      // and right blocks of a row of blocks next to each other.
+      const __m128i c01_top = _mm_unpacklo_epi32(color0, color1);
+      const __m128i c23_top = _mm_unpacklo_epi32(color2, color3);
+      const __m128i c01_bottom = _mm_unpackhi_epi32(color0, color1);
+      const __m128i c23_bottom = _mm_unpackhi_epi32(color2, color3);
+      const __m256i palettes_top =
+          _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi64(c01_top, c23_top)),
+                                  _mm_unpackhi_epi64(c01_top, c23_top), 1);
+      const __m256i palettes_bottom = _mm256_inserti128_si256(
+          _mm256_castsi128_si256(_mm_unpacklo_epi64(c01_bottom, c23_bottom)),
+          _mm_unpackhi_epi64(c01_bottom, c23_bottom), 1);
+
+      // Each row has one byte of indices per block, the first texel in the top bits.
+      const __m256i lines_top = _mm256_permutevar8x32_epi32(dxt, top_indices);
+      const __m256i lines_bottom = _mm256_permutevar8x32_epi32(dxt, bottom_indices);
+      for (int iy = 0; iy < 4; iy++)
+      {
+        const __m256i row_shifts = _mm256_add_epi32(shifts, _mm256_set1_epi32(8 * iy));
+        const __m256i indices_top = _mm256_add_epi32(
+            _mm256_and_si256(_mm256_srlv_epi32(lines_top, row_shifts), kMask_x03), right_block);
+        const __m256i indices_bottom = _mm256_add_epi32(
+            _mm256_and_si256(_mm256_srlv_epi32(lines_bottom, row_shifts), kMask_x03), right_block);
+
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy) * width + x),
+                            _mm256_permutevar8x32_epi32(palettes_top, indices_top));
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy + 4) * width + x),
+                            _mm256_permutevar8x32_epi32(palettes_bottom, indices_bottom));
+      }
+    }
+  }
+}
+
 void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, int texformat,
                             const u8* tlut, TlutFormat tlutfmt)
 {
@@ -1413,11 +1935,18 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, int
   switch (texformat)
   {
   case GX_TF_C4:
-    TexDecoder_DecodeImpl_C4(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_C4_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                    Wsteps8);
+    else
+      TexDecoder_DecodeImpl_C4(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
     break;
 
   case GX_TF_I4:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_I4_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                    Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_I4_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                      Wsteps8);
     else
@@ -1425,7 +1954,10 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, int
     break;
 
   case GX_TF_I8:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_I8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                    Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_I8_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                      Wsteps8);
     else
@@ -1433,15 +1965,27 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, int
     break;
 
   case GX_TF_C8:
-    TexDecoder_DecodeImpl_C8(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_C8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                    Wsteps8);
+    else
+      TexDecoder_DecodeImpl_C8(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
     break;
 
   case GX_TF_IA4:
-    TexDecoder_DecodeImpl_IA4(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_IA4_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                     Wsteps8);
+    else
+      TexDecoder_DecodeImpl_IA4(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                Wsteps8);
     break;
 
   case GX_TF_IA8:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_IA8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                     Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_IA8_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                       Wsteps8);
     else
@@ -1450,17 +1994,28 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, int
     break;
 
   case GX_TF_C14X2:
-    TexDecoder_DecodeImpl_C14X2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
-                                Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_C14X2_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                       Wsteps8);
+    else
+      TexDecoder_DecodeImpl_C14X2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                  Wsteps8);
     break;
 
   case GX_TF_RGB565:
-    TexDecoder_DecodeImpl_RGB565(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
-                                 Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_RGB565_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                        Wsteps8);
+    else
+      TexDecoder_DecodeImpl_RGB565(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                   Wsteps8);
     break;
 
   case GX_TF_RGB5A3:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_RGB5A3_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                        Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_RGB5A3_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                          Wsteps8);
     else
@@ -1469,7 +2024,10 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, int
     break;
 
   case GX_TF_RGBA8:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_RGBA8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                       Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_RGBA8_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                         Wsteps8);
     else
@@ -1478,7 +2036,12 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, int
     break;
 
   case GX_TF_CMPR:
-    TexDecoder_DecodeImpl_CMPR(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_CMPR_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                      Wsteps8);
+    else
+      TexDecoder_DecodeImpl_CMPR(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                 Wsteps8);
     break;
   
   case GX_CTF_XFB:
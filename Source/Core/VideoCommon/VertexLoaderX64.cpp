@@ -52,7 +52,7 @@ VertexLoaderX64::VertexLoaderX64(const TVtxDesc& vtx_desc, const VAT& vtx_att)
   WriteProtect();
 
   const std::string name = ToString();
-  JitRegister::Register(region, GetCodePtr(), name.c_str());
+  JitRegister::Register(region, GetCodePtr(), "%s", name.c_str());
 }
 
 OpArg VertexLoaderX64::GetVertexAddr(int array, u64 attribute)
@@ -13,6 +13,7 @@
 #include "Common/Logging/Log.h"
 #include "Core/ConfigManager.h"
 
+#include "VideoCommon/AsyncRequests.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/Debugger.h"
@@ -192,6 +193,8 @@ void VertexManagerBase::Flush()
   // loading a state will invalidate BP, so check for it
   g_video_backend->CheckInvalidState();
 
+  AsyncRequests::GetInstance()->InvalidateEFBPeekCache();
+
 #if defined(_DEBUG) || defined(DEBUGFAST)
   PRIM_LOG("frame%d:\n texgen=%u, numchan=%u, dualtex=%u, ztex=%u, cole=%u, alpe=%u, ze=%u",
            g_ActiveConfig.iSaveTargetId, xfmem.numTexGen.numTexGens, xfmem.numChan.numColorChans,
@@ -98,6 +98,7 @@ void VideoConfig::Refresh()
   bPrecompileUberShaders = Config::Get(Config::GFX_PRECOMPILE_UBER_SHADERS);
   iShaderCompilerThreads = Config::Get(Config::GFX_SHADER_COMPILER_THREADS);
   iShaderPrecompilerThreads = Config::Get(Config::GFX_SHADER_PRECOMPILER_THREADS);
+  iTextureDecoderThreads = Config::Get(Config::GFX_TEXTURE_DECODER_THREADS);
   bForceVertexUberShaders = Config::Get(Config::GFX_FORCE_VERTEX_UBER_SHADERS);
   bForcePixelUberShaders = Config::Get(Config::GFX_FORCE_PIXEL_UBER_SHADERS);
 
@@ -129,6 +130,7 @@ void VideoConfig::Refresh()
   bForceProgressive = Config::Get(Config::GFX_HACK_FORCE_PROGRESSIVE);
   bSkipEFBCopyToRam = Config::Get(Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM);
   bSkipXFBCopyToRam = Config::Get(Config::GFX_HACK_SKIP_XFB_COPY_TO_RAM);
+  bDeferEFBCopies = Config::Get(Config::GFX_HACK_DEFER_EFB_COPIES);
   bCopyEFBScaled = Config::Get(Config::GFX_HACK_COPY_EFB_ENABLED);
   bEFBEmulateFormatChanges = Config::Get(Config::GFX_HACK_EFB_EMULATE_FORMAT_CHANGES);
   bVertexRounding = Config::Get(Config::GFX_HACK_VERTEX_ROUDING);
@@ -212,6 +214,15 @@ u32 VideoConfig::GetShaderPrecompilerThreads() const
     return GetNumAutoShaderCompilerThreads();
 }
 
+u32 VideoConfig::GetTextureDecoderThreads() const
+{
+  if (iTextureDecoderThreads >= 0)
+    return static_cast<u32>(iTextureDecoderThreads);
+
+  // Automatic number. We use clamp(cpus - 2, 0, 3), leaving room for the CPU and GPU threads.
+  return static_cast<u32>(std::min(std::max(cpu_info.num_cores - 2, 0), 3));
+}
+
 bool VideoConfig::CanPrecompileUberShaders() const
 {
   // We don't want to precompile ubershaders if they're never going to be used.
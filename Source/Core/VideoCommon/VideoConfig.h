@@ -127,6 +127,8 @@ struct VideoConfig final
   bool bEFBEmulateFormatChanges;
   bool bSkipEFBCopyToRam;
   bool bSkipXFBCopyToRam;
+  // Queue EFB copies to RAM and only read them back when the data may be looked at.
+  bool bDeferEFBCopies;
   bool bCopyEFBScaled;
   int iSafeTextureCache_ColorSamples;
   ProjectionHackConfig phack;
@@ -194,6 +196,10 @@ struct VideoConfig final
   int iShaderCompilerThreads;
   int iShaderPrecompilerThreads;
 
+  // Number of threads helping the GPU thread to decode textures on the CPU.
+  // -1 uses an automatic number based on the CPU threads.
+  int iTextureDecoderThreads;
+
   // Temporary toggling of ubershaders, for debugging
   bool bForceVertexUberShaders;
   bool bForcePixelUberShaders;
@@ -257,6 +263,7 @@ struct VideoConfig final
   bool UseVertexRounding() const { return bVertexRounding && iEFBScale != SCALE_1X; }
   u32 GetShaderCompilerThreads() const;
   u32 GetShaderPrecompilerThreads() const;
+  u32 GetTextureDecoderThreads() const;
   bool CanPrecompileUberShaders() const;
   bool CanBackgroundCompileShaders() const;
 };
@@ -0,0 +1,109 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Common/Config/Config.h"
+
+class ConfigTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    Config::Init();
+    Config::AddLayer(std::make_unique<Config::Layer>(Config::LayerType::Base));
+  }
+
+  void TearDown() override { Config::Shutdown(); }
+};
+
+TEST_F(ConfigTest, CachedGetSeesChanges)
+{
+  const Config::ConfigInfo<int> info{{Config::System::Main, "Test", "Int"}, 5};
+
+  EXPECT_EQ(5, Config::Get(info));
+  EXPECT_EQ(5, Config::Get(info));
+
+  Config::SetBase(info, 7);
+  EXPECT_EQ(7, Config::Get(info));
+
+  Config::SetCurrent(info, 9);
+  EXPECT_EQ(9, Config::Get(info));
+
+  Config::ClearCurrentRunLayer();
+  EXPECT_EQ(7, Config::Get(info));
+
+  Config::GetLayer(Config::LayerType::Base)->DeleteKey(Config::System::Main, "Test", "Int");
+  EXPECT_EQ(5, Config::Get(info));
+}
+
+TEST_F(ConfigTest, CachedGetSeesLayerChanges)
+{
+  const Config::ConfigInfo<bool> info{{Config::System::Main, "Test", "Bool"}, false};
+  EXPECT_FALSE(Config::Get(info));
+
+  auto layer = std::make_unique<Config::Layer>(Config::LayerType::CommandLine);
+  layer->GetOrCreateSection(Config::System::Main, "Test")->Set("Bool", true);
+  Config::AddLayer(std::move(layer));
+  EXPECT_TRUE(Config::Get(info));
+
+  Config::RemoveLayer(Config::LayerType::CommandLine);
+  EXPECT_FALSE(Config::Get(info));
+}
+
+TEST_F(ConfigTest, CachedGetLargeValues)
+{
+  const Config::ConfigInfo<std::string> string_info{{Config::System::Main, "Test", "String"},
+                                                    "default"};
+  const Config::ConfigInfo<double> double_info{{Config::System::Main, "Test", "Double"}, 1.5};
+
+  EXPECT_EQ("default", Config::Get(string_info));
+  EXPECT_EQ(1.5, Config::Get(double_info));
+
+  Config::SetBase(string_info, std::string("changed"));
+  Config::SetBase(double_info, 2.5);
+  EXPECT_EQ("changed", Config::Get(string_info));
+  EXPECT_EQ(2.5, Config::Get(double_info));
+}
+
+TEST_F(ConfigTest, CopiesDoNotShareCache)
+{
+  const Config::ConfigInfo<int> info{{Config::System::Main, "Test", "Int"}, 5};
+  EXPECT_EQ(5, Config::Get(info));
+
+  Config::ConfigInfo<int> copy = info;
+  copy.default_value = 6;
+  EXPECT_EQ(6, Config::Get(copy));
+  EXPECT_EQ(5, Config::Get(info));
+}
+
+// Not a correctness test: reports how much the cache saves over walking the layers, so that the
+// numbers can be compared between builds.
+TEST_F(ConfigTest, GetBenchmark)
+{
+  const Config::ConfigInfo<int> info{{Config::System::GFX, "Settings", "Benchmark"}, 0};
+  Config::SetBase(info, 1);
+
+  static constexpr int ITERATIONS = 100000;
+  const auto measure = [](auto&& get) {
+    int sum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i)
+      sum += get();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(ITERATIONS, sum);
+    return std::chrono::duration<double, std::nano>(elapsed).count() / ITERATIONS;
+  };
+
+  const double uncached_ns = measure([&info] { return Config::GetUncached(info); });
+  const double cached_ns = measure([&info] { return Config::Get(info); });
+
+  std::printf("Config::GetUncached: %.1f ns/call\n", uncached_ns);
+  std::printf("Config::Get:         %.1f ns/call\n", cached_ns);
+}
@@ -0,0 +1,150 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <cinttypes>
+#include <cstdarg>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "Common/Logging/LogBuffer.h"
+#include "Common/StringUtil.h"
+
+static bool Push(LogBuffer* buffer, bool deferred, const char* format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  const bool pushed =
+      deferred ?
+          buffer->Push(LogTypes::LINFO, LogTypes::COMMON, "file.cpp", 42, 1234, format, args) :
+          buffer->PushFormatted(LogTypes::LINFO, LogTypes::COMMON, "file.cpp", 42, 1234, format,
+                                args);
+  va_end(args);
+  return pushed;
+}
+
+static std::string PopMessage(LogBuffer* buffer)
+{
+  LogBuffer::Entry entry;
+  if (!buffer->Pop(&entry))
+    return "<empty>";
+  return entry.message;
+}
+
+#define EXPECT_FORMAT(...)                                                                         \
+  do                                                                                               \
+  {                                                                                                \
+    LogBuffer buffer(4096);                                                                        \
+    ASSERT_TRUE(Push(&buffer, true, __VA_ARGS__));                                                 \
+    EXPECT_EQ(StringFromFormat(__VA_ARGS__), PopMessage(&buffer));                                 \
+  } while (0)
+
+TEST(LogBuffer, DeferredFormatting)
+{
+  EXPECT_FORMAT("no arguments");
+  EXPECT_FORMAT("100%% literal");
+  EXPECT_FORMAT("%d %i %u %x %X %o %c", -1, 2, 3u, 0xabcu, 0xABCu, 8u, 'z');
+  EXPECT_FORMAT("%hhx %hd %ld %lu %lld %llu", 0x1ff, -5, -6L, 7UL, -8LL, 9ULL);
+  EXPECT_FORMAT("%08x|%-6d|%+d|% d|%#x", 0x1234u, 5, 6, 7, 8u);
+  EXPECT_FORMAT("%zu %jd %td", static_cast<size_t>(10), static_cast<intmax_t>(-11),
+                static_cast<ptrdiff_t>(12));
+  EXPECT_FORMAT("%016" PRIx64 " %" PRIu64 " %" PRId64, UINT64_C(0xdeadbeefcafe),
+                UINT64_C(18446744073709551615), INT64_C(-9223372036854775807));
+  EXPECT_FORMAT("%f %.3f %e %g %G %a", 1.5, 2.25, 1e10, 0.0001, 1e-20, 3.0);
+  EXPECT_FORMAT("%Lf", static_cast<long double>(2.5));
+  EXPECT_FORMAT("%s and %.2s and %8s and %-8s|", "string", "truncated", "right", "left");
+  EXPECT_FORMAT("%*d|%-*d|%.*f|%*.*f", 6, 1, 6, 2, 3, 3.14159, 10, 2, 2.71828);
+  EXPECT_FORMAT("%p", reinterpret_cast<void*>(static_cast<uintptr_t>(0x1000)));
+}
+
+TEST(LogBuffer, StringsAreCopied)
+{
+  LogBuffer buffer(4096);
+  char str[] = "before";
+  ASSERT_TRUE(Push(&buffer, true, "[%s]", str));
+  str[0] = 'X';
+  EXPECT_EQ("[before]", PopMessage(&buffer));
+
+  ASSERT_TRUE(Push(&buffer, true, "[%s]", static_cast<const char*>(nullptr)));
+  EXPECT_EQ("[(null)]", PopMessage(&buffer));
+}
+
+TEST(LogBuffer, UnsupportedConversionsAreFormattedEagerly)
+{
+  LogBuffer buffer(4096);
+  ASSERT_TRUE(Push(&buffer, true, "%ls %d", L"wide", 5));
+  EXPECT_EQ("wide 5", PopMessage(&buffer));
+}
+
+TEST(LogBuffer, PushFormatted)
+{
+  LogBuffer buffer(4096);
+  std::string format = "%d-%s";
+  ASSERT_TRUE(Push(&buffer, false, format.c_str(), 1, "two"));
+  format = "changed";
+
+  LogBuffer::Entry entry;
+  ASSERT_TRUE(buffer.Pop(&entry));
+  EXPECT_EQ("1-two", entry.message);
+  EXPECT_EQ(LogTypes::LINFO, entry.level);
+  EXPECT_EQ(LogTypes::COMMON, entry.type);
+  EXPECT_STREQ("file.cpp", entry.file);
+  EXPECT_EQ(42, entry.line);
+  EXPECT_EQ(1234u, entry.timestamp);
+  EXPECT_FALSE(buffer.Pop(&entry));
+}
+
+TEST(LogBuffer, DropsWhenFull)
+{
+  LogBuffer buffer(4096);
+  u32 pushed = 0;
+  while (Push(&buffer, true, "message %u with some padding to fill the ring", pushed))
+    ++pushed;
+  EXPECT_GT(pushed, 0u);
+  EXPECT_TRUE(buffer.IsMoreThanHalfFull());
+
+  EXPECT_FALSE(Push(&buffer, true, "dropped"));
+  EXPECT_EQ(2u, buffer.TakeDroppedCount());
+  EXPECT_EQ(0u, buffer.TakeDroppedCount());
+
+  for (u32 i = 0; i < pushed; ++i)
+    EXPECT_EQ(StringFromFormat("message %u with some padding to fill the ring", i),
+              PopMessage(&buffer));
+  EXPECT_TRUE(buffer.IsEmpty());
+}
+
+TEST(LogBuffer, WrapsAround)
+{
+  LogBuffer buffer(2048);
+  for (u32 i = 0; i < 1000; ++i)
+  {
+    ASSERT_TRUE(Push(&buffer, true, "%u %s", i, std::string(i % 200, 'x').c_str()));
+    EXPECT_EQ(StringFromFormat("%u %s", i, std::string(i % 200, 'x').c_str()),
+              PopMessage(&buffer));
+  }
+}
+
+TEST(LogBuffer, ConcurrentProducerAndConsumer)
+{
+  constexpr u32 MESSAGES = 100000;
+  LogBuffer buffer(16384);
+
+  std::thread producer([&buffer] {
+    for (u32 i = 0; i < MESSAGES; ++i)
+    {
+      while (!Push(&buffer, true, "%u", i))
+        std::this_thread::yield();
+    }
+  });
+
+  for (u32 i = 0; i < MESSAGES; ++i)
+  {
+    LogBuffer::Entry entry;
+    while (!buffer.Pop(&entry))
+      std::this_thread::yield();
+    ASSERT_EQ(std::to_string(i), entry.message);
+  }
+  producer.join();
+}
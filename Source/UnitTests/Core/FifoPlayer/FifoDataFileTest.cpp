@@ -0,0 +1,104 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Core/FifoPlayer/FifoDataFile.h"
+
+static FifoFrameInfo MakeFrame(u32 seed)
+{
+  FifoFrameInfo frame;
+  frame.fifoStart = 0x100 * seed;
+  frame.fifoEnd = frame.fifoStart + 0x40;
+  for (u32 i = 0; i < 0x40 + seed; i++)
+    frame.fifoData.push_back(static_cast<u8>(i * 7 + seed));
+
+  MemoryUpdate update;
+  update.fifoPosition = 0x10;
+  update.address = 0x80000000 + 0x1000 * seed;
+  update.type = MemoryUpdate::TEXTURE_MAP;
+  update.data.assign(0x20 * (seed + 1), static_cast<u8>(seed));
+  frame.memoryUpdates.push_back(update);
+
+  update.fifoPosition = 0x30;
+  update.type = MemoryUpdate::TMEM;
+  update.data.assign(3, static_cast<u8>(0xA0 + seed));
+  frame.memoryUpdates.push_back(update);
+
+  return frame;
+}
+
+static void ExpectSameFrame(const FifoFrameInfo& expected, const FifoFrameInfo& actual)
+{
+  EXPECT_EQ(expected.fifoStart, actual.fifoStart);
+  EXPECT_EQ(expected.fifoEnd, actual.fifoEnd);
+  EXPECT_EQ(expected.fifoData, actual.fifoData);
+  ASSERT_EQ(expected.memoryUpdates.size(), actual.memoryUpdates.size());
+  for (size_t i = 0; i < expected.memoryUpdates.size(); i++)
+  {
+    EXPECT_EQ(expected.memoryUpdates[i].fifoPosition, actual.memoryUpdates[i].fifoPosition);
+    EXPECT_EQ(expected.memoryUpdates[i].address, actual.memoryUpdates[i].address);
+    EXPECT_EQ(expected.memoryUpdates[i].type, actual.memoryUpdates[i].type);
+    EXPECT_EQ(expected.memoryUpdates[i].data, actual.memoryUpdates[i].data);
+  }
+}
+
+TEST(FifoDataFile, SaveLoadRoundTrip)
+{
+  const std::string dir = File::CreateTempDir();
+  ASSERT_FALSE(dir.empty());
+  const std::string filename = dir + DIR_SEP "test.dff";
+  // Recordings are spooled to the cache directory.
+  File::SetUserPath(D_USER_IDX, dir + DIR_SEP);
+
+  std::vector<FifoFrameInfo> frames;
+  for (u32 i = 0; i < 3; i++)
+    frames.push_back(MakeFrame(i));
+
+  {
+    FifoDataFile file;
+    file.SetIsWii(true);
+    for (u32 i = 0; i < FifoDataFile::BP_MEM_SIZE; i++)
+      file.GetBPMem()[i] = i * 3;
+    file.GetTexMem()[FifoDataFile::TEX_MEM_SIZE - 1] = 0x5A;
+    for (const FifoFrameInfo& frame : frames)
+      ASSERT_TRUE(file.AddFrame(frame));
+
+    // Frames are readable while recording, before the file has been saved.
+    ExpectSameFrame(frames[1], *file.GetFrame(1));
+    ASSERT_TRUE(file.Save(filename));
+  }
+
+  std::unique_ptr<FifoDataFile> loaded = FifoDataFile::Load(filename, false);
+  ASSERT_NE(nullptr, loaded);
+  EXPECT_TRUE(loaded->GetIsWii());
+  for (u32 i = 0; i < FifoDataFile::BP_MEM_SIZE; i++)
+    EXPECT_EQ(i * 3, loaded->GetBPMem()[i]);
+  EXPECT_EQ(0x5A, loaded->GetTexMem()[FifoDataFile::TEX_MEM_SIZE - 1]);
+
+  ASSERT_EQ(frames.size(), loaded->GetFrameCount());
+  // Read out of order, so that frames don't simply come from the cache of the last one read.
+  for (u32 i : {2u, 0u, 1u})
+    ExpectSameFrame(frames[i], *loaded->GetFrame(i));
+
+  // Saving a loaded file copies its compressed frames over.
+  const std::string copy_filename = dir + DIR_SEP "copy.dff";
+  ASSERT_TRUE(loaded->Save(copy_filename));
+  std::unique_ptr<FifoDataFile> copy = FifoDataFile::Load(copy_filename, false);
+  ASSERT_NE(nullptr, copy);
+  ASSERT_EQ(frames.size(), copy->GetFrameCount());
+  for (u32 i = 0; i < frames.size(); i++)
+    ExpectSameFrame(frames[i], *copy->GetFrame(i));
+
+  loaded.reset();
+  copy.reset();
+  File::DeleteDirRecursively(dir);
+}
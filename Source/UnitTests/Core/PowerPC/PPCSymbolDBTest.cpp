@@ -0,0 +1,99 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/SymbolDB.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+
+static void AddSymbol(PPCSymbolDB* db, const std::string& name, u32 address, int size)
+{
+  Symbol symbol;
+  symbol.name = name;
+  symbol.address = address;
+  symbol.size = size;
+  db->AddCompleteSymbol(symbol);
+}
+
+static std::string GetName(PPCSymbolDB* db, u32 address)
+{
+  const Symbol* symbol = db->GetSymbolFromAddr(address);
+  return symbol ? symbol->name : "";
+}
+
+TEST(PPCSymbolDB, GetSymbolFromAddr)
+{
+  PPCSymbolDB db;
+  AddSymbol(&db, "a", 0x80001000, 0x100);
+  AddSymbol(&db, "b", 0x80001100, 0x20);
+  AddSymbol(&db, "empty", 0x80002000, 0);
+
+  EXPECT_EQ("", GetName(&db, 0x80000ffc));
+  EXPECT_EQ("a", GetName(&db, 0x80001000));
+  EXPECT_EQ("a", GetName(&db, 0x800010fc));
+  EXPECT_EQ("b", GetName(&db, 0x80001100));
+  EXPECT_EQ("b", GetName(&db, 0x8000111c));
+  EXPECT_EQ("", GetName(&db, 0x80001120));
+  EXPECT_EQ("empty", GetName(&db, 0x80002000));
+  EXPECT_EQ("", GetName(&db, 0x80002004));
+}
+
+TEST(PPCSymbolDB, OverlappingSymbols)
+{
+  PPCSymbolDB db;
+  AddSymbol(&db, "outer", 0x80001000, 0x100);
+  AddSymbol(&db, "inner", 0x80001040, 0x10);
+  AddSymbol(&db, "overhanging", 0x800010f0, 0x20);
+
+  // Addresses belong to the first symbol that contains them, unless a symbol starts there.
+  EXPECT_EQ("outer", GetName(&db, 0x8000103c));
+  EXPECT_EQ("inner", GetName(&db, 0x80001040));
+  EXPECT_EQ("outer", GetName(&db, 0x80001044));
+  EXPECT_EQ("overhanging", GetName(&db, 0x800010f0));
+  EXPECT_EQ("outer", GetName(&db, 0x800010fc));
+  EXPECT_EQ("overhanging", GetName(&db, 0x80001100));
+  EXPECT_EQ("overhanging", GetName(&db, 0x8000110c));
+  EXPECT_EQ("", GetName(&db, 0x80001110));
+}
+
+TEST(PPCSymbolDB, IndexFollowsChanges)
+{
+  PPCSymbolDB db;
+  AddSymbol(&db, "a", 0x80001000, 0x100);
+  EXPECT_EQ("", GetName(&db, 0x80002000));
+
+  AddSymbol(&db, "b", 0x80002000, 0x100);
+  EXPECT_EQ("b", GetName(&db, 0x80002000));
+
+  db.AccessSymbols().at(0x80002000).size = 4;
+  EXPECT_EQ("", GetName(&db, 0x80002004));
+
+  // Symbols resized through a looked up pointer, like the debugger does.
+  db.GetSymbolFromAddr(0x80002000)->size = 0x10;
+  db.InvalidateIndex();
+  EXPECT_EQ("b", GetName(&db, 0x8000200c));
+
+  db.Clear();
+  EXPECT_EQ("", GetName(&db, 0x80001000));
+}
+
+TEST(PPCSymbolDB, GetSymbolsFromAddrs)
+{
+  PPCSymbolDB db;
+  for (u32 i = 0; i < 100; ++i)
+    AddSymbol(&db, std::to_string(i), 0x80000000 + i * 0x100, 0x80);
+
+  std::vector<u32> addresses;
+  for (u32 i = 0; i < 1000; ++i)
+    addresses.push_back(0x80000000 + (i * 0x1234) % 0x7000);
+
+  const std::vector<Symbol*> symbols = db.GetSymbolsFromAddrs(addresses);
+  ASSERT_EQ(addresses.size(), symbols.size());
+  for (size_t i = 0; i < addresses.size(); ++i)
+    EXPECT_EQ(db.GetSymbolFromAddr(addresses[i]), symbols[i]) << std::hex << addresses[i];
+}
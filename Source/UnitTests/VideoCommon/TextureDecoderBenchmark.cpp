@@ -0,0 +1,154 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Measures the throughput of the CPU texture decoders for every texture format and TLUT format,
+// for each instruction set the CPU supports, and with a varying number of decoder threads. This
+// isn't a test: run it manually to compare decoder changes.
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureDecoder.h"
+
+namespace
+{
+struct FormatInfo
+{
+  TextureFormat format;
+  TlutFormat tlut_format;
+  const char* name;
+};
+
+constexpr std::array<FormatInfo, 17> FORMATS = {{
+    {GX_TF_I4, GX_TL_IA8, "I4"},
+    {GX_TF_I8, GX_TL_IA8, "I8"},
+    {GX_TF_IA4, GX_TL_IA8, "IA4"},
+    {GX_TF_IA8, GX_TL_IA8, "IA8"},
+    {GX_TF_RGB565, GX_TL_IA8, "RGB565"},
+    {GX_TF_RGB5A3, GX_TL_IA8, "RGB5A3"},
+    {GX_TF_RGBA8, GX_TL_IA8, "RGBA8"},
+    {GX_TF_C4, GX_TL_IA8, "C4/IA8"},
+    {GX_TF_C4, GX_TL_RGB565, "C4/565"},
+    {GX_TF_C4, GX_TL_RGB5A3, "C4/5A3"},
+    {GX_TF_C8, GX_TL_IA8, "C8/IA8"},
+    {GX_TF_C8, GX_TL_RGB565, "C8/565"},
+    {GX_TF_C8, GX_TL_RGB5A3, "C8/5A3"},
+    {GX_TF_C14X2, GX_TL_IA8, "C14/IA8"},
+    {GX_TF_C14X2, GX_TL_RGB565, "C14/565"},
+    {GX_TF_C14X2, GX_TL_RGB5A3, "C14/5A3"},
+    {GX_TF_CMPR, GX_TL_IA8, "CMPR"},
+}};
+
+constexpr std::array<u32, 4> THREAD_COUNTS = {{0, 1, 2, 4}};
+
+constexpr int WIDTH = 1024;
+constexpr int HEIGHT = 1024;
+constexpr int ITERATIONS = 50;
+// Large enough for the 16384 entries of a C14X2 palette.
+constexpr size_t TLUT_SIZE = 16384 * 2;
+
+double MeasureMTexelsPerSecond(const std::function<void()>& decode)
+{
+  // Warm up the caches and the decoder threads.
+  decode();
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ITERATIONS; ++i)
+    decode();
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  return static_cast<double>(WIDTH) * HEIGHT * ITERATIONS / elapsed.count() / 1e6;
+}
+}  // Anonymous namespace
+
+int main()
+{
+  std::mt19937 rng(0x5EED);
+  std::uniform_int_distribution<int> byte_dist(0, 255);
+
+  std::vector<u8> tlut(TLUT_SIZE);
+  for (u8& value : tlut)
+    value = static_cast<u8>(byte_dist(rng));
+
+  std::vector<u8> src(TexDecoder_GetTextureSizeInBytes(WIDTH, HEIGHT, GX_TF_RGBA8));
+  for (u8& value : src)
+    value = static_cast<u8>(byte_dist(rng));
+
+  std::vector<u8> reference(WIDTH * HEIGHT * sizeof(u32));
+  std::vector<u8> dst(WIDTH * HEIGHT * sizeof(u32));
+  u32* const dst32 = reinterpret_cast<u32*>(dst.data());
+
+  const CPUInfo detected_cpu_info = cpu_info;
+  int result = 0;
+
+  // Single-threaded throughput of each implementation. The instruction sets are disabled one at a
+  // time, so that the dispatcher falls back to the next implementation.
+  std::printf("%-8s  %10s  %10s  %10s  %10s   (MTexels/s, %dx%d, 1 thread)\n", "Format", "Generic",
+              "Baseline", "SSSE3", "AVX2", WIDTH, HEIGHT);
+  for (const FormatInfo& info : FORMATS)
+  {
+    std::printf("%-8s  %10.1f", info.name, MeasureMTexelsPerSecond([&] {
+                  _TexDecoder_DecodeImpl_Generic(dst32, src.data(), WIDTH, HEIGHT, info.format,
+                                                 tlut.data(), info.tlut_format);
+                }));
+
+    for (int level = 0; level < 3; ++level)
+    {
+      cpu_info.bSSSE3 = detected_cpu_info.bSSSE3 && level >= 1;
+      cpu_info.bAVX2 = detected_cpu_info.bAVX2 && level >= 2;
+      if ((level == 1 && !detected_cpu_info.bSSSE3) || (level == 2 && !detected_cpu_info.bAVX2))
+      {
+        std::printf("  %10s", "-");
+        continue;
+      }
+
+      std::printf("  %10.1f", MeasureMTexelsPerSecond([&] {
+                    _TexDecoder_DecodeImpl(dst32, src.data(), WIDTH, HEIGHT, info.format,
+                                           tlut.data(), info.tlut_format);
+                  }));
+    }
+    std::printf("\n");
+  }
+  cpu_info = detected_cpu_info;
+
+  // Scaling with the number of decoder threads, with the best implementation.
+  std::printf("\n%-8s", "Format");
+  for (u32 threads : THREAD_COUNTS)
+    std::printf("  %5u threads", threads);
+  std::printf("   (MTexels/s, %dx%d)\n", WIDTH, HEIGHT);
+  for (const FormatInfo& info : FORMATS)
+  {
+    std::printf("%-8s", info.name);
+    for (u32 threads : THREAD_COUNTS)
+    {
+      TexDecoder_SetDecoderThreads(threads);
+      const TexDecoderJob job = {threads == 0 ? reference.data() : dst.data(),
+                                 src.data(),
+                                 WIDTH,
+                                 HEIGHT,
+                                 info.format,
+                                 tlut.data(),
+                                 info.tlut_format};
+      std::printf("  %13.1f", MeasureMTexelsPerSecond([&] { TexDecoder_DecodeBatch(&job, 1); }));
+
+      // Splitting a texture between threads must not change the result.
+      if (threads != 0 && std::memcmp(dst.data(), reference.data(), dst.size()) != 0)
+      {
+        std::printf(" (mismatch)");
+        result = 1;
+      }
+    }
+    std::printf("\n");
+  }
+
+  TexDecoder_SetDecoderThreads(0);
+  return result;
+}